@@ -0,0 +1,98 @@
+#include <tatooine/tensor.h>
+
+#include <vector>
+
+#include "benchmark.h"
+//==============================================================================
+namespace tatooine::benchmark {
+//==============================================================================
+static auto constexpr num_matrices = std::size_t(1 << 14);
+//------------------------------------------------------------------------------
+static auto random_symmetric_matrices() {
+  auto As = std::vector<mat3>(num_matrices);
+  for (auto& A : As) {
+    auto const B = mat3::randu(-1, 1);
+    A            = B + transposed(B);
+  }
+  return As;
+}
+//==============================================================================
+#if TATOOINE_BLAS_AND_LAPACK_AVAILABLE
+TATBENCH(eigenvalues_sym_3x3_lapack) {
+  auto const As = random_symmetric_matrices();
+  auto       W  = vec3{};
+  TATBENCH_MEASURE {
+    for (auto const& A : As) {
+      auto A2 = A;
+      lapack::syev(lapack::job::no_vec, lapack::uplo::upper, A2, W);
+      ::benchmark::DoNotOptimize(W);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_matrices);
+}
+//------------------------------------------------------------------------------
+TATBENCH(eigenvectors_sym_3x3_lapack) {
+  auto const As = random_symmetric_matrices();
+  auto       W  = vec3{};
+  TATBENCH_MEASURE {
+    for (auto const& A : As) {
+      auto A2 = A;
+      lapack::syev(lapack::job::vec, lapack::uplo::upper, A2, W);
+      ::benchmark::DoNotOptimize(A2);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_matrices);
+}
+#endif
+//==============================================================================
+TATBENCH(eigenvalues_sym_3x3_closed_form) {
+  auto const As = random_symmetric_matrices();
+  TATBENCH_MEASURE {
+    for (auto const& A : As) {
+      auto W = eigenvalues_sym(A);
+      ::benchmark::DoNotOptimize(W);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_matrices);
+}
+//------------------------------------------------------------------------------
+TATBENCH(eigenvectors_sym_3x3_jacobi) {
+  auto const As = random_symmetric_matrices();
+  TATBENCH_MEASURE {
+    for (auto const& A : As) {
+      auto eig = eigenvectors_sym(A);
+      ::benchmark::DoNotOptimize(eig);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_matrices);
+}
+//------------------------------------------------------------------------------
+TATBENCH(eigenvalues_sym_3x3_batched) {
+  auto const As     = random_symmetric_matrices();
+  auto       a      = std::array<std::vector<double>, 6>{};
+  auto       lambda = std::array<std::vector<double>, 3>{};
+  for (auto& c : a) {
+    c.resize(num_matrices);
+  }
+  for (auto& l : lambda) {
+    l.resize(num_matrices);
+  }
+  for (std::size_t i = 0; i < num_matrices; ++i) {
+    a[0][i] = As[i](0, 0);
+    a[1][i] = As[i](0, 1);
+    a[2][i] = As[i](0, 2);
+    a[3][i] = As[i](1, 1);
+    a[4][i] = As[i](1, 2);
+    a[5][i] = As[i](2, 2);
+  }
+  TATBENCH_MEASURE {
+    eigenvalues_sym(num_matrices, a[0].data(), a[1].data(), a[2].data(),
+                    a[3].data(), a[4].data(), a[5].data(), lambda[0].data(),
+                    lambda[1].data(), lambda[2].data());
+    ::benchmark::DoNotOptimize(lambda[2].data());
+  }
+  state.SetItemsProcessed(state.iterations() * num_matrices);
+}
+//==============================================================================
+}  // namespace tatooine::benchmark
+//==============================================================================
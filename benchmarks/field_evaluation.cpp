@@ -0,0 +1,52 @@
+#include <tatooine/analytical/numerical/doublegyre.h>
+#include <tatooine/random.h>
+
+#include <vector>
+
+#include "benchmark.h"
+//==============================================================================
+namespace tatooine::benchmark {
+//==============================================================================
+static auto constexpr num_positions = std::size_t(1) << 16;
+//------------------------------------------------------------------------------
+static auto doublegyre_positions() {
+  auto rand_x = random::uniform{0.0, 2.0, std::mt19937_64{1234}};
+  auto rand_y = random::uniform{0.0, 1.0, std::mt19937_64{4321}};
+  auto xs     = std::vector<vec2>(num_positions);
+  for (auto& x : xs) {
+    x = vec2{rand_x(), rand_y()};
+  }
+  return xs;
+}
+//==============================================================================
+/// One virtual call per position.
+TATBENCH(field_evaluation_doublegyre_per_point) {
+  auto const  dg = analytical::numerical::doublegyre{};
+  auto const& v  = static_cast<polymorphic::vectorfield<double, 2> const&>(dg);
+  auto const  xs = doublegyre_positions();
+  auto        vs = std::vector<vec2>(num_positions);
+  TATBENCH_MEASURE {
+    for (std::size_t i = 0; i < num_positions; ++i) {
+      vs[i] = v.evaluate(xs[i], 1.0);
+    }
+    ::benchmark::DoNotOptimize(vs.data());
+  }
+  state.SetItemsProcessed(state.iterations() * num_positions);
+}
+//------------------------------------------------------------------------------
+/// One virtual call for all positions.
+TATBENCH(field_evaluation_doublegyre_batch) {
+  auto const  dg = analytical::numerical::doublegyre{};
+  auto const& v  = static_cast<polymorphic::vectorfield<double, 2> const&>(dg);
+  auto const  xs = doublegyre_positions();
+  auto        vs = std::vector<vec2>(num_positions);
+  auto const  t  = 1.0;
+  TATBENCH_MEASURE {
+    v.evaluate(xs, std::span{&t, 1}, vs);
+    ::benchmark::DoNotOptimize(vs.data());
+  }
+  state.SetItemsProcessed(state.iterations() * num_positions);
+}
+//==============================================================================
+}  // namespace tatooine::benchmark
+//==============================================================================
@@ -0,0 +1,43 @@
+#include <tatooine/analytical/numerical/doublegyre.h>
+#include <tatooine/ftle.h>
+#include <tatooine/numerical_flowmap.h>
+#include <tatooine/rectilinear_grid.h>
+
+#include "benchmark.h"
+//==============================================================================
+namespace tatooine::benchmark {
+//==============================================================================
+static void ftle_doublegyre(::benchmark::State& state) {
+  auto const v   = analytical::numerical::doublegyre{};
+  auto       phi = flowmap(v);
+  phi.use_caching(false);
+  auto const res  = static_cast<std::size_t>(state.range(0));
+  auto       grid = rectilinear_grid{linspace{0.0, 2.0, 2 * res},
+                                     linspace{0.0, 1.0, res}};
+  TATBENCH_MEASURE {
+    auto const& prop = ftle(grid, phi, 0.0, 5.0, execution_policy::parallel);
+    ::benchmark::DoNotOptimize(prop);
+  }
+  state.SetItemsProcessed(state.iterations() * 2 * res * res);
+}
+BENCHMARK(ftle_doublegyre)->Arg(64)->Arg(128);
+//------------------------------------------------------------------------------
+/// Streams the FTLE slice by slice without keeping the whole flow map.
+static void ftle_slices_doublegyre(::benchmark::State& state) {
+  auto const v   = analytical::numerical::doublegyre{};
+  auto       phi = flowmap(v);
+  phi.use_caching(false);
+  auto const res  = static_cast<std::size_t>(state.range(0));
+  auto const grid = rectilinear_grid{linspace{0.0, 2.0, 2 * res},
+                                     linspace{0.0, 1.0, res}};
+  TATBENCH_MEASURE {
+    ftle_slices(grid, phi, 0.0, 5.0, [](std::size_t const, auto const& slice) {
+      ::benchmark::DoNotOptimize(slice);
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * 2 * res * res);
+}
+BENCHMARK(ftle_slices_doublegyre)->Arg(64)->Arg(128);
+//==============================================================================
+}  // namespace tatooine::benchmark
+//==============================================================================
@@ -0,0 +1,47 @@
+#include <tatooine/isosurface.h>
+#include <tatooine/rectilinear_grid.h>
+
+#include "benchmark.h"
+//==============================================================================
+namespace tatooine::benchmark {
+//==============================================================================
+static auto distance_grid(std::size_t const res) {
+  auto g = rectilinear_grid{linspace{-1.0, 1.0, res}, linspace{-1.0, 1.0, res},
+                            linspace{-1.0, 1.0, res}};
+  g.sample_to_vertex_property(
+      [](auto const& x) { return euclidean_length(x); }, "distance");
+  return g;
+}
+//==============================================================================
+static void isosurface_sphere(::benchmark::State& state) {
+  auto const  res = static_cast<std::size_t>(state.range(0));
+  auto const  g   = distance_grid(res);
+  auto const& s   = g.scalar_vertex_property("distance");
+  TATBENCH_MEASURE {
+    auto mesh = isosurface(s, 0.7);
+    ::benchmark::DoNotOptimize(mesh);
+  }
+  state.SetItemsProcessed(state.iterations() * res * res * res);
+}
+BENCHMARK(isosurface_sphere)->Arg(64)->Arg(128);
+//------------------------------------------------------------------------------
+/// Extracts a small surface so that the octree skips most of the cells.
+static void isosurface_sphere_min_max_octree(::benchmark::State& state) {
+  auto const  res  = static_cast<std::size_t>(state.range(0));
+  auto const  g    = distance_grid(res);
+  auto const& s    = g.scalar_vertex_property("distance");
+  auto const  tree = min_max_octree<double>{
+      [&](auto const ix, auto const iy, auto const iz) {
+        return s(ix, iy, iz);
+      },
+      {res, res, res}};
+  TATBENCH_MEASURE {
+    auto mesh = isosurface(s, 0.1, tree);
+    ::benchmark::DoNotOptimize(mesh);
+  }
+  state.SetItemsProcessed(state.iterations() * res * res * res);
+}
+BENCHMARK(isosurface_sphere_min_max_octree)->Arg(64)->Arg(128);
+//==============================================================================
+}  // namespace tatooine::benchmark
+//==============================================================================
@@ -0,0 +1,104 @@
+#include <tatooine/lazy_reader.h>
+#if TATOOINE_HDF5_AVAILABLE
+#include <tatooine/hdf5.h>
+#endif
+#include <tatooine/for_loop.h>
+
+#include <vector>
+
+#include "benchmark.h"
+//==============================================================================
+namespace tatooine::benchmark {
+//==============================================================================
+static auto constexpr resolution = std::size_t(64);
+static auto constexpr chunk_size = std::size_t(16);
+//------------------------------------------------------------------------------
+/// Computes its values when a chunk is read so that only the chunk cache of
+/// lazy_reader is measured.
+struct procedural_dataset {
+  using value_type = float;
+  auto size() const {
+    return std::vector<std::size_t>{resolution, resolution, resolution};
+  }
+  template <typename Chunk>
+  auto read(std::vector<std::size_t> const& offset,
+            std::vector<std::size_t> const& size, Chunk& chunk) const {
+    for (std::size_t iz = 0; iz < size[2]; ++iz) {
+      for (std::size_t iy = 0; iy < size[1]; ++iy) {
+        for (std::size_t ix = 0; ix < size[0]; ++ix) {
+          chunk(ix, iy, iz) = static_cast<value_type>(
+              offset[0] + ix + (offset[1] + iy) * resolution +
+              (offset[2] + iz) * resolution * resolution);
+        }
+      }
+    }
+  }
+};
+//==============================================================================
+/// Walks the whole dataset once while only eight chunks may be loaded.
+TATBENCH(lazy_reader_traverse_bounded) {
+  auto reader = lazy_reader<procedural_dataset>{
+      procedural_dataset{}, {chunk_size, chunk_size, chunk_size}};
+  reader.set_max_num_chunks_loaded(8);
+  TATBENCH_MEASURE {
+    auto sum = 0.0f;
+    for_loop([&](auto const... is) { sum += reader(is...); }, resolution,
+             resolution, resolution);
+    ::benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * resolution * resolution *
+                          resolution);
+}
+//------------------------------------------------------------------------------
+/// All chunks fit into memory so that only cache hits are measured.
+TATBENCH(lazy_reader_traverse_hits) {
+  auto const reader = lazy_reader<procedural_dataset>{
+      procedural_dataset{}, {chunk_size, chunk_size, chunk_size}};
+  for_loop([&](auto const... is) { reader(is...); }, resolution, resolution,
+           resolution);
+  TATBENCH_MEASURE {
+    auto sum = 0.0f;
+    for_loop([&](auto const... is) { sum += reader(is...); }, resolution,
+             resolution, resolution);
+    ::benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * resolution * resolution *
+                          resolution);
+}
+//------------------------------------------------------------------------------
+#if TATOOINE_HDF5_AVAILABLE
+/// Reads a deflate compressed HDF5 dataset through lazy_reader.
+TATBENCH(lazy_reader_hdf5_deflate) {
+  auto const filepath = filesystem::path{"lazy_reader_benchmark.h5"};
+  {
+    auto data = dynamic_multidim_array<float>{resolution, resolution,
+                                              resolution};
+    procedural_dataset{}.read({0, 0, 0}, {resolution, resolution, resolution},
+                              data);
+    auto out      = hdf5::file{filepath};
+    auto creation = hdf5::property_list::dataset_creation();
+    creation.set_chunk(chunk_size, chunk_size, chunk_size);
+    creation.set_deflate();
+    out.create_dataset<float>("data", creation,
+                              hdf5::property_list::dataset_access(),
+                              resolution, resolution, resolution)
+        .write(data);
+  }
+  auto in = hdf5::file{filepath};
+  TATBENCH_MEASURE {
+    auto reader = in.dataset<float>("data").read_lazy(
+        {chunk_size, chunk_size, chunk_size});
+    reader.set_max_num_chunks_loaded(8);
+    auto sum = 0.0f;
+    for_loop([&](auto const... is) { sum += reader(is...); }, resolution,
+             resolution, resolution);
+    ::benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * resolution * resolution *
+                          resolution);
+  filesystem::remove(filepath);
+}
+#endif
+//==============================================================================
+}  // namespace tatooine::benchmark
+//==============================================================================
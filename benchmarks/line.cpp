@@ -4,10 +4,12 @@
 namespace tatooine::benchmark {
 //==============================================================================
 TATBENCH(line_sampling) {
-  parameterized_line<double, 2, interpolation::cubic> l{
-      {vec{0.0, 0.0}, 0.0}, {vec{1.0, 1.0}, 1.0}, {vec{2.0, 0.0}, 2.0}};
-  linspace ts(0.0, 2.0, 100);
-  TATBENCH_MEASURE { l.resample(ts); }
+  auto l = line2{vec2{0.0, 0.0}, vec2{1.0, 1.0}, vec2{2.0, 0.0}};
+  l.compute_uniform_parameterization();
+  auto const ts = linspace{0.0, 2.0, 100};
+  TATBENCH_MEASURE {
+    ::benchmark::DoNotOptimize(l.resample<interpolation::cubic>(ts));
+  }
 }
 //==============================================================================
 }  // namespace tatooine::benchmark
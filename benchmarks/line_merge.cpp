@@ -0,0 +1,44 @@
+#include <tatooine/line.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "benchmark.h"
+//==============================================================================
+namespace tatooine::benchmark {
+//==============================================================================
+static auto constexpr num_segments = std::size_t(1 << 16);
+//------------------------------------------------------------------------------
+/// Cuts a helix into segments, flips every second one and shuffles them like
+/// the unordered output of a cell-wise line extraction.
+static auto helix_segments() {
+  auto const x = [](std::size_t const i) {
+    auto const t = static_cast<double>(i) * 0.01;
+    return vec3{std::cos(t), std::sin(t), t * 0.1};
+  };
+  auto segments = std::vector<line3>{};
+  segments.reserve(num_segments);
+  for (std::size_t i = 0; i < num_segments; ++i) {
+    if (i % 2 == 0) {
+      segments.push_back(line3{x(i), x(i + 1)});
+    } else {
+      segments.push_back(line3{x(i + 1), x(i)});
+    }
+  }
+  std::ranges::shuffle(segments, std::mt19937_64{1234});
+  return segments;
+}
+//==============================================================================
+TATBENCH(line_merge_helix_segments) {
+  auto const segments = helix_segments();
+  TATBENCH_MEASURE {
+    auto merged = merge(segments);
+    ::benchmark::DoNotOptimize(merged);
+  }
+  state.SetItemsProcessed(state.iterations() * num_segments);
+}
+//==============================================================================
+}  // namespace tatooine::benchmark
+//==============================================================================
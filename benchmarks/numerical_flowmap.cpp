@@ -0,0 +1,52 @@
+#include <tatooine/analytical/numerical/doublegyre.h>
+#include <tatooine/numerical_flowmap.h>
+#include <tatooine/random.h>
+
+#include <vector>
+
+#include "benchmark.h"
+//==============================================================================
+namespace tatooine::benchmark {
+//==============================================================================
+static auto constexpr num_seeds = std::size_t(256);
+//------------------------------------------------------------------------------
+static auto doublegyre_seeds() {
+  auto rand_x = random::uniform{0.0, 2.0, std::mt19937_64{1234}};
+  auto rand_y = random::uniform{0.0, 1.0, std::mt19937_64{4321}};
+  auto xs     = std::vector<vec2>(num_seeds);
+  for (auto& x : xs) {
+    x = vec2{rand_x(), rand_y()};
+  }
+  return xs;
+}
+//==============================================================================
+TATBENCH(numerical_flowmap_doublegyre) {
+  auto const v  = analytical::numerical::doublegyre{};
+  auto       fm = flowmap(v);
+  fm.use_caching(false);
+  auto const xs = doublegyre_seeds();
+  TATBENCH_MEASURE {
+    for (auto const& x : xs) {
+      ::benchmark::DoNotOptimize(fm(x, 0.0, 10.0));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_seeds);
+}
+//------------------------------------------------------------------------------
+/// Integrates every seed once and answers all further queries from the
+/// integral curve cache.
+TATBENCH(numerical_flowmap_doublegyre_cached) {
+  auto const v  = analytical::numerical::doublegyre{};
+  auto       fm = flowmap(v);
+  fm.use_caching(true);
+  auto const xs = doublegyre_seeds();
+  TATBENCH_MEASURE {
+    for (auto const& x : xs) {
+      ::benchmark::DoNotOptimize(fm(x, 0.0, 10.0));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_seeds);
+}
+//==============================================================================
+}  // namespace tatooine::benchmark
+//==============================================================================
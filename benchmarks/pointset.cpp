@@ -0,0 +1,98 @@
+#include <tatooine/pointset.h>
+#include <tatooine/random.h>
+
+#include <vector>
+
+#include "benchmark.h"
+//==============================================================================
+namespace tatooine::benchmark {
+//==============================================================================
+#if TATOOINE_FLANN_AVAILABLE
+static auto constexpr num_vertices = std::size_t(100000);
+static auto constexpr num_queries  = std::size_t(1 << 12);
+//------------------------------------------------------------------------------
+static auto random_pointset() {
+  auto  ps   = pointset3{};
+  auto  rand = random::uniform{-1.0, 1.0, std::mt19937_64{1234}};
+  auto& prop = ps.scalar_vertex_property("prop");
+  for (std::size_t i = 0; i < num_vertices; ++i) {
+    auto const v = ps.insert_vertex(rand(), rand(), rand());
+    prop[v]      = std::sin(ps[v].x() * 4) * std::cos(ps[v].y() * 4) *
+              ps[v].z();
+  }
+  return ps;
+}
+//------------------------------------------------------------------------------
+static auto random_queries() {
+  auto rand = random::uniform{-0.9, 0.9, std::mt19937_64{4321}};
+  auto xs   = std::vector<vec3>(num_queries);
+  for (auto& x : xs) {
+    x = vec3{rand(), rand(), rand()};
+  }
+  return xs;
+}
+//==============================================================================
+TATBENCH(pointset_build_kd_tree) {
+  auto const ps = random_pointset();
+  TATBENCH_MEASURE {
+    ps.invalidate_kd_tree();
+    ::benchmark::DoNotOptimize(ps.nearest_neighbor(vec3::zeros()));
+  }
+  state.SetItemsProcessed(state.iterations() * num_vertices);
+}
+//------------------------------------------------------------------------------
+static void pointset_nearest_neighbors(::benchmark::State& state) {
+  auto const ps = random_pointset();
+  auto const xs = random_queries();
+  auto const k  = static_cast<std::size_t>(state.range(0));
+  ps.nearest_neighbor(vec3::zeros());
+  TATBENCH_MEASURE {
+    for (auto const& x : xs) {
+      ::benchmark::DoNotOptimize(ps.nearest_neighbors_raw(x, k));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_queries);
+}
+BENCHMARK(pointset_nearest_neighbors)->Arg(1)->Arg(8)->Arg(32);
+//------------------------------------------------------------------------------
+/// Answers all queries with one call.
+static void pointset_nearest_neighbors_batch(::benchmark::State& state) {
+  auto const ps = random_pointset();
+  auto const xs = random_queries();
+  auto const k  = static_cast<std::size_t>(state.range(0));
+  ps.nearest_neighbor(vec3::zeros());
+  TATBENCH_MEASURE {
+    ::benchmark::DoNotOptimize(ps.nearest_neighbors_raw(xs, k));
+  }
+  state.SetItemsProcessed(state.iterations() * num_queries);
+}
+BENCHMARK(pointset_nearest_neighbors_batch)->Arg(1)->Arg(8)->Arg(32);
+//------------------------------------------------------------------------------
+TATBENCH(pointset_nearest_neighbors_radius) {
+  auto const ps = random_pointset();
+  auto const xs = random_queries();
+  ps.nearest_neighbor(vec3::zeros());
+  TATBENCH_MEASURE {
+    for (auto const& x : xs) {
+      ::benchmark::DoNotOptimize(ps.nearest_neighbors_radius_raw(x, 0.05));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_queries);
+}
+//------------------------------------------------------------------------------
+TATBENCH(pointset_inverse_distance_weighting) {
+  auto const ps      = random_pointset();
+  auto const xs      = random_queries();
+  auto const sampler = ps.inverse_distance_weighting_sampler(
+      ps.scalar_vertex_property("prop"), 0.05);
+  TATBENCH_MEASURE {
+    for (auto const& x : xs) {
+      ::benchmark::DoNotOptimize(sampler(x));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_queries);
+}
+#endif
+//==============================================================================
+}  // namespace tatooine::benchmark
+//==============================================================================
@@ -0,0 +1,87 @@
+#include <tatooine/pointset.h>
+#include <tatooine/random.h>
+
+#include "benchmark.h"
+//==============================================================================
+namespace tatooine::benchmark {
+//==============================================================================
+#if TATOOINE_BLAS_AND_LAPACK_AVAILABLE
+static auto random_pointset(std::size_t const num_vertices) {
+  auto  ps   = pointset2{};
+  auto  rand = random::uniform{-1.0, 1.0, std::mt19937_64{1234}};
+  auto& prop = ps.scalar_vertex_property("prop");
+  for (std::size_t i = 0; i < num_vertices; ++i) {
+    auto const v = ps.insert_vertex(rand(), rand());
+    prop[v]      = std::sin(ps[v].x() * 4) * std::cos(ps[v].y() * 4);
+  }
+  return ps;
+}
+//==============================================================================
+static void radial_basis_functions_setup(::benchmark::State& state) {
+  auto const ps = random_pointset(static_cast<std::size_t>(state.range(0)));
+  TATBENCH_MEASURE {
+    auto sampler = ps.radial_basis_functions_sampler(
+        ps.scalar_vertex_property("prop"));
+    ::benchmark::DoNotOptimize(sampler);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(radial_basis_functions_setup)->Arg(1000)->Arg(2000);
+//------------------------------------------------------------------------------
+static void partition_of_unity_radial_basis_functions_setup(::benchmark::State& state) {
+  auto const ps = random_pointset(static_cast<std::size_t>(state.range(0)));
+  TATBENCH_MEASURE {
+    auto sampler = ps.partition_of_unity_radial_basis_functions_sampler(
+        ps.scalar_vertex_property("prop"));
+    ::benchmark::DoNotOptimize(sampler);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(partition_of_unity_radial_basis_functions_setup)
+    ->Arg(1000)
+    ->Arg(2000)
+    ->Arg(100000);
+//------------------------------------------------------------------------------
+/// Only solves the local systems of a further property.
+static void partition_of_unity_radial_basis_functions_reuse(::benchmark::State& state) {
+  auto const ps = random_pointset(static_cast<std::size_t>(state.range(0)));
+  auto const rbf = ps.partition_of_unity_radial_basis_functions();
+  TATBENCH_MEASURE {
+    auto sampler = rbf.sampler(ps.scalar_vertex_property("prop"));
+    ::benchmark::DoNotOptimize(sampler);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(partition_of_unity_radial_basis_functions_reuse)->Arg(100000);
+//------------------------------------------------------------------------------
+static auto constexpr num_evaluations = std::size_t(1000);
+//------------------------------------------------------------------------------
+TATBENCH(radial_basis_functions_evaluate) {
+  auto const ps      = random_pointset(2000);
+  auto const sampler = ps.radial_basis_functions_sampler(
+      ps.scalar_vertex_property("prop"));
+  auto rand = random::uniform{-1.0, 1.0, std::mt19937_64{4321}};
+  TATBENCH_MEASURE {
+    for (std::size_t i = 0; i < num_evaluations; ++i) {
+      ::benchmark::DoNotOptimize(sampler(vec2{rand(), rand()}));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_evaluations);
+}
+//------------------------------------------------------------------------------
+TATBENCH(partition_of_unity_radial_basis_functions_evaluate) {
+  auto const ps      = random_pointset(2000);
+  auto const sampler = ps.partition_of_unity_radial_basis_functions_sampler(
+      ps.scalar_vertex_property("prop"));
+  auto rand = random::uniform{-1.0, 1.0, std::mt19937_64{4321}};
+  TATBENCH_MEASURE {
+    for (std::size_t i = 0; i < num_evaluations; ++i) {
+      ::benchmark::DoNotOptimize(sampler(vec2{rand(), rand()}));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_evaluations);
+}
+#endif
+//==============================================================================
+}  // namespace tatooine::benchmark
+//==============================================================================
@@ -0,0 +1,47 @@
+#include <tatooine/unstructured_triangular_grid.h>
+
+#include <cmath>
+
+#include "benchmark.h"
+//==============================================================================
+namespace tatooine::benchmark {
+//==============================================================================
+static auto constexpr resolution = std::size_t(256);
+//------------------------------------------------------------------------------
+/// Triangulates a height field as a triangle soup in which every triangle
+/// owns its vertices like the output of a cell-wise surface extraction.
+static auto height_field_soup() {
+  auto       soup = unstructured_triangular_grid3{};
+  auto const x    = [](std::size_t const ix, std::size_t const iy) {
+    auto const u = static_cast<double>(ix) / resolution;
+    auto const v = static_cast<double>(iy) / resolution;
+    return vec3{u, v, std::sin(u * 10) * std::cos(v * 10)};
+  };
+  for (std::size_t iy = 0; iy < resolution; ++iy) {
+    for (std::size_t ix = 0; ix < resolution; ++ix) {
+      soup.insert_simplex(soup.insert_vertex(x(ix, iy)),
+                          soup.insert_vertex(x(ix + 1, iy)),
+                          soup.insert_vertex(x(ix + 1, iy + 1)));
+      soup.insert_simplex(soup.insert_vertex(x(ix, iy)),
+                          soup.insert_vertex(x(ix + 1, iy + 1)),
+                          soup.insert_vertex(x(ix, iy + 1)));
+    }
+  }
+  return soup;
+}
+//==============================================================================
+TATBENCH(remove_duplicate_vertices_triangle_soup) {
+  auto const soup = height_field_soup();
+  TATBENCH_MEASURE {
+    state.PauseTiming();
+    auto mesh = soup;
+    state.ResumeTiming();
+    mesh.remove_duplicate_vertices(1e-12);
+    ::benchmark::DoNotOptimize(mesh);
+  }
+  state.SetItemsProcessed(state.iterations() *
+                          soup.vertex_position_data().size());
+}
+//==============================================================================
+}  // namespace tatooine::benchmark
+//==============================================================================
@@ -0,0 +1,108 @@
+#include <tatooine/unstructured_tetrahedral_grid.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "benchmark.h"
+//==============================================================================
+namespace tatooine::benchmark {
+//==============================================================================
+static auto constexpr resolution           = std::size_t(32);
+static auto constexpr num_sample_positions = std::size_t(1 << 14);
+//------------------------------------------------------------------------------
+/// Splits every cell of a regular grid in [-1,1]^3 into six tetrahedra.
+static auto tetrahedral_grid() {
+  auto       g = unstructured_tetrahedral_grid3{};
+  auto const v = [](std::size_t const ix, std::size_t const iy,
+                    std::size_t const iz) {
+    return unstructured_tetrahedral_grid3::vertex_handle{
+        ix + iy * (resolution + 1) + iz * (resolution + 1) * (resolution + 1)};
+  };
+  auto const h = 2.0 / resolution;
+  for (std::size_t iz = 0; iz <= resolution; ++iz) {
+    for (std::size_t iy = 0; iy <= resolution; ++iy) {
+      for (std::size_t ix = 0; ix <= resolution; ++ix) {
+        g.insert_vertex(-1 + ix * h, -1 + iy * h, -1 + iz * h);
+      }
+    }
+  }
+  for (std::size_t iz = 0; iz < resolution; ++iz) {
+    for (std::size_t iy = 0; iy < resolution; ++iy) {
+      for (std::size_t ix = 0; ix < resolution; ++ix) {
+        auto const c = [&](std::size_t const i) {
+          return v(ix + (i & 1), iy + ((i >> 1) & 1), iz + ((i >> 2) & 1));
+        };
+        // Kuhn triangulation along the diagonal from corner 0 to corner 7
+        for (auto const& [a, b] : std::array{std::array{1, 3}, std::array{1, 5},
+                                             std::array{2, 3}, std::array{2, 6},
+                                             std::array{4, 5}, std::array{4, 6}}) {
+          g.insert_simplex(c(0), c(a), c(a | b), c(7));
+        }
+      }
+    }
+  }
+  g.sample_to_vertex_property(
+      [](auto const& x) {
+        return vec3{-x.y(), x.x(), std::sin(x.x() * x.z())};
+      },
+      "velocity");
+  return g;
+}
+//------------------------------------------------------------------------------
+/// Positions along a helix as queried when integrating a pathline.
+static auto pathline_positions() {
+  auto xs = std::vector<vec3>(num_sample_positions);
+  for (std::size_t i = 0; i < num_sample_positions; ++i) {
+    auto const t = static_cast<double>(i) / num_sample_positions;
+    xs[i] = vec3{0.8 * std::cos(t * 20), 0.8 * std::sin(t * 20), 1.8 * t - 0.9};
+  }
+  return xs;
+}
+//------------------------------------------------------------------------------
+/// All positions lie inside the grid. A sampler that does not find their
+/// simplices would only be measuring how fast it gives up.
+static auto samples_all(auto const& sampler, std::vector<vec3> const& xs) {
+  return std::ranges::none_of(xs, [&](auto const& x) {
+    return std::isnan(sampler(x)(0));
+  });
+}
+//==============================================================================
+TATBENCH(unstructured_simplicial_grid_sampler_hierarchy) {
+  auto const  g       = tetrahedral_grid();
+  auto const  xs      = pathline_positions();
+  auto const  sampler = g.vertex_property_sampler<vec3>("velocity");
+  if (!samples_all(sampler, xs)) {
+    state.SkipWithError("hierarchy did not find all simplices");
+    return;
+  }
+  TATBENCH_MEASURE {
+    for (auto const& x : xs) {
+      auto s = sampler(x);
+      ::benchmark::DoNotOptimize(s);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_sample_positions);
+}
+//------------------------------------------------------------------------------
+TATBENCH(unstructured_simplicial_grid_sampler_point_locator) {
+  auto const g = tetrahedral_grid();
+  g.build_point_locator();
+  auto const xs      = pathline_positions();
+  auto const sampler = g.vertex_property_sampler<vec3>("velocity");
+  if (!samples_all(sampler, xs)) {
+    state.SkipWithError("point locator did not find all simplices");
+    return;
+  }
+  TATBENCH_MEASURE {
+    for (auto const& x : xs) {
+      auto s = sampler(x);
+      ::benchmark::DoNotOptimize(s);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_sample_positions);
+}
+//==============================================================================
+}  // namespace tatooine::benchmark
+//==============================================================================
@@ -0,0 +1,134 @@
+#include <tatooine/random.h>
+#include <tatooine/rectilinear_grid.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "benchmark.h"
+//==============================================================================
+namespace tatooine::benchmark {
+//==============================================================================
+static auto constexpr num_sample_positions = std::size_t(1 << 14);
+//------------------------------------------------------------------------------
+static auto velocity_grid() {
+  auto g = rectilinear_grid{linspace{-1.0, 1.0, 64}, linspace{-1.0, 1.0, 64},
+                            linspace{-1.0, 1.0, 64}};
+  g.sample_to_vertex_property(
+      [](auto const& x) {
+        return vec3{-x.y(), x.x(), std::sin(x.x() * x.z())};
+      },
+      "velocity");
+  return g;
+}
+//------------------------------------------------------------------------------
+static auto random_sample_positions() {
+  auto rand = random::uniform{-0.99, 0.99, std::mt19937_64{1234}};
+  auto xs   = std::vector<vec3>(num_sample_positions);
+  for (auto& x : xs) {
+    x = vec3{rand(), rand(), rand()};
+  }
+  return xs;
+}
+//------------------------------------------------------------------------------
+/// Cubic sampling as the sampler did it before it became allocation-free:
+/// every dimension gathers its samples in a std::vector and each finite
+/// differences lookup goes through the locking grid interface.
+template <std::size_t D>
+static auto legacy_cubic_sample(
+    auto const& g, auto const& prop,
+    std::array<std::pair<std::size_t, double>, 3> const& cells,
+    std::array<std::size_t, 3>& is) -> vec3 {
+  auto const [left, t] = cells[D];
+  auto const  right    = left + 1;
+  auto const& dim      = g.template dimension<D>();
+  auto const  stencil_size      = std::min(dim.size(), std::size_t(5));
+  auto const  half_stencil_size = stencil_size / 2;
+
+  auto left_begin =
+      left < half_stencil_size ? std::size_t(0) : left - half_stencil_size;
+  if (left_begin + stencil_size > dim.size()) {
+    left_begin = dim.size() - stencil_size;
+  }
+  auto right_end = dim.size() - right <= half_stencil_size
+                       ? dim.size()
+                       : right + half_stencil_size + 1;
+  right_end = std::max(right_end, stencil_size);
+  auto const range_begin = std::min(left_begin, right_end - stencil_size);
+  auto const range_end   = std::max(left_begin + stencil_size, right_end);
+
+  auto samples = std::vector<vec3>{};
+  samples.reserve(stencil_size + 1);
+  for (auto i = range_begin; i < range_end; ++i) {
+    is[D] = i;
+    if constexpr (D == 2) {
+      samples.push_back(prop(is[0], is[1], is[2]));
+    } else {
+      samples.push_back(legacy_cubic_sample<D + 1>(g, prop, cells, is));
+    }
+  }
+  auto const differentiate = [&](std::size_t const vertex, auto sample_it) {
+    auto df = vec3::zeros();
+    for (auto const c : g.finite_differences_coefficients(stencil_size, D,
+                                                          vertex)) {
+      if (c != 0) {
+        df += c * *sample_it;
+      }
+      ++sample_it;
+    }
+    return df;
+  };
+  auto const dy = dim[right] - dim[left];
+  return interpolation::cubic<vec3>{
+      samples[left - range_begin], samples[right - range_begin],
+      differentiate(left, begin(samples)) * dy,
+      differentiate(right, end(samples) - stencil_size) * dy}(t);
+}
+//==============================================================================
+TATBENCH(vertex_property_sampler_cubic_3d_legacy) {
+  auto const  g  = velocity_grid();
+  auto const  xs = random_sample_positions();
+  auto const& v  = g.vertex_property<vec3>("velocity");
+  auto        is = std::array<std::size_t, 3>{};
+  TATBENCH_MEASURE {
+    for (auto const& x : xs) {
+      auto const cells = std::array{
+          g.cell_index<0>(x.x()), g.cell_index<1>(x.y()), g.cell_index<2>(x.z())};
+      auto s = legacy_cubic_sample<0>(g, v, cells, is);
+      ::benchmark::DoNotOptimize(s);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_sample_positions);
+}
+//------------------------------------------------------------------------------
+TATBENCH(vertex_property_sampler_cubic_3d) {
+  auto const  g       = velocity_grid();
+  auto const  xs      = random_sample_positions();
+  auto const& v       = g.vertex_property<vec3>("velocity");
+  auto const  sampler = v.cubic_sampler();
+  TATBENCH_MEASURE {
+    for (auto const& x : xs) {
+      auto s = sampler(x);
+      ::benchmark::DoNotOptimize(s);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_sample_positions);
+}
+//------------------------------------------------------------------------------
+/// Creates a new sampler for every position as done by code that samples a
+/// property through a temporary sampler.
+TATBENCH(vertex_property_sampler_cubic_3d_temporary_sampler) {
+  auto const  g  = velocity_grid();
+  auto const  xs = random_sample_positions();
+  auto const& v  = g.vertex_property<vec3>("velocity");
+  TATBENCH_MEASURE {
+    for (auto const& x : xs) {
+      auto s = v.cubic_sampler()(x);
+      ::benchmark::DoNotOptimize(s);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_sample_positions);
+}
+//==============================================================================
+}  // namespace tatooine::benchmark
+//==============================================================================
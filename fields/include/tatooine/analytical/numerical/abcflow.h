@@ -2,6 +2,8 @@
 #define TATOOINE_ANALYTICAL_NUMERICAL_ABCFLOW_H
 //==============================================================================
 #include <cmath>
+#include <numbers>
+#include <span>
 #include <tatooine/field.h>
 //==============================================================================
 namespace tatooine::analytical::numerical {
@@ -38,6 +40,25 @@ struct abcflow : vectorfield<abcflow<real_type>, real_type, 3> {
             m_b * gcem::sin(x(0)) + m_a * gcem::cos(x(2)),
             m_c * gcem::sin(x(1)) + m_b * gcem::cos(x(0))};
   }
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  /// Vectorized batch kernel. The flow is steady so ts is ignored. cos(x) is
+  /// written as sin(x + pi / 2) so that the compiler does not merge sin and
+  /// cos into sincos which has no vector variant.
+  auto evaluate(std::span<pos_type const> xs,
+                std::span<real_type const> /*ts*/,
+                std::span<tensor_type> vs) const -> void override {
+    auto constexpr half_pi = std::numbers::pi_v<real_type> / 2;
+    auto const a = m_a;
+    auto const b = m_b;
+    auto const c = m_c;
+#pragma omp simd
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+      auto const& x = xs[i];
+      vs[i](0) = a * std::sin(x(2)) + c * std::sin(x(1) + half_pi);
+      vs[i](1) = b * std::sin(x(0)) + a * std::sin(x(2) + half_pi);
+      vs[i](2) = c * std::sin(x(1)) + b * std::sin(x(0) + half_pi);
+    }
+  }
   [[nodiscard]] constexpr auto in_domain(pos_type const& /*x*/,
                                          real_type const /*t*/) const -> bool {
     return true;
@@ -2,8 +2,9 @@
 #define TATOOINE_ANALYTICAL_NUMERICAL_DOUBLEGYRE_H
 //==============================================================================
 #include <tatooine/field.h>
-#include <numbers>
 #include <cmath>
+#include <numbers>
+#include <span>
 //==============================================================================
 namespace tatooine::analytical::numerical {
 //==============================================================================
@@ -49,6 +50,47 @@ struct doublegyre : vectorfield<doublegyre<Real>, Real, 2> {
             pi * m_A * gcem::cos(pi * f) * gcem::sin(pi * x(1)) * df};
   }
   //----------------------------------------------------------------------------
+  /// Batch kernel. The time dependent coefficient is computed once if all
+  /// positions share the same time. The loop body is branch free so that it
+  /// can be vectorized.
+  auto evaluate(std::span<pos_type const> xs, std::span<Real const> ts,
+                std::span<tensor_type> vs) const -> void override {
+    auto const epsilon         = m_epsilon;
+    auto const omega           = m_omega;
+    auto const pi_A            = pi * m_A;
+    auto const infinite_domain = m_infinite_domain;
+    // a = epsilon * sin(omega * t). The domain test uses non-short-circuit
+    // operators and cos(z) is written as sin(z + pi / 2) so that the compiler
+    // neither branches nor merges sin and cos into sincos which has no vector
+    // variant.
+    auto const kernel = [=](pos_type const& x, Real const a,
+                            tensor_type& v) {
+      auto const x0     = x(0);
+      auto const x1     = x(1);
+      auto const inside = infinite_domain | ((x0 >= 0) & (x0 <= 2) &
+                                             (x1 >= 0) & (x1 <= 1));
+      auto const b  = 1 - 2 * a;
+      auto const f  = a * x0 * x0 + b * x0;
+      auto const df = 2 * a * x0 + b;
+      auto const vx = -pi_A * std::sin(pi * f) * std::sin(pi * x1 + pi / 2);
+      auto const vy = pi_A * std::sin(pi * f + pi / 2) * std::sin(pi * x1) * df;
+      v(0) = inside ? vx : nan<Real>();
+      v(1) = inside ? vy : nan<Real>();
+    };
+    if (ts.size() == 1) {
+      auto const a = epsilon * std::sin(omega * ts.front());
+#pragma omp simd
+      for (std::size_t i = 0; i < xs.size(); ++i) {
+        kernel(xs[i], a, vs[i]);
+      }
+    } else {
+#pragma omp simd
+      for (std::size_t i = 0; i < xs.size(); ++i) {
+        kernel(xs[i], epsilon * std::sin(omega * ts[i]), vs[i]);
+      }
+    }
+  }
+  //----------------------------------------------------------------------------
   constexpr auto set_infinite_domain(bool const v = true) {
     m_infinite_domain = v;
   }
@@ -3,6 +3,9 @@
 //==============================================================================
 #include <tatooine/field.h>
 #include <tatooine/math.h>
+
+#include <cmath>
+#include <span>
 //==============================================================================
 namespace tatooine::analytical::numerical {
 //==============================================================================
@@ -50,6 +53,43 @@ struct tornado : vectorfield<tornado<Real>, Real, 3> {
                        -(pos.x() - c.x()) + 0.1 * (pos.y() - c.y()), z0} *
            scale;
   }
+  //----------------------------------------------------------------------------
+  /// Batch kernel that works on scalar components so that the loop can be
+  /// vectorized.
+  auto evaluate(std::span<pos_type const> xs, std::span<real_type const> ts,
+                std::span<tensor_type> vs) const -> void override {
+    if (ts.size() == 1) {
+      auto const t = ts.front();
+#pragma omp simd
+      for (std::size_t i = 0; i < xs.size(); ++i) {
+        vs[i] = evaluate_components(xs[i](0), xs[i](1), xs[i](2), t);
+      }
+    } else {
+#pragma omp simd
+      for (std::size_t i = 0; i < xs.size(); ++i) {
+        vs[i] = evaluate_components(xs[i](0), xs[i](1), xs[i](2), ts[i]);
+      }
+    }
+  }
+  //----------------------------------------------------------------------------
+ private:
+  static auto evaluate_components(real_type const x, real_type const y,
+                                  real_type const z, real_type const t)
+      -> tensor_type {
+    auto const cx = 0.5 + 0.1 * std::sin(0.04 * t + 10 * z);
+    auto const cy = 0.5 + 0.1 * std::cos(0.03 * t + 3 * z);
+    auto const r  = 0.1 + 0.4 * z * z + 0.1 * z * std::sin(8 * z);
+    auto const r2 = 0.2 + 0.1 * z;
+    auto temp     = std::sqrt((x - cx) * (x - cx) + (y - cy) * (y - cy));
+    auto scale    = std::abs(r - temp);
+    scale         = scale > r2 ? 0.8 - scale : 1;
+    auto z0       = 0.1 * (0.1 - temp * z);
+    z0            = z0 < 0 ? 0 : z0;
+    temp          = std::sqrt(temp * temp + z0 * z0);
+    scale         = (r + r2 - temp) * scale / (temp + eps) / (1 + z);
+    return tensor_type{((y - cy) + 0.1 * (x - cx)) * scale,
+                       (-(x - cx) + 0.1 * (y - cy)) * scale, z0 * scale};
+  }
 };
 //==============================================================================
 tornado()->tornado<double>;
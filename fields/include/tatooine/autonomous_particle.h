@@ -330,12 +330,10 @@ public:
                             real_type const t_end,
                             std::atomic_uint64_t &uuid_generator) const {
     using namespace detail::autonomous_particle;
-    auto hierarchy_mutex = std::mutex{};
     auto hierarchy_pairs = std::vector{hierarchy_pair{m_id, m_id}};
     auto [advected_particles, advected_simple_particles] =
         advect<SplitBehavior>(std::forward<Flowmap>(phi), stepwidth, t_end,
-                              {*this}, hierarchy_pairs, hierarchy_mutex,
-                              uuid_generator);
+                              {*this}, hierarchy_pairs, uuid_generator);
     auto edges = edgeset<Real, NumDimensions>{};
     // auto map   = std::unordered_map<
     //     std::size_t, typename edgeset<Real, NumDimensions>::vertex_handle>{};
@@ -408,7 +406,6 @@ public:
                                    std::atomic_uint64_t &uuid_generator) {
     using namespace detail::autonomous_particle;
     auto particles = container_type{};
-    auto hierarchy_mutex = std::mutex{};
     auto hierarchy_pairs = std::vector<hierarchy_pair>{};
     // hierarchy_pairs.reserve(particles.size());
     // for (auto const& p : particles) {
@@ -417,7 +414,7 @@ public:
     auto [advected_particles, advected_simple_particles] =
         advect<SplitBehavior>(std::forward<Flowmap>(phi), stepwidth, t_end,
                               initial_particles, hierarchy_pairs,
-                              hierarchy_mutex, uuid_generator);
+                              uuid_generator);
 
     auto edges = edgeset<Real, NumDimensions>{};
     auto map = std::unordered_map<
@@ -652,7 +649,6 @@ public:
     using namespace detail::autonomous_particle;
     auto uuid_generator = std::atomic_uint64_t{};
     auto particles = particles_from_grid(t0, g, uuid_generator);
-    auto hierarchy_mutex = std::mutex{};
     auto hierarchy_pairs = std::vector<hierarchy_pair>{};
     // hierarchy_pairs.reserve(particles.size());
     // for (auto const& p : particles) {
@@ -660,8 +656,7 @@ public:
     //}
     auto [advected_particles, advected_simple_particles] =
         advect<SplitBehavior>(std::forward<Flowmap>(phi), stepwidth, t_end,
-                              particles, hierarchy_pairs, hierarchy_mutex,
-                              uuid_generator);
+                              particles, hierarchy_pairs, uuid_generator);
 
     auto edges = edgeset<Real, NumDimensions>{};
     auto map = std::unordered_map<
@@ -755,96 +750,95 @@ private:
                                    real_type const t_end,
                                    container_type particles,
                                    std::vector<hierarchy_pair> &hierarchy_pairs,
-                                   std::mutex &hierarchy_mutex,
                                    std::atomic_uint64_t &uuid_generator) {
-    auto const num_threads = this_type::num_threads();
-
-    auto finished_particles = container_type{};
-    auto finished_simple_particles = simple_particle_container_type{};
-
-    // {particles_to_be_advected, advected_particles, finished_particles}
-    auto particles_per_thread = std::vector<
-        aligned<std::tuple<container_type, container_type, container_type,
-                           simple_particle_container_type>>>(num_threads);
-    while (particles.size() > 0) {
-      distribute_particles_to_thread_containers(num_threads, particles,
-                                                particles_per_thread);
-      advect_particle_pools<SplitBehavior>(
-          num_threads, std::forward<Flowmap>(phi), stepwidth, t_end,
-          particles_per_thread, hierarchy_pairs, hierarchy_mutex,
-          uuid_generator);
-      gather_particles(particles, finished_particles, finished_simple_particles,
-                       particles_per_thread);
-    }
-    return std::tuple{std::move(finished_particles),
-                      std::move(finished_simple_particles)};
-  }
-  //----------------------------------------------------------------------------
-  static auto num_threads() {
-    auto num_threads = std::size_t{};
+    // {finished_particles, finished_simple_particles, hierarchy_pairs}
+    auto results_per_thread = std::vector<
+        aligned<std::tuple<container_type, simple_particle_container_type,
+                           std::vector<hierarchy_pair>>>>{};
+    auto const *phi_ptr = &phi;
+    auto *results_per_thread_ptr = &results_per_thread;
+    auto *uuid_generator_ptr = &uuid_generator;
 #pragma omp parallel
+#pragma omp single
     {
-      if (omp_get_thread_num() == 0) {
-        num_threads = static_cast<std::size_t>(omp_get_num_threads());
+      results_per_thread.resize(
+          static_cast<std::size_t>(omp_get_num_threads()));
+      for (std::size_t i = 0; i < size(particles); ++i) {
+#pragma omp task firstprivate(i, phi_ptr, results_per_thread_ptr,             \
+                              uuid_generator_ptr) shared(particles)
+        advect_particle_task<SplitBehavior>(*phi_ptr, stepwidth, t_end,
+                                            particles[i],
+                                            *results_per_thread_ptr,
+                                            *uuid_generator_ptr);
       }
     }
-    return num_threads;
-  }
-  //----------------------------------------------------------------------------
-  static auto
-  distribute_particles_to_thread_containers(std::size_t const num_threads,
-                                            container_type &particles,
-                                            auto &particles_per_thread) {
-    using namespace std::ranges;
-#pragma omp parallel
-    {
-      auto const thr_id = omp_get_thread_num();
-      auto const begin = std::size_t(thr_id * size(particles) / num_threads);
-      auto const end =
-          std::size_t((thr_id + 1) * size(particles) / num_threads);
-      auto &cont = std::get<0>(*particles_per_thread[thr_id]);
-      cont.reserve(end - begin);
-      copy(particles.begin() + begin, particles.begin() + end,
-           std::back_inserter(cont));
-    }
-    particles.clear();
+    return gather_results(results_per_thread, hierarchy_pairs);
   }
   //----------------------------------------------------------------------------
+  /// Advects particle until it splits or reaches t_end. Every particle of a
+  /// split is advected by a new task so that idle threads steal work from
+  /// threads whose particles keep on splitting. Results are written to the
+  /// buffers of the executing thread and need no locking.
   template <split_behavior SplitBehavior, typename Flowmap>
-  static auto advect_particle_pools(
-      std::size_t const /*num_threads*/, Flowmap &&phi,
-      real_type const stepwidth, real_type const t_end,
-      auto &particles_per_thread, std::vector<hierarchy_pair> &hierarchy_pairs,
-      std::mutex &hierarchy_mutex, std::atomic_uint64_t &uuid_generator) {
-#pragma omp parallel
+  static auto advect_particle_task(Flowmap const &phi,
+                                   real_type const stepwidth,
+                                   real_type const t_end,
+                                   this_type const &particle,
+                                   auto &results_per_thread,
+                                   std::atomic_uint64_t &uuid_generator)
+      -> void {
+    auto splitted_particles = container_type{};
     {
-      auto const thr_id = omp_get_thread_num();
-      auto &[particles_at_t0, particles_at_t1, finished, simple_particles] =
-          *particles_per_thread[thr_id];
-      for (auto const &particle : particles_at_t0) {
-        particle.template advect_until_split<SplitBehavior>(
-            std::forward<Flowmap>(phi), stepwidth, t_end, particles_at_t1,
-            finished, simple_particles, hierarchy_pairs, hierarchy_mutex,
-            uuid_generator);
+      // tied tasks stay on their thread so the buffers cannot change while
+      // they are used
+      auto &[finished, simple, hierarchy_pairs] =
+          *results_per_thread[static_cast<std::size_t>(omp_get_thread_num())];
+      particle.template advect_until_split<SplitBehavior>(
+          phi, stepwidth, t_end, splitted_particles, finished, simple,
+          hierarchy_pairs, uuid_generator);
+      for (auto const &splitted_particle : splitted_particles) {
+        hierarchy_pairs.push_back(
+            hierarchy_pair{splitted_particle.id(), particle.id()});
       }
     }
+    auto const *phi_ptr = &phi;
+    auto *results_per_thread_ptr = &results_per_thread;
+    auto *uuid_generator_ptr = &uuid_generator;
+    for (auto &splitted_particle : splitted_particles) {
+      auto next = std::move(splitted_particle);
+#pragma omp task firstprivate(next, phi_ptr, results_per_thread_ptr,          \
+                              uuid_generator_ptr, stepwidth, t_end)
+      advect_particle_task<SplitBehavior>(*phi_ptr, stepwidth, t_end, next,
+                                          *results_per_thread_ptr,
+                                          *uuid_generator_ptr);
+    }
   }
   //----------------------------------------------------------------------------
-  static auto gather_particles(container_type &particles,
-                               container_type &finished_particles,
-                               simple_particle_container_type &simple_particles,
-                               auto &particles_per_thread) {
+  static auto gather_results(auto &results_per_thread,
+                             std::vector<hierarchy_pair> &hierarchy_pairs) {
     using namespace std::ranges;
-    for (auto &ps : particles_per_thread) {
-      auto &[base, advected, finished, simple] = *ps;
-      base.clear();
-      copy(advected, std::back_inserter(particles));
-      advected.clear();
-      copy(finished, std::back_inserter(finished_particles));
-      finished.clear();
-      copy(simple, std::back_inserter(simple_particles));
-      simple.clear();
+    auto finished_particles = container_type{};
+    auto finished_simple_particles = simple_particle_container_type{};
+    auto num_finished = std::size_t{};
+    auto num_simple = std::size_t{};
+    auto num_hierarchy_pairs = size(hierarchy_pairs);
+    for (auto const &results : results_per_thread) {
+      auto const &[finished, simple, hps] = *results;
+      num_finished += size(finished);
+      num_simple += size(simple);
+      num_hierarchy_pairs += size(hps);
     }
+    finished_particles.reserve(num_finished);
+    finished_simple_particles.reserve(num_simple);
+    hierarchy_pairs.reserve(num_hierarchy_pairs);
+    for (auto &results : results_per_thread) {
+      auto &[finished, simple, hps] = *results;
+      move(finished, std::back_inserter(finished_particles));
+      move(simple, std::back_inserter(finished_simple_particles));
+      copy(hps, std::back_inserter(hierarchy_pairs));
+    }
+    return std::tuple{std::move(finished_particles),
+                      std::move(finished_simple_particles)};
   }
   //----------------------------------------------------------------------------
 public:
@@ -1034,7 +1028,6 @@ public:
                           container_type &finished_particles,
                           simple_particle_container_type &simple_particles,
                           std::vector<hierarchy_pair> & /*hierarchy_pairs*/,
-                          std::mutex & /*hierarchy_mutex*/,
                           std::atomic_uint64_t &uuid_generator) const {
     if constexpr (is_cacheable<std::decay_t<decltype(phi)>>()) {
       phi.use_caching(false);
@@ -75,15 +75,18 @@ auto sample_to_vector(
     rectilinear_grid<SpatialDimensions...> const&           discretized_domain,
     arithmetic auto const                                   t) {
   using V           = polymorphic::field<VReal, NumDimensions, Tensor>;
+  using pos_type    = typename V::pos_type;
   using tensor_type = typename V::tensor_type;
-  auto const               nan = VReal(0) / VReal(0);
-  std::vector<tensor_type> data;
-  auto                     vs = discretized_domain.vertices();
-  data.reserve(vs.size());
+  auto                  vs = discretized_domain.vertices();
+  std::vector<pos_type> xs;
+  xs.reserve(vs.size());
   for (auto v : vs) {
-    auto const x = vs[v];
-    data.push_back(f(x, t));
+    xs.emplace_back(vs[v]);
   }
+  // one batched call instead of one virtual call per vertex
+  auto       data = std::vector<tensor_type>(xs.size());
+  auto const time = static_cast<VReal>(t);
+  f.evaluate(xs, std::span{&time, 1}, data);
   return data;
 }
 //------------------------------------------------------------------------------
@@ -134,29 +137,39 @@ auto discretize(polymorphic::field<VReal, NumDimensions, Tensor> const& f,
                 rectilinear_grid<SpatialDimensions...>& discretized_domain,
                 std::string const& property_name, arithmetic auto const t,
                 execution_policy_tag auto const pol) -> auto& {
-  auto& discretized_field = [&]() -> decltype(auto) {
-    if constexpr (is_arithmetic<Tensor>) {
-      return discretized_domain.template insert_vertex_property<VReal>(
-          property_name);
-    } else if constexpr (static_vec<Tensor>) {
-      return discretized_domain
-          .template vertex_property<vec<VReal, Tensor::dimension(0)>>(
-              property_name);
-    } else if constexpr (static_mat<Tensor>) {
-      return discretized_domain.template vertex_property<
-          mat<VReal, Tensor::dimension(0), Tensor::dimension(1)>>(
-          property_name);
-    } else {
-      return discretized_domain.template vertex_property<Tensor>(property_name);
-    }
-  }();
-  discretized_domain.vertices().iterate_indices(
-      [&](auto const... is) {
-        auto const x             = discretized_domain.vertex_at(is...);
-        discretized_field(is...) = f(x, t);
-      },
-      pol);
-  return discretized_field;
+  if constexpr (requires {
+                  discretized_domain.sample_to_vertex_property(f, property_name,
+                                                               t, pol);
+                }) {
+    // batched evaluation instead of one virtual call per vertex
+    return discretized_domain.sample_to_vertex_property(f, property_name, t,
+                                                        pol);
+  } else {
+    auto& discretized_field = [&]() -> decltype(auto) {
+      if constexpr (is_arithmetic<Tensor>) {
+        return discretized_domain.template insert_vertex_property<VReal>(
+            property_name);
+      } else if constexpr (static_vec<Tensor>) {
+        return discretized_domain
+            .template vertex_property<vec<VReal, Tensor::dimension(0)>>(
+                property_name);
+      } else if constexpr (static_mat<Tensor>) {
+        return discretized_domain.template vertex_property<
+            mat<VReal, Tensor::dimension(0), Tensor::dimension(1)>>(
+            property_name);
+      } else {
+        return discretized_domain.template vertex_property<Tensor>(
+            property_name);
+      }
+    }();
+    discretized_domain.vertices().iterate_indices(
+        [&](auto const... is) {
+          auto const x             = discretized_domain.vertex_at(is...);
+          discretized_field(is...) = f(x, t);
+        },
+        pol);
+    return discretized_field;
+  }
 }
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template <arithmetic VReal, std::size_t NumDimensions, typename Tensor,
@@ -5,6 +5,8 @@
 #include <tatooine/type_traits.h>
 #include <tatooine/nan.h>
 
+#include <cassert>
+#include <span>
 #include <vector>
 //==============================================================================
 namespace tatooine::polymorphic {
@@ -78,6 +80,20 @@ struct field {
   [[nodiscard]] constexpr virtual auto evaluate(pos_type const&,
                                                 real_type const) const
       -> tensor_type = 0;
+  //----------------------------------------------------------------------------
+  /// Evaluates the field at all positions xs and writes the results to vs. ts
+  /// either holds one time per position or a single time for all positions.
+  /// Fields that can evaluate many positions at once override this so that
+  /// bulk sampling pays one virtual call per batch instead of one per point.
+  virtual auto evaluate(std::span<pos_type const>  xs,
+                        std::span<real_type const> ts,
+                        std::span<tensor_type> vs) const -> void {
+    assert(ts.size() == 1 || ts.size() == xs.size());
+    assert(vs.size() >= xs.size());
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+      vs[i] = evaluate(xs[i], ts.size() == 1 ? ts.front() : ts[i]);
+    }
+  }
   //============================================================================
   // methods
   //============================================================================
@@ -167,6 +183,24 @@ struct field : polymorphic::field<Real, NumDimensions, Tensor> {
       -> tensor_type override {
     return as_derived().evaluate(x, t);
   }
+  //----------------------------------------------------------------------------
+  /// Batch evaluation that calls DerivedField::evaluate without virtual
+  /// dispatch. Derived fields with a dedicated batch kernel override this.
+  auto evaluate(std::span<pos_type const> xs, std::span<real_type const> ts,
+                std::span<tensor_type> vs) const -> void override {
+    assert(ts.size() == 1 || ts.size() == xs.size());
+    assert(vs.size() >= xs.size());
+    if (ts.size() == 1) {
+      auto const t = ts.front();
+      for (std::size_t i = 0; i < xs.size(); ++i) {
+        vs[i] = as_derived().DerivedField::evaluate(xs[i], t);
+      }
+    } else {
+      for (std::size_t i = 0; i < xs.size(); ++i) {
+        vs[i] = as_derived().DerivedField::evaluate(xs[i], ts[i]);
+      }
+    }
+  }
 };
 //==============================================================================
 template <typename V, typename Real, std::size_t NumDimensions,
@@ -7,9 +7,24 @@
 #include <tatooine/numerical_flowmap.h>
 #include <tatooine/rectilinear_grid.h>
 #include <tatooine/tags.h>
+
+#include <utility>
 //==============================================================================
 namespace tatooine {
 //==============================================================================
+namespace detail::ftle {
+//==============================================================================
+/// Computes the finite-time Lyapunov exponent from the gradient of a flowmap
+/// by using the largest eigenvalue of the right Cauchy-Green tensor.
+template <typename Tensor, typename Real, std::size_t N>
+constexpr auto ftle(base_tensor<Tensor, Real, N, N> const& nabla_phi,
+                    arithmetic auto const                tau) {
+  auto const eigvals = eigenvalues_sym(transposed(nabla_phi) * nabla_phi);
+  return gcem::log(gcem::sqrt(eigvals(N - 1))) / std::abs(tau);
+}
+//==============================================================================
+}  // namespace detail::ftle
+//==============================================================================
 template <typename FlowmapGradient>
 struct ftle_field
     : scalarfield<ftle_field<FlowmapGradient>, typename FlowmapGradient::real_type,
@@ -72,10 +87,7 @@ struct ftle_field
   //      m_tau{static_cast<real_type>(tau)} {}
   //============================================================================
   auto evaluate(pos_type const& x, real_type t) const -> tensor_type final {
-    auto const g       = m_flowmap_gradient(x, t, m_tau);
-    auto const eigvals = eigenvalues_sym(transposed(g) * g);
-    return gcem::log(gcem::sqrt(eigvals(num_dimensions() - 1))) /
-           std::abs(m_tau);
+    return detail::ftle::ftle(m_flowmap_gradient(x, t, m_tau), m_tau);
   }
   //----------------------------------------------------------------------------
   auto tau() const { return m_tau; }
@@ -105,27 +117,166 @@ template <typename V, typename Real, size_t N, typename EpsReal>
 ftle_field(vectorfield<V, Real, N> const& v, arithmetic auto,
            vec<EpsReal, N> const&) -> ftle_field<decltype(diff(flowmap(v)))>;
 //==============================================================================
-template <typename... Domains, typename Flowmap>
-auto ftle(rectilinear_grid<Domains...>& grid, Flowmap&& flowmap,
-          arithmetic auto const t0, arithmetic auto const tau,
-          execution_policy_tag auto const exec) -> auto& {
-  auto const fixed_time_phi = [&flowmap, t0, tau](auto const& x) {
-    return flowmap(x, t0, tau);
+/// Computes the FTLE of flowmap on all vertices of grid without storing the
+/// flowmap or its gradient on the whole grid.
+///
+/// The grid is traversed slice by slice along its last dimension. All seeds of
+/// a slice are advected as one batch with the given execution policy and every
+/// trajectory is integrated exactly once. Only stencil_size slices of flowmap
+/// samples are kept in memory and the finite difference stencils of
+/// neighbouring vertices share their trajectories.
+///
+/// For every finished slice k, sink(k, ftle_slice) is called with a
+/// dynamic_multidim_array that holds the FTLE of all vertices whose last index
+/// is k. Slices are passed in increasing order. Vertices whose trajectory
+/// could not be integrated get nan.
+template <typename... Domains, typename Flowmap, typename Sink>
+requires(sizeof...(Domains) > 1)
+auto ftle_slices(rectilinear_grid<Domains...> const& grid, Flowmap&& flowmap,
+                 arithmetic auto const t0, arithmetic auto const tau,
+                 Sink&& sink, execution_policy_tag auto const exec,
+                 std::size_t stencil_size =
+                     detail::rectilinear_grid::default_diff_stencil_size)
+    -> void {
+  using grid_type = rectilinear_grid<Domains...>;
+  using real_type = typename grid_type::real_type;
+  static auto constexpr num_dimensions = grid_type::num_dimensions();
+  static auto constexpr last_dim       = num_dimensions - 1;
+  using pos_type                       = vec<real_type, num_dimensions>;
+  using mat_type = mat<real_type, num_dimensions, num_dimensions>;
+
+  auto sizes = std::array<std::size_t, num_dimensions>{};
+  for (std::size_t i = 0; i < num_dimensions; ++i) {
+    sizes[i]     = grid.size(i);
+    stencil_size = std::min(stencil_size, sizes[i]);
+  }
+  if (stencil_size < 2) {
+    return;
+  }
+  auto const half_stencil_size = stencil_size / 2;
+  // index of the first vertex of the stencil around vertex i of dimension
+  // i_dim. On the borders the stencil is shifted into the grid.
+  auto const first_stencil_index = [&](std::size_t const i,
+                                       std::size_t const i_dim) {
+    return std::min(sizes[i_dim] - stencil_size,
+                    i < half_stencil_size ? 0 : i - half_stencil_size);
   };
+  // copy the coefficients once so that no lock is taken per vertex
+  auto coeffs = std::array<std::vector<real_type>, num_dimensions>{};
+  for (std::size_t i_dim = 0; i_dim < num_dimensions; ++i_dim) {
+    coeffs[i_dim].reserve(sizes[i_dim] * stencil_size);
+    for (std::size_t i = 0; i < sizes[i_dim]; ++i) {
+      for (auto const c :
+           grid.finite_differences_coefficients(stencil_size, i_dim, i)) {
+        coeffs[i_dim].push_back(static_cast<real_type>(c));
+      }
+    }
+  }
 
-  auto const& phi =
-      grid.sample_to_vertex_property(fixed_time_phi, "[ftle]_phi", exec);
-  auto const& nabla_phi =
-      grid.sample_to_vertex_property(diff(phi), "[ftle]_nabla_phi", exec);
+  auto const slice_resolution =
+      std::vector<std::size_t>(begin(sizes), std::prev(end(sizes)));
+  auto strides    = std::array<std::size_t, last_dim>{};
+  auto slice_size = std::size_t(1);
+  for (std::size_t i = 0; i < last_dim; ++i) {
+    strides[i] = slice_size;
+    slice_size *= sizes[i];
+  }
+  auto const slice_indices = [&](std::size_t p) {
+    auto is = std::array<std::size_t, num_dimensions>{};
+    for (std::size_t i = 0; i < last_dim; ++i) {
+      is[i] = p % sizes[i];
+      p /= sizes[i];
+    }
+    return is;
+  };
 
-  auto const ftle_field = [&](integral auto const... is) {
-    auto const& nabla_phi_at_pos = nabla_phi(is...);
-    auto const  eigvals =
-        eigenvalues_sym(transposed(nabla_phi_at_pos) * nabla_phi_at_pos);
-    return gcem::log(gcem::sqrt(eigvals(sizeof...(Domains) - 1))) /
-           std::abs(tau);
+  // ring buffer of advected slices. Slice j lives in window[j % stencil_size].
+  auto window = std::vector<std::vector<pos_type>>(
+      stencil_size, std::vector<pos_type>(slice_size));
+  auto const advect_slice = [&](std::size_t const j) {
+    auto& phi = window[j % stencil_size];
+    for_loop(
+        [&](std::size_t const p) {
+          auto is      = slice_indices(p);
+          is[last_dim] = j;
+          try {
+            phi[p] = pos_type{flowmap(grid.vertex_at(is), t0, tau)};
+          } catch (std::exception&) {
+            phi[p] = pos_type::fill(nan<real_type>());
+          }
+        },
+        exec, slice_size);
   };
-  return grid.sample_to_vertex_property(ftle_field, "ftle", exec);
+
+  auto ftle_slice   = dynamic_multidim_array<real_type>{slice_resolution};
+  auto num_advected = std::size_t{};
+  for (std::size_t k = 0; k < sizes[last_dim]; ++k) {
+    auto const k_first = first_stencil_index(k, last_dim);
+    for (; num_advected < k_first + stencil_size; ++num_advected) {
+      advect_slice(num_advected);
+    }
+    auto const& phi_k = window[k % stencil_size];
+    for_loop(
+        [&](std::size_t const p) {
+          auto const is        = slice_indices(p);
+          auto       nabla_phi = mat_type{};
+          for (std::size_t i_dim = 0; i_dim < last_dim; ++i_dim) {
+            auto const first = first_stencil_index(is[i_dim], i_dim);
+            auto       q     = p - (is[i_dim] - first) * strides[i_dim];
+            auto const c =
+                std::next(begin(coeffs[i_dim]), is[i_dim] * stencil_size);
+            for (std::size_t i = 0; i < stencil_size;
+                 ++i, q += strides[i_dim]) {
+              nabla_phi.col(i_dim) += phi_k[q] * c[i];
+            }
+          }
+          auto const c = std::next(begin(coeffs[last_dim]), k * stencil_size);
+          for (std::size_t i = 0; i < stencil_size; ++i) {
+            nabla_phi.col(last_dim) +=
+                window[(k_first + i) % stencil_size][p] * c[i];
+          }
+          ftle_slice[p] = detail::ftle::ftle(nabla_phi, tau);
+        },
+        exec, slice_size);
+    sink(k, std::as_const(ftle_slice));
+  }
+}
+//------------------------------------------------------------------------------
+template <typename... Domains, typename Flowmap, typename Sink>
+requires(sizeof...(Domains) > 1)
+auto ftle_slices(rectilinear_grid<Domains...> const& grid, Flowmap&& flowmap,
+                 arithmetic auto const t0, arithmetic auto const tau,
+                 Sink&& sink) -> void {
+  ftle_slices(grid, std::forward<Flowmap>(flowmap), t0, tau,
+              std::forward<Sink>(sink), execution_policy::sequential);
+}
+//==============================================================================
+/// Samples the FTLE of flowmap to the vertex property "ftle" of grid.
+/// \see ftle_slices
+template <typename... Domains, typename Flowmap>
+auto ftle(rectilinear_grid<Domains...>& grid, Flowmap&& flowmap,
+          arithmetic auto const t0, arithmetic auto const tau,
+          execution_policy_tag auto const exec) -> auto& {
+  using real_type = typename rectilinear_grid<Domains...>::real_type;
+  auto& ftle_prop = grid.template vertex_property<real_type>("ftle");
+  ftle_slices(
+      grid, std::forward<Flowmap>(flowmap), t0, tau,
+      [&](std::size_t const k, auto const& ftle_slice) {
+        for_loop(
+            [&](std::size_t const p) {
+              auto is    = std::array<std::size_t, sizeof...(Domains)>{};
+              auto rest  = p;
+              for (std::size_t i = 0; i < sizeof...(Domains) - 1; ++i) {
+                is[i] = rest % grid.size(i);
+                rest /= grid.size(i);
+              }
+              is.back()        = k;
+              ftle_prop.at(is) = ftle_slice[p];
+            },
+            exec, ftle_slice.num_components());
+      },
+      exec);
+  return ftle_prop;
 }
 //==============================================================================
 template <typename... Domains, typename Flowmap>
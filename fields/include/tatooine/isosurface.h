@@ -1,16 +1,16 @@
 #ifndef TATOOINE_ISOSURFACE_H
 #define TATOOINE_ISOSURFACE_H
 //==============================================================================
+#include <array>
 #include <cassert>
+#include <cstdint>
 #include <string>
 #include <vector>
-#ifndef NDEBUG
-#include <mutex>
-#endif
 
 #include <tatooine/field.h>
 #include <tatooine/for_loop.h>
 #include <tatooine/marchingcubeslookuptable.h>
+#include <tatooine/min_max_octree.h>
 #include <tatooine/multidim_array.h>
 #include <tatooine/tensor.h>
 #include <tatooine/unstructured_triangular_grid.h>
@@ -18,153 +18,401 @@
 //==============================================================================
 namespace tatooine {
 //==============================================================================
-/// \brief      Indexing and lookup map from
-/// http://paulbourke.net/geometry/polygonise/
-template <
-    typename XDomain, typename YDomain, typename ZDomain, arithmetic Isolevel,
-    invocable<
-        std::size_t, std::size_t, std::size_t,
-        vec<typename rectilinear_grid<XDomain, YDomain, ZDomain>::real_type,
-            3> >
-        GetScalars>
-auto isosurface(GetScalars&&                                       get_scalars,
-                rectilinear_grid<XDomain, YDomain, ZDomain> const& g,
-                Isolevel const                                     isolevel) {
-  using real_type =
-      typename rectilinear_grid<XDomain, YDomain, ZDomain>::real_type;
-  using pos_type = vec<real_type, 3>;
-  unstructured_triangular_grid<real_type, 3> iso_volume;
-
+namespace detail::isosurface {
+//==============================================================================
+/// Calls count(row) for all rows.
+/// \return exclusive prefix sum of the counts with the total sum appended
+template <typename Count>
+auto count_rows(std::size_t const num_rows, Count&& count,
+                execution_policy_tag auto const exec) {
+  auto offsets = std::vector<std::size_t>(num_rows + 1, 0);
+  tatooine::for_loop(
+      [&](std::size_t const row) { offsets[row + 1] = count(row); }, exec,
+      num_rows);
+  for (std::size_t row = 0; row < num_rows; ++row) {
+    offsets[row + 1] += offsets[row];
+  }
+  return offsets;
+}
+//------------------------------------------------------------------------------
+/// Marching cubes that evaluates every vertex once and shares the
+/// intersection vertices of neighbouring cubes.
+///
+/// The grid is processed in layers of cubes along z. Only the samples and the
+/// vertex ids on the edges of the two z-planes bounding the current layer are
+/// kept. Within a layer all rows are processed in parallel in two passes: the
+/// first counts the vertices or triangles of every row, the second writes them
+/// to the offsets given by the prefix sum of the counts. No locks are needed
+/// and the output does not depend on the number of threads.
+///
+/// If tree is not null only cells in leaves that may contain the isosurface
+/// are visited.
+template <typename GetScalars, typename XDomain, typename YDomain,
+          typename ZDomain, typename TreeReal>
+auto marching_cubes(
+    GetScalars&&                                                 get_scalars,
+    tatooine::rectilinear_grid<XDomain, YDomain, ZDomain> const& g,
+    arithmetic auto const isolevel, min_max_octree<TreeReal> const* tree) {
+  using real_type = typename tatooine::rectilinear_grid<XDomain, YDomain,
+                                                        ZDomain>::real_type;
+  using pos_type      = vec<real_type, 3>;
+  using iso_type      = unstructured_triangular_grid<real_type, 3>;
+  using vertex_handle = typename iso_type::vertex_handle;
+  using index_type    = std::array<std::size_t, 3>;
 #if defined(NDEBUG) && defined(TATOOINE_OPENMP_AVAILABLE)
-  std::mutex mutex;
+  auto constexpr exec = execution_policy::parallel;
+#else
+  auto constexpr exec = execution_policy::sequential;
 #endif
-  auto process_cube = [&](auto ix, auto iy, auto iz) {
-    auto vertlist            = make_array<pos_type, 12>();
-    using vertlist_type      = decltype(vertlist);
-    using vertlist_size_type = typename vertlist_type::size_type;
-    std::array p{
-        g.vertex_at(ix, iy, iz + 1),     g.vertex_at(ix + 1, iy, iz + 1),
-        g.vertex_at(ix + 1, iy, iz),     g.vertex_at(ix, iy, iz),
-        g.vertex_at(ix, iy + 1, iz + 1), g.vertex_at(ix + 1, iy + 1, iz + 1),
-        g.vertex_at(ix + 1, iy + 1, iz), g.vertex_at(ix, iy + 1, iz)};
-
-    decltype(auto) s0 = get_scalars(ix, iy, iz + 1, p[0]);
-    decltype(auto) s1 = get_scalars(ix + 1, iy, iz + 1, p[1]);
-    decltype(auto) s2 = get_scalars(ix + 1, iy, iz, p[2]);
-    decltype(auto) s3 = get_scalars(ix, iy, iz, p[3]);
-    decltype(auto) s4 = get_scalars(ix, iy + 1, iz + 1, p[4]);
-    decltype(auto) s5 = get_scalars(ix + 1, iy + 1, iz + 1, p[5]);
-    decltype(auto) s6 = get_scalars(ix + 1, iy + 1, iz, p[6]);
-    decltype(auto) s7 = get_scalars(ix, iy + 1, iz, p[7]);
-
-    unsigned int cube_index = 0;
-    if (s0 < isolevel) {
-      cube_index |= 1;
-    }
-    if (s1 < isolevel) {
-      cube_index |= 2;
-    }
-    if (s2 < isolevel) {
-      cube_index |= 4;
-    }
-    if (s3 < isolevel) {
-      cube_index |= 8;
-    }
-    if (s4 < isolevel) {
-      cube_index |= 16;
-    }
-    if (s5 < isolevel) {
-      cube_index |= 32;
-    }
-    if (s6 < isolevel) {
-      cube_index |= 64;
-    }
-    if (s7 < isolevel) {
-      cube_index |= 128;
+  auto const nx = g.size(0);
+  auto const ny = g.size(1);
+  auto const nz = g.size(2);
+  if (nx < 2 || ny < 2 || nz < 2) {
+    return iso_type{};
+  }
+  auto const iso = static_cast<real_type>(isolevel);
+  auto const to_vector = [](auto const& dim) {
+    auto coords = std::vector<real_type>(dim.size());
+    for (std::size_t i = 0; i < dim.size(); ++i) {
+      coords[i] = static_cast<real_type>(dim[i]);
     }
+    return coords;
+  };
+  auto const xs = to_vector(g.template dimension<0>());
+  auto const ys = to_vector(g.template dimension<1>());
+  auto const zs = to_vector(g.template dimension<2>());
+  auto const vertex_at = [&](index_type const& i) {
+    return pos_type{xs[i[0]], ys[i[1]], zs[i[2]]};
+  };
 
-    // Cube is entirely in/out of the surface
-    if (marchingcubes_lookup::edge_table[cube_index] == 0) {
+  // Cells of leaves that cannot contain the isosurface are skipped. The flags
+  // of the leaves are expanded into one mask per layer of cells that also
+  // flags the rows with at least one active cell. Three layers are kept
+  // because loading a plane needs the layers below and above it.
+  struct layer_mask {
+    std::vector<std::uint8_t> cells;
+    std::vector<std::uint8_t> rows;
+  };
+  auto const active_leaves = tree != nullptr ? tree->active_leaves(isolevel)
+                                             : std::vector<std::uint8_t>{};
+  auto layer_masks = std::array<layer_mask, 3>{};
+  auto const mask_of_layer = [&](std::size_t const cz) -> auto& {
+    return layer_masks[cz % 3];
+  };
+  auto const build_layer_mask = [&](std::size_t const cz) {
+    if (tree == nullptr) {
       return;
     }
-
-    // Find the vertices where the surface intersects the cube
-    if (marchingcubes_lookup::edge_table[cube_index] & 1) {
-      real_type const s = (isolevel - s0) / (s1 - s0);
-      vertlist[0]       = p[0] * (1 - s) + p[1] * s;
-    }
-    if (marchingcubes_lookup::edge_table[cube_index] & 2) {
-      real_type const s = (isolevel - s1) / (s2 - s1);
-      vertlist[1]       = p[1] * (1 - s) + p[2] * s;
-    }
-    if (marchingcubes_lookup::edge_table[cube_index] & 4) {
-      real_type const s = (isolevel - s2) / (s3 - s2);
-      vertlist[2]       = p[2] * (1 - s) + p[3] * s;
-    }
-    if (marchingcubes_lookup::edge_table[cube_index] & 8) {
-      real_type const s = (isolevel - s3) / (s0 - s3);
-      vertlist[3]       = p[3] * (1 - s) + p[0] * s;
-    }
-    if (marchingcubes_lookup::edge_table[cube_index] & 16) {
-      real_type const s = (isolevel - s4) / (s5 - s4);
-      vertlist[4]       = p[4] * (1 - s) + p[5] * s;
-    }
-    if (marchingcubes_lookup::edge_table[cube_index] & 32) {
-      real_type const s = (isolevel - s5) / (s6 - s5);
-      vertlist[5]       = p[5] * (1 - s) + p[6] * s;
-    }
-    if (marchingcubes_lookup::edge_table[cube_index] & 64) {
-      real_type const s = (isolevel - s6) / (s7 - s6);
-      vertlist[6]       = p[6] * (1 - s) + p[7] * s;
-    }
-    if (marchingcubes_lookup::edge_table[cube_index] & 128) {
-      real_type const s = (isolevel - s7) / (s4 - s7);
-      vertlist[7]       = p[7] * (1 - s) + p[4] * s;
-    }
-    if (marchingcubes_lookup::edge_table[cube_index] & 256) {
-      real_type const s = (isolevel - s0) / (s4 - s0);
-      vertlist[8]       = p[0] * (1 - s) + p[4] * s;
-    }
-    if (marchingcubes_lookup::edge_table[cube_index] & 512) {
-      real_type const s = (isolevel - s1) / (s5 - s1);
-      vertlist[9]       = p[1] * (1 - s) + p[5] * s;
+    auto& mask = mask_of_layer(cz);
+    mask.cells.resize((nx - 1) * (ny - 1));
+    mask.rows.assign(ny - 1, 0);
+    auto const B = tree->leaf_size();
+    for (std::size_t cy = 0; cy < ny - 1; ++cy) {
+      auto const* leaf_row =
+          active_leaves.data() +
+          tree->num_leaves(0) * (cy / B + tree->num_leaves(1) * (cz / B));
+      for (std::size_t lx = 0; lx < tree->num_leaves(0); ++lx) {
+        mask.rows[cy] |= leaf_row[lx];
+      }
+      if (mask.rows[cy] != 0) {
+        for (std::size_t cx = 0; cx < nx - 1; ++cx) {
+          mask.cells[cx + cy * (nx - 1)] = leaf_row[cx / B];
+        }
+      }
     }
-    if (marchingcubes_lookup::edge_table[cube_index] & 1024) {
-      real_type const s = (isolevel - s2) / (s6 - s2);
-      vertlist[10]      = p[2] * (1 - s) + p[6] * s;
+  };
+  auto const row_is_active = [&](layer_mask const& mask,
+                                 std::size_t const iy) {
+    return tree == nullptr || mask.rows[iy] != 0;
+  };
+  // only valid if the row of the cell is active
+  auto const cell_is_active = [&](layer_mask const& mask, std::size_t const ix,
+                                  std::size_t const iy) {
+    return tree == nullptr || mask.cells[ix + iy * (nx - 1)] != 0;
+  };
+
+  auto positions = std::vector<pos_type>{};
+  auto triangles = std::vector<vertex_handle>{};
+  // Creates the vertices on all crossed edges of num_rows rows.
+  // for_each_edge(row, f) has to call f(edge, i0, i1, s0, s1) for all edges of
+  // the row with the indices and samples of their end points.
+  auto const create_edge_vertices = [&](std::size_t const         num_rows,
+                                        auto&&                    for_each_edge,
+                                        std::vector<std::size_t>& ids) {
+    auto const offsets = count_rows(
+        num_rows,
+        [&](std::size_t const row) {
+          auto n = std::size_t{};
+          for_each_edge(row, [&](std::size_t, index_type const&,
+                                 index_type const&, real_type const s0,
+                                 real_type const s1) {
+            n += (s0 < iso) != (s1 < iso) ? 1 : 0;
+          });
+          return n;
+        },
+        exec);
+    auto const first_id = positions.size();
+    positions.resize(first_id + offsets.back());
+    tatooine::for_loop(
+        [&](std::size_t const row) {
+          auto id = first_id + offsets[row];
+          for_each_edge(row, [&](std::size_t const edge, index_type const& i0,
+                                 index_type const& i1, real_type const s0,
+                                 real_type const s1) {
+            if ((s0 < iso) != (s1 < iso)) {
+              auto const t  = (iso - s0) / (s1 - s0);
+              positions[id] = vertex_at(i0) * (1 - t) + vertex_at(i1) * t;
+              ids[edge]     = id++;
+            }
+          });
+        },
+        exec, num_rows);
+  };
+
+  // samples and intersection vertex ids on the x- and y-edges of a z-plane
+  struct plane {
+    std::vector<real_type>   scalars;
+    std::vector<std::size_t> x_edges;
+    std::vector<std::size_t> y_edges;
+  };
+  auto planes = std::array<plane, 2>{};
+  for (auto& p : planes) {
+    p.scalars.resize(nx * ny);
+    p.x_edges.resize((nx - 1) * ny);
+    p.y_edges.resize(nx * (ny - 1));
+  }
+  auto z_edges      = std::vector<std::size_t>(nx * ny);
+  auto cube_indices = std::vector<std::uint8_t>((nx - 1) * (ny - 1));
+
+  // A vertex has to be sampled if one of its cells is active.
+  auto const vertex_is_needed = [&](std::size_t const ix, std::size_t const iy,
+                                    std::size_t const iz) {
+    if (tree == nullptr) {
+      return true;
     }
-    if (marchingcubes_lookup::edge_table[cube_index] & 2048) {
-      real_type const s = (isolevel - s3) / (s7 - s3);
-      vertlist[11]      = p[3] * (1 - s) + p[7] * s;
+    auto const x0 = ix > 0 ? ix - 1 : ix, x1 = std::min(ix, nx - 2);
+    auto const y0 = iy > 0 ? iy - 1 : iy, y1 = std::min(iy, ny - 2);
+    auto const z0 = iz > 0 ? iz - 1 : iz, z1 = std::min(iz, nz - 2);
+    for (auto const cz : {z0, z1}) {
+      auto const& mask = mask_of_layer(cz);
+      for (auto const cy : {y0, y1}) {
+        if (row_is_active(mask, cy) && (cell_is_active(mask, x0, cy) ||
+                                        cell_is_active(mask, x1, cy))) {
+          return true;
+        }
+      }
     }
+    return false;
+  };
+  auto const vertex_row_is_needed = [&](std::size_t const iy,
+                                        std::size_t const iz) {
+    auto const y0 = iy > 0 ? iy - 1 : iy, y1 = std::min(iy, ny - 2);
+    auto const z0 = iz > 0 ? iz - 1 : iz, z1 = std::min(iz, nz - 2);
+    return row_is_active(mask_of_layer(z0), y0) ||
+           row_is_active(mask_of_layer(z0), y1) ||
+           row_is_active(mask_of_layer(z1), y0) ||
+           row_is_active(mask_of_layer(z1), y1);
+  };
+  auto const load_plane = [&](plane& p, std::size_t const iz) {
+    tatooine::for_loop(
+        [&](std::size_t const iy) {
+          if (!vertex_row_is_needed(iy, iz)) {
+            return;
+          }
+          for (std::size_t ix = 0; ix < nx; ++ix) {
+            if (vertex_is_needed(ix, iy, iz)) {
+              p.scalars[ix + iy * nx] = static_cast<real_type>(
+                  get_scalars(ix, iy, iz, vertex_at({ix, iy, iz})));
+            }
+          }
+        },
+        exec, ny);
+    // An edge can only be crossed if all of its cells are active so it is
+    // enough to check one of them.
+    auto const& mask = mask_of_layer(std::min(iz, nz - 2));
+    create_edge_vertices(
+        ny,
+        [&](std::size_t const iy, auto&& f) {
+          auto const cy = std::min(iy, ny - 2);
+          if (!row_is_active(mask, cy)) {
+            return;
+          }
+          for (std::size_t ix = 0; ix < nx - 1; ++ix) {
+            if (cell_is_active(mask, ix, cy)) {
+              f(ix + iy * (nx - 1), index_type{ix, iy, iz},
+                index_type{ix + 1, iy, iz}, p.scalars[ix + iy * nx],
+                p.scalars[ix + 1 + iy * nx]);
+            }
+          }
+        },
+        p.x_edges);
+    create_edge_vertices(
+        ny - 1,
+        [&](std::size_t const iy, auto&& f) {
+          if (!row_is_active(mask, iy)) {
+            return;
+          }
+          for (std::size_t ix = 0; ix < nx; ++ix) {
+            if (cell_is_active(mask, std::min(ix, nx - 2), iy)) {
+              f(ix + iy * nx, index_type{ix, iy, iz},
+                index_type{ix, iy + 1, iz}, p.scalars[ix + iy * nx],
+                p.scalars[ix + (iy + 1) * nx]);
+            }
+          }
+        },
+        p.y_edges);
+  };
 
-#if defined(NDEBUG) && defined(TATOOINE_OPENMP_AVAILABLE)
-    {
-      std::lock_guard lock{mutex};
-#endif
-      // create the triangle
-      for (std::size_t i = 0;
-           marchingcubes_lookup::tri_table[cube_index][i] != -1; i += 3) {
-        iso_volume.insert_simplex(
-            iso_volume.insert_vertex(vertlist[static_cast<vertlist_size_type>(
-                marchingcubes_lookup::tri_table[cube_index][i])]),
-            iso_volume.insert_vertex(vertlist[static_cast<vertlist_size_type>(
-                marchingcubes_lookup::tri_table[cube_index][i + 2])]),
-            iso_volume.insert_vertex(vertlist[static_cast<vertlist_size_type>(
-                marchingcubes_lookup::tri_table[cube_index][i + 1])]));
+  build_layer_mask(0);
+  build_layer_mask(std::min<std::size_t>(1, nz - 2));
+  load_plane(planes[0], 0);
+  load_plane(planes[1], 1);
+  for (std::size_t iz = 0; iz < nz - 1; ++iz) {
+    auto const& lower = planes[iz % 2];
+    auto const& upper = planes[(iz + 1) % 2];
+    auto const& mask  = mask_of_layer(iz);
+    create_edge_vertices(
+        ny,
+        [&](std::size_t const iy, auto&& f) {
+          auto const cy = std::min(iy, ny - 2);
+          if (!row_is_active(mask, cy)) {
+            return;
+          }
+          for (std::size_t ix = 0; ix < nx; ++ix) {
+            if (cell_is_active(mask, std::min(ix, nx - 2), cy)) {
+              f(ix + iy * nx, index_type{ix, iy, iz},
+                index_type{ix, iy, iz + 1}, lower.scalars[ix + iy * nx],
+                upper.scalars[ix + iy * nx]);
+            }
+          }
+        },
+        z_edges);
+
+    // Corners and edges are numbered as in the lookup tables. Corner 3 is
+    // (ix, iy, iz), corner 0 is (ix, iy, iz + 1).
+    auto const cube_index = [&](std::size_t const ix, std::size_t const iy) {
+      auto const i0 = ix + iy * nx;
+      auto const i1 = i0 + nx;
+      auto const s  = std::array{upper.scalars[i0],     upper.scalars[i0 + 1],
+                                lower.scalars[i0 + 1], lower.scalars[i0],
+                                upper.scalars[i1],     upper.scalars[i1 + 1],
+                                lower.scalars[i1 + 1], lower.scalars[i1]};
+      auto index = std::uint8_t{};
+      for (std::size_t i = 0; i < 8; ++i) {
+        if (s[i] < iso) {
+          index |= static_cast<std::uint8_t>(1 << i);
+        }
       }
-#if defined(NDEBUG) && defined(TATOOINE_OPENMP_AVAILABLE)
+      return index;
+    };
+    auto const edge_id = [&](int const edge, std::size_t const ix,
+                             std::size_t const iy) {
+      switch (edge) {
+        case 0: return upper.x_edges[ix + iy * (nx - 1)];
+        case 1: return z_edges[ix + 1 + iy * nx];
+        case 2: return lower.x_edges[ix + iy * (nx - 1)];
+        case 3: return z_edges[ix + iy * nx];
+        case 4: return upper.x_edges[ix + (iy + 1) * (nx - 1)];
+        case 5: return z_edges[ix + 1 + (iy + 1) * nx];
+        case 6: return lower.x_edges[ix + (iy + 1) * (nx - 1)];
+        case 7: return z_edges[ix + (iy + 1) * nx];
+        case 8: return upper.y_edges[ix + iy * nx];
+        case 9: return upper.y_edges[ix + 1 + iy * nx];
+        case 10: return lower.y_edges[ix + 1 + iy * nx];
+        default: return lower.y_edges[ix + iy * nx];
+      }
+    };
+    auto const offsets = count_rows(
+        ny - 1,
+        [&](std::size_t const iy) {
+          auto n = std::size_t{};
+          if (!row_is_active(mask, iy)) {
+            return n;
+          }
+          for (std::size_t ix = 0; ix < nx - 1; ++ix) {
+            auto& ci = cube_indices[ix + iy * (nx - 1)];
+            ci       = cell_is_active(mask, ix, iy) ? cube_index(ix, iy) : 0;
+            for (auto const* e = marchingcubes_lookup::tri_table[ci].data();
+                 *e != -1; ++e) {
+              ++n;
+            }
+          }
+          return n;
+        },
+        exec);
+    auto const first_corner = triangles.size();
+    triangles.resize(first_corner + offsets.back());
+    tatooine::for_loop(
+        [&](std::size_t const iy) {
+          if (!row_is_active(mask, iy)) {
+            return;
+          }
+          auto corner = first_corner + offsets[iy];
+          for (std::size_t ix = 0; ix < nx - 1; ++ix) {
+            auto const* tri = marchingcubes_lookup::tri_table
+                                  [cube_indices[ix + iy * (nx - 1)]]
+                                      .data();
+            for (; *tri != -1; tri += 3, corner += 3) {
+              triangles[corner]     = vertex_handle{edge_id(tri[0], ix, iy)};
+              triangles[corner + 1] = vertex_handle{edge_id(tri[2], ix, iy)};
+              triangles[corner + 2] = vertex_handle{edge_id(tri[1], ix, iy)};
+            }
+          }
+        },
+        exec, ny - 1);
+    if (iz + 2 < nz) {
+      if (iz + 2 < nz - 1) {
+        build_layer_mask(iz + 2);
+      }
+      load_plane(planes[iz % 2], iz + 2);
     }
-#endif
-  };
-#if defined(NDEBUG) && defined(TATOOINE_OPENMP_AVAILABLE)
-  for_loop(process_cube, execution_policy::parallel, g.size(0) - 1,
-           g.size(1) - 1, g.size(2) - 1);
-#else
-  for_loop(process_cube, execution_policy::sequential, g.size(0) - 1,
-           g.size(1) - 1, g.size(2) - 1);
-#endif
-  return iso_volume;
+  }
+
+  auto iso_surface                 = iso_type{std::move(positions)};
+  iso_surface.simplex_index_data() = std::move(triangles);
+  return iso_surface;
+}
+//==============================================================================
+}  // namespace detail::isosurface
+//==============================================================================
+/// \brief      Indexing and lookup map from
+/// http://paulbourke.net/geometry/polygonise/
+///
+/// Intersection vertices are shared between neighbouring triangles.
+template <
+    typename XDomain, typename YDomain, typename ZDomain, arithmetic Isolevel,
+    invocable<
+        std::size_t, std::size_t, std::size_t,
+        vec<typename rectilinear_grid<XDomain, YDomain, ZDomain>::real_type,
+            3> >
+        GetScalars>
+auto isosurface(GetScalars&&                                       get_scalars,
+                rectilinear_grid<XDomain, YDomain, ZDomain> const& g,
+                Isolevel const                                     isolevel) {
+  return detail::isosurface::marching_cubes(
+      std::forward<GetScalars>(get_scalars), g, isolevel,
+      static_cast<min_max_octree<
+          typename rectilinear_grid<XDomain, YDomain, ZDomain>::real_type>
+                      const*>(nullptr));
+}
+//------------------------------------------------------------------------------
+/// Same as above but skips all cells in leaves of tree that cannot contain the
+/// isosurface. tree has to be built from the same samples as get_scalars
+/// returns. This makes repeated extractions with different isovalues cheap.
+template <
+    typename XDomain, typename YDomain, typename ZDomain, arithmetic Isolevel,
+    floating_point TreeReal,
+    invocable<
+        std::size_t, std::size_t, std::size_t,
+        vec<typename rectilinear_grid<XDomain, YDomain, ZDomain>::real_type,
+            3> >
+        GetScalars>
+auto isosurface(GetScalars&&                                       get_scalars,
+                rectilinear_grid<XDomain, YDomain, ZDomain> const& g,
+                Isolevel const                                     isolevel,
+                min_max_octree<TreeReal> const&                    tree) {
+  return detail::isosurface::marching_cubes(
+      std::forward<GetScalars>(get_scalars), g, isolevel, &tree);
 }
 //------------------------------------------------------------------------------
 template <arithmetic Real, typename Indexing, arithmetic BBReal,
@@ -220,6 +468,18 @@ auto isosurface(detail::rectilinear_grid::typed_vertex_property_interface<
                         auto const& /*pos*/) { return data(ix, iy, iz); },
                     data.grid(), isolevel);
 }
+//------------------------------------------------------------------------------
+template <typename Grid, arithmetic T, bool HasNonConstReference,
+          floating_point TreeReal>
+auto isosurface(detail::rectilinear_grid::typed_vertex_property_interface<
+                    Grid, T, HasNonConstReference> const& data,
+                arithmetic auto const                     isolevel,
+                min_max_octree<TreeReal> const&           tree) {
+  return isosurface([&](integral auto const ix, integral auto const iy,
+                        integral auto const iz,
+                        auto const& /*pos*/) { return data(ix, iy, iz); },
+                    data.grid(), isolevel, tree);
+}
 //==============================================================================
 }  // namespace tatooine
 //==============================================================================
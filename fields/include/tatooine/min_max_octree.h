@@ -0,0 +1,183 @@
+#ifndef TATOOINE_MIN_MAX_OCTREE_H
+#define TATOOINE_MIN_MAX_OCTREE_H
+//==============================================================================
+#include <tatooine/concepts.h>
+#include <tatooine/for_loop.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+//==============================================================================
+namespace tatooine {
+//==============================================================================
+/// Hierarchy of value ranges of a scalar field sampled on the vertices of a
+/// three-dimensional grid.
+///
+/// Leaves cover blocks of leaf_size^3 cells and every level above merges
+/// 2x2x2 nodes of the level below. It tells which blocks can contain an
+/// isovalue without touching the samples again so that repeated isosurface
+/// extractions only visit the interesting parts of the grid.
+template <floating_point Real>
+struct min_max_octree {
+  using real_type = Real;
+  //============================================================================
+ private:
+  struct level {
+    std::array<std::size_t, 3> size;
+    std::vector<Real>          min;
+    std::vector<Real>          max;
+    auto plain_index(std::size_t const ix, std::size_t const iy,
+                     std::size_t const iz) const {
+      return ix + iy * size[0] + iz * size[0] * size[1];
+    }
+  };
+  std::array<std::size_t, 3> m_num_vertices;
+  std::size_t                m_leaf_size;
+  // m_levels.front() holds the leaves, m_levels.back() the coarsest level
+  std::vector<level> m_levels;
+  //============================================================================
+ public:
+  /// \param get_scalars returns the sample at vertex (ix, iy, iz)
+  /// \param num_vertices number of vertices per dimension
+  template <invocable<std::size_t, std::size_t, std::size_t> GetScalars>
+  min_max_octree(GetScalars&&                      get_scalars,
+                 std::array<std::size_t, 3> const& num_vertices,
+                 std::size_t const                 leaf_size = 8)
+      : m_num_vertices{num_vertices}, m_leaf_size{leaf_size} {
+    build_leaves(get_scalars);
+    while (m_levels.back().size[0] > 1 || m_levels.back().size[1] > 1 ||
+           m_levels.back().size[2] > 1) {
+      build_next_level();
+    }
+  }
+  //----------------------------------------------------------------------------
+  auto leaf_size() const { return m_leaf_size; }
+  auto num_leaves(std::size_t const i) const { return m_levels.front().size[i]; }
+  auto num_levels() const { return m_levels.size(); }
+  auto num_vertices(std::size_t const i) const { return m_num_vertices[i]; }
+  //----------------------------------------------------------------------------
+  /// Plain index of the leaf that contains cell (ix, iy, iz).
+  auto leaf_index(std::size_t const ix, std::size_t const iy,
+                  std::size_t const iz) const {
+    return m_levels.front().plain_index(ix / m_leaf_size, iy / m_leaf_size,
+                                        iz / m_leaf_size);
+  }
+  //----------------------------------------------------------------------------
+  /// Flags all leaves that may contain cells crossed by the isosurface of
+  /// isovalue. As in marching cubes a vertex is inside if its sample is less
+  /// than isovalue so a leaf is active if min < isovalue <= max.
+  /// \return one flag per leaf, indexable with leaf_index
+  auto active_leaves(arithmetic auto const isovalue) const {
+    auto const iso    = static_cast<Real>(isovalue);
+    auto       active = std::vector<std::uint8_t>(
+        m_levels.front().min.size(), std::uint8_t(0));
+    auto const is_active = [iso](level const& l, std::size_t const i) {
+      return l.min[i] < iso && l.max[i] >= iso;
+    };
+    auto stack = std::vector<std::array<std::size_t, 4>>{};
+    auto const& top = m_levels.back();
+    for_loop(
+        [&](std::size_t const ix, std::size_t const iy, std::size_t const iz) {
+          stack.push_back({m_levels.size() - 1, ix, iy, iz});
+        },
+        top.size[0], top.size[1], top.size[2]);
+    while (!stack.empty()) {
+      auto const [il, ix, iy, iz] = stack.back();
+      stack.pop_back();
+      auto const& l = m_levels[il];
+      auto const  i = l.plain_index(ix, iy, iz);
+      if (!is_active(l, i)) {
+        continue;
+      }
+      if (il == 0) {
+        active[i] = 1;
+        continue;
+      }
+      auto const& child = m_levels[il - 1];
+      for (std::size_t cz = 2 * iz; cz < std::min(2 * iz + 2, child.size[2]);
+           ++cz) {
+        for (std::size_t cy = 2 * iy;
+             cy < std::min(2 * iy + 2, child.size[1]); ++cy) {
+          for (std::size_t cx = 2 * ix;
+               cx < std::min(2 * ix + 2, child.size[0]); ++cx) {
+            stack.push_back({il - 1, cx, cy, cz});
+          }
+        }
+      }
+    }
+    return active;
+  }
+  //============================================================================
+ private:
+  template <typename GetScalars>
+  auto build_leaves(GetScalars& get_scalars) -> void {
+    auto& leaves = m_levels.emplace_back();
+    for (std::size_t i = 0; i < 3; ++i) {
+      auto const num_cells = m_num_vertices[i] > 1 ? m_num_vertices[i] - 1 : 1;
+      leaves.size[i]       = (num_cells + m_leaf_size - 1) / m_leaf_size;
+    }
+    auto const num_leaves = leaves.size[0] * leaves.size[1] * leaves.size[2];
+    leaves.min.resize(num_leaves, std::numeric_limits<Real>::max());
+    leaves.max.resize(num_leaves, std::numeric_limits<Real>::lowest());
+    auto const process_leaf = [&](std::size_t const bx, std::size_t const by,
+                                  std::size_t const bz) {
+      auto const i    = leaves.plain_index(bx, by, bz);
+      auto       min  = std::numeric_limits<Real>::max();
+      auto       max  = std::numeric_limits<Real>::lowest();
+      auto const last = [&](std::size_t const b, std::size_t const dim) {
+        return std::min((b + 1) * m_leaf_size, m_num_vertices[dim] - 1);
+      };
+      for (auto iz = bz * m_leaf_size; iz <= last(bz, 2); ++iz) {
+        for (auto iy = by * m_leaf_size; iy <= last(by, 1); ++iy) {
+          for (auto ix = bx * m_leaf_size; ix <= last(bx, 0); ++ix) {
+            // NaN samples fail both comparisons and are ignored
+            auto const s = static_cast<Real>(get_scalars(ix, iy, iz));
+            if (s < min) {
+              min = s;
+            }
+            if (s > max) {
+              max = s;
+            }
+          }
+        }
+      }
+      leaves.min[i] = min;
+      leaves.max[i] = max;
+    };
+#if TATOOINE_PARALLEL_FOR_LOOPS_AVAILABLE
+    for_loop(process_leaf, execution_policy::parallel, leaves.size[0],
+             leaves.size[1], leaves.size[2]);
+#else
+    for_loop(process_leaf, execution_policy::sequential, leaves.size[0],
+             leaves.size[1], leaves.size[2]);
+#endif
+  }
+  //----------------------------------------------------------------------------
+  auto build_next_level() -> void {
+    auto next = level{};
+    {
+      auto const& cur = m_levels.back();
+      for (std::size_t i = 0; i < 3; ++i) {
+        next.size[i] = (cur.size[i] + 1) / 2;
+      }
+      auto const num_nodes = next.size[0] * next.size[1] * next.size[2];
+      next.min.resize(num_nodes, std::numeric_limits<Real>::max());
+      next.max.resize(num_nodes, std::numeric_limits<Real>::lowest());
+      for_loop(
+          [&](std::size_t const ix, std::size_t const iy,
+              std::size_t const iz) {
+            auto const i = next.plain_index(ix / 2, iy / 2, iz / 2);
+            auto const j = cur.plain_index(ix, iy, iz);
+            next.min[i]  = std::min(next.min[i], cur.min[j]);
+            next.max[i]  = std::max(next.max[i], cur.max[j]);
+          },
+          cur.size[0], cur.size[1], cur.size[2]);
+    }
+    m_levels.push_back(std::move(next));
+  }
+};
+//==============================================================================
+}  // namespace tatooine
+//==============================================================================
+#endif
@@ -6,8 +6,13 @@
 #include <tatooine/interpolation.h>
 #include <tatooine/is_cacheable.h>
 #include <tatooine/ode/boost/rungekuttafehlberg78.h>
-#include <tatooine/cache.h>
+#include <tatooine/hash.h>
+#include <tatooine/sharded_cache.h>
 #include <tatooine/tags.h>
+
+#include <atomic>
+#include <mutex>
+#include <optional>
 //==============================================================================
 namespace tatooine {
 //==============================================================================
@@ -24,11 +29,37 @@ struct numerical_flowmap {
   using vec_type            = vec<real_type, num_dimensions()>;
   using pos_type            = vec_type;
   using integral_curve_type = line<real_type, num_dimensions()>;
+  using cache_key_type      = std::pair<real_type, pos_type>;
+  using integral_curve_sampler_type =
+      typename integral_curve_type::template vertex_property_sampler_type<
+          integral_curve_type, InterpolationKernel>;
+  //----------------------------------------------------------------------------
+  /// Integral curve of one seed together with the information if integration
+  /// already hit the domain border. The mutex must be locked while the curve
+  /// is read or extended.
+  struct cached_integral_curve {
+    std::mutex          mutex;
+    integral_curve_type curve;
+    bool                backward_on_border = false;
+    bool                forward_on_border  = false;
+    // built lazily on first evaluation and reset whenever curve changes
+    std::optional<integral_curve_sampler_type> sampler;
+    // updated while mutex is locked but read by the cache without locking
+    std::atomic_uint64_t memory_usage = 0;
+  };
+  //----------------------------------------------------------------------------
+  struct cache_key_hash {
+    auto operator()(cache_key_type const& key) const {
+      auto seed = std::hash<real_type>{}(key.first);
+      for (std::size_t i = 0; i < num_dimensions(); ++i) {
+        hash_combine(seed, key.second(i));
+      }
+      return seed;
+    }
+  };
   using cache_type =
-      tatooine::cache<std::pair<real_type, pos_type>, integral_curve_type>;
+      sharded_cache<cache_key_type, cached_integral_curve, cache_key_hash>;
   using ode_solver_type = ODESolver<real_type, num_dimensions()>;
-  using domain_border_flags_type =
-      std::map<std::pair<pos_type, real_type>, std::pair<bool, bool>>;
   static constexpr auto holds_field_pointer = std::is_pointer_v<V>;
   static constexpr auto default_use_caching = false;
   //============================================================================
@@ -37,8 +68,8 @@ struct numerical_flowmap {
  private:
   V                                m_v;
   ode_solver_type                  m_ode_solver;
-  mutable cache_type               m_cache;
-  mutable domain_border_flags_type m_on_domain_border;
+  cache_type                       m_cache{
+      [](cached_integral_curve const& c) { return c.memory_usage.load(); }};
   bool                             m_use_caching = default_use_caching;
   //============================================================================
   // ctors
@@ -183,7 +214,11 @@ struct numerical_flowmap {
     }
     // use caching
     constexpr real_type security_eps   = 1e-7;
-    auto const&         integral_curve = cached_curve(x0, t0, tau);
+    auto const [entry, lock]           = cached_curve(x0, t0, tau);
+    auto const&         integral_curve = entry->curve;
+    if (!entry->sampler) {
+      entry->sampler.emplace(integral_curve, integral_curve);
+    }
     auto                t              = t0 + tau;
     if (tau < 0 &&
         t < integral_curve
@@ -207,7 +242,7 @@ struct numerical_flowmap {
         throw out_of_domain_error{};
       }
     }
-    return integral_curve.template sampler<InterpolationKernel>()(t);
+    return (*entry->sampler)(t);
   }
   //----------------------------------------------------------------------------
   [[nodiscard]] constexpr auto operator()(
@@ -275,9 +310,11 @@ struct numerical_flowmap {
     }();
     auto callback = [&integral_curve, &parameterization, &tangents, tau](
                         const auto& y, auto const t, const auto& dy) {
+      // skip the start vertex which is already part of the curve
       if (integral_curve.vertices().size() > 0 &&
-          std::abs(parameterization[integral_curve.vertices().back()] - t) <
-              1e-13) {
+          std::abs(parameterization[tau < 0 ? integral_curve.vertices().front()
+                                            : integral_curve.vertices().back()] -
+                   t) < 1e-13) {
         return;
       }
       auto const v = [&] {
@@ -296,35 +333,41 @@ struct numerical_flowmap {
       if ((tau > 0 &&
            parameterization[integral_curve.vertices().back()] < t0 + tau) ||
           (tau < 0 &&
-           parameterization[integral_curve.vertices().front()] < t0 + tau)) {
+           parameterization[integral_curve.vertices().front()] > t0 + tau)) {
         return false;
       }
     }
     return true;
   }
   //----------------------------------------------------------------------------
-  auto cached_curve(pos_type const& y0, real_type const t0) const
-      -> auto const& {
-    return *m_cache.emplace({t0, y0}).first->second;
+  auto cached_curve(pos_type const& y0, real_type const t0) const {
+    return cached_curve(y0, t0, 0, 0);
   }
   //----------------------------------------------------------------------------
   auto cached_curve(pos_type const& y0, real_type const t0,
-                    real_type const tau) const -> auto const& {
+                    real_type const tau) const {
     return cached_curve(y0, t0, tau < 0 ? tau : 0, tau > 0 ? tau : 0);
   }
   //----------------------------------------------------------------------------
+  /// Returns the cached integral curve of y0 starting at t0 after making sure
+  /// it covers [t0 + btau, t0 + ftau] as far as the domain allows. The
+  /// returned lock keeps other threads from extending the curve while it is
+  /// being read. It can safely be called from multiple threads.
   auto cached_curve(pos_type const& y0, real_type const t0, real_type btau,
-                    real_type ftau) const -> auto const& {
-    auto [curve_it, new_integral_curve] = m_cache.emplace({t0, y0});
-    auto& curve                         = curve_it->second;
-
-    auto& [backward_on_border, forward_on_border] =
-        m_on_domain_border[{y0, t0}];
+                    real_type ftau) const
+      -> std::pair<std::shared_ptr<cached_integral_curve>,
+                   std::unique_lock<std::mutex>> {
+    auto [entry, new_integral_curve] = m_cache.get_or_create({t0, y0});
+    auto  lock                       = std::unique_lock{entry->mutex};
+    auto& curve                      = entry->curve;
+    auto& backward_on_border         = entry->backward_on_border;
+    auto& forward_on_border          = entry->forward_on_border;
 
     if (new_integral_curve || curve.empty()) {
       // integral_curve not yet integrated
       auto [fresh_curve, fullback, fullforw] =
           integral_curve(y0, t0, btau, ftau);
+      entry->sampler.reset();
       curve              = std::move(fresh_curve);
       backward_on_border = !fullback;
       forward_on_border  = !fullforw;
@@ -335,17 +378,26 @@ struct numerical_flowmap {
       if (auto const tf = curve.parameterization()[curve.vertices().front()];
           btau < 0 && tf > t0 + btau && !backward_on_border) {
         // continue integration in backward time
+        entry->sampler.reset();
         bool const full    = continue_integration(curve, t0 + btau - tf);
         backward_on_border = !full;
       }
       if (auto const tb = curve.parameterization()[curve.vertices().back()];
           ftau > 0 && tb < t0 + ftau && !forward_on_border) {
         // continue integration in forward time
+        entry->sampler.reset();
         bool const full   = continue_integration(curve, t0 + ftau - tb);
         forward_on_border = !full;
       }
     }
-    return curve;
+    auto const memory_usage =
+        static_cast<std::uint64_t>(curve.vertices().size()) *
+        (sizeof(pos_type) + sizeof(vec_type) + sizeof(real_type) +
+         sizeof(InterpolationKernel<pos_type>));
+    if (entry->memory_usage.exchange(memory_usage) != memory_usage) {
+      m_cache.refresh_memory_usage({t0, y0});
+    }
+    return {std::move(entry), std::move(lock)};
   }
   //============================================================================
   auto vectorfield() const -> auto const& {
@@ -377,10 +429,20 @@ struct numerical_flowmap {
   auto is_using_caching() const { return m_use_caching; }
   auto is_using_caching() -> auto& { return m_use_caching; }
   //----------------------------------------------------------------------------
-  auto invalidate_cache() const {
-    m_cache.clear();
-    m_on_domain_border.clear();
+  auto invalidate_cache() const { m_cache.clear(); }
+  //----------------------------------------------------------------------------
+  /// Limits the memory used by cached integral curves in bytes. Least recently
+  /// used curves are evicted first.
+  auto set_max_cache_memory_usage(std::uint64_t const max_memory_usage) {
+    m_cache.set_max_memory_usage(max_memory_usage);
+  }
+  auto cache_memory_usage() const { return m_cache.memory_usage(); }
+  //----------------------------------------------------------------------------
+  /// Limits the number of cached integral curves.
+  auto set_max_num_cached_curves(std::uint64_t const max_num_curves) {
+    m_cache.set_max_elements(max_num_curves);
   }
+  auto num_cached_curves() const { return m_cache.size(); }
 };
 //==============================================================================
 template <typename V, typename Real, std::size_t NumDimensions>
@@ -6,6 +6,9 @@
 #include <tatooine/particle.h>
 #include <tatooine/rectilinear_grid.h>
 #include <tatooine/unstructured_triangular_grid.h>
+
+#include <cstdint>
+#include <fstream>
 //==============================================================================
 namespace tatooine {
 //==============================================================================
@@ -100,7 +103,7 @@ struct regular_flowmap_discretization {
                                  Flowmap&& flowmap, arithmetic auto const t0,
                                  arithmetic auto const tau, pos_type const& min,
                                  pos_type const& max,
-                                 ExecutionPolicy /*execution_policy*/,
+                                 ExecutionPolicy execution_policy,
                                  integral auto const... resolution)
       : m_t0{real_type(t0)},
         m_t1{real_type(t0 + tau)},
@@ -124,28 +127,34 @@ struct regular_flowmap_discretization {
     grid.vertices().iterate_positions(
         [this](auto const& p) { m_forward_grid.insert_vertex(p); });
 
-    // equip positions with flow maps
+    // equip positions with flow maps. Every vertex starts its own integral
+    // curve exactly once so caching curves would only cost memory.
+    if constexpr (requires { flowmap.use_caching(false); }) {
+      flowmap.use_caching(false);
+    }
     m_forward_grid.sample_to_vertex_property(
-        [&](auto const& x) mutable {
-          if constexpr (requires { flowmap.use_caching(false); }) {
-            flowmap.use_caching(false);
-          }
-          return flowmap(x, m_t0, m_tau);
-        },
-        "flowmap_discretization" /*, execution_policy*/);
-
-    // create forward sampler
-    m_forward_sampler =
-        std::make_unique<forward_grid_vertex_property_sampler_type>(
-            m_forward_grid.natural_neighbor_coordinates_sampler(
-                *m_forward_flowmap_discretization));
-
+        [&](auto const& x) { return flowmap(x, m_t0, m_tau); },
+        "flowmap_discretization", execution_policy);
+    create_backward_grid();
+    create_samplers();
+  }
+  //----------------------------------------------------------------------------
+  /// The backward grid consists of the advected forward positions that map
+  /// back to the forward grid.
+  auto create_backward_grid() -> void {
     m_backward_grid.vertices().resize(m_forward_grid.vertices().size());
     for (auto const v : m_forward_grid.vertices()) {
       m_backward_grid.vertex_at(v) = m_forward_flowmap_discretization->at(v);
       m_backward_flowmap_discretization->at(v.index()) =
           m_forward_grid.vertex_at(v);
     }
+  }
+  //----------------------------------------------------------------------------
+  auto create_samplers() -> void {
+    m_forward_sampler =
+        std::make_unique<forward_grid_vertex_property_sampler_type>(
+            m_forward_grid.natural_neighbor_coordinates_sampler(
+                *m_forward_flowmap_discretization));
     m_backward_sampler =
         std::make_unique<backward_grid_vertex_property_sampler_type>(
             m_backward_grid.natural_neighbor_coordinates_sampler(
@@ -256,8 +265,8 @@ struct regular_flowmap_discretization {
   regular_flowmap_discretization(
       regular_flowmap_discretization&& other) noexcept
       : m_t0{other.m_t0},
-        m_t1{other.m_t0},
-        m_tau{other.m_t0},
+        m_t1{other.m_t1},
+        m_tau{other.m_tau},
 
         m_forward_grid{std::move(other.m_forward_grid)},
         m_forward_flowmap_discretization{
@@ -271,8 +280,99 @@ struct regular_flowmap_discretization {
                 "flowmap_discretization")},
         m_backward_sampler{std::move(other.m_backward_sampler)} {}
   //----------------------------------------------------------------------------
-  auto read(filesystem::path const&) {}
-  auto write(filesystem::path const&) {}
+  /// Magic number at the beginning of files written by write().
+  static auto constexpr file_magic_number = std::uint64_t{0x70616d776f6c6674};
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  /// Reads a discretization written by write() and rebuilds the backward grid
+  /// and the samplers.
+  auto read(filesystem::path const& path) -> void {
+    auto file = std::ifstream{path, std::ios::binary};
+    if (!file.is_open()) {
+      throw std::runtime_error{"Could not open " + path.string()};
+    }
+    auto read_value = [&]<typename T>(T& val) {
+      file.read(reinterpret_cast<char*>(&val), sizeof(T));
+    };
+    auto magic_number = std::uint64_t{};
+    auto num_dims     = std::uint64_t{};
+    auto real_size    = std::uint64_t{};
+    auto num_vertices = std::uint64_t{};
+    read_value(magic_number);
+    read_value(num_dims);
+    read_value(real_size);
+    if (!file || magic_number != file_magic_number ||
+        num_dims != NumDimensions || real_size != sizeof(Real)) {
+      throw std::runtime_error{
+          path.string() + " is no regular_flowmap_discretization with " +
+          std::to_string(NumDimensions) + " dimensions and " +
+          std::to_string(sizeof(Real) * 8) + " bit floating point numbers."};
+    }
+    read_value(m_t0);
+    read_value(m_t1);
+    read_value(m_tau);
+    read_value(num_vertices);
+
+    // positions and flow map follow the header; reject sizes the file cannot
+    // hold before allocating anything
+    auto const data_begin = file.tellg();
+    file.seekg(0, std::ios::end);
+    auto const remaining_bytes = static_cast<std::uint64_t>(
+        file.tellg() - data_begin);
+    file.seekg(data_begin);
+    if (!file ||
+        num_vertices > remaining_bytes / (2 * sizeof(pos_type))) {
+      throw std::runtime_error{path.string() +
+                               " is truncated or has a corrupt header."};
+    }
+
+    m_forward_grid.clear_vertices();
+    m_backward_grid.clear_vertices();
+    m_forward_grid.vertices().resize(num_vertices);
+    auto positions = std::vector<pos_type>(num_vertices);
+    auto const num_bytes =
+        static_cast<std::streamsize>(num_vertices * sizeof(pos_type));
+    file.read(reinterpret_cast<char*>(positions.data()), num_bytes);
+    for (auto const v : m_forward_grid.vertices()) {
+      m_forward_grid.vertex_at(v) = positions[v.index()];
+    }
+    file.read(reinterpret_cast<char*>(positions.data()), num_bytes);
+    for (auto const v : m_forward_grid.vertices()) {
+      m_forward_flowmap_discretization->at(v) = positions[v.index()];
+    }
+    if (!file) {
+      throw std::runtime_error{"Could not read " + path.string()};
+    }
+    create_backward_grid();
+    create_samplers();
+  }
+  //----------------------------------------------------------------------------
+  /// Writes the time domain, the forward positions and their flow map into a
+  /// raw binary file. The backward grid is derived from these when reading.
+  auto write(filesystem::path const& path) const -> void {
+    auto file = std::ofstream{path, std::ios::binary};
+    if (!file.is_open()) {
+      throw std::runtime_error{"Could not write " + path.string()};
+    }
+    auto write_value = [&]<typename T>(T const& val) {
+      file.write(reinterpret_cast<char const*>(&val), sizeof(T));
+    };
+    write_value(file_magic_number);
+    write_value(std::uint64_t{NumDimensions});
+    write_value(std::uint64_t{sizeof(Real)});
+    write_value(m_t0);
+    write_value(m_t1);
+    write_value(m_tau);
+    auto const num_vertices = m_forward_grid.vertices().size();
+    write_value(static_cast<std::uint64_t>(num_vertices));
+    auto const num_bytes =
+        static_cast<std::streamsize>(num_vertices * sizeof(pos_type));
+    file.write(reinterpret_cast<char const*>(
+                   m_forward_grid.vertex_position_data().data()),
+               num_bytes);
+    file.write(reinterpret_cast<char const*>(
+                   m_forward_flowmap_discretization->data()),
+               num_bytes);
+  }
   //----------------------------------------------------------------------------
   /// \{
   auto grid(forward_tag const /*direction*/) const -> auto const& {
@@ -2,6 +2,13 @@
 #define TATOOINE_STAGGERED_FLOWMAP_DISCRETIZATION_H
 //==============================================================================
 #include <tatooine/field.h>
+#include <tatooine/filesystem.h>
+#include <tatooine/random.h>
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
 //==============================================================================
 namespace tatooine {
 //==============================================================================
@@ -92,39 +99,113 @@ struct staggered_flowmap_discretization {
     }
   }
   //============================================================================
-  auto write_to_disk(bool const w = true) { m_write_to_disk = w; }
+  /// If enabled only the steps that are needed are kept in memory. Steps
+  /// that are in memory are written to disk and freed. Disabling it reads all
+  /// steps back into memory.
+  auto write_to_disk(bool const w = true) {
+    auto lock = std::lock_guard{m_deletion_mutex};
+    for (std::size_t i = 0; i < num_steps(); ++i) {
+      if (w && !m_write_to_disk && m_steps[i] != nullptr) {
+        m_steps[i]->write(m_filepaths_to_steps[i]);
+        m_steps[i].reset();
+      } else if (!w && m_write_to_disk && m_steps[i] == nullptr) {
+        m_steps[i] = read_step(i);
+      }
+    }
+    m_write_to_disk = w;
+  }
+  //----------------------------------------------------------------------------
+  auto writes_to_disk() const { return m_write_to_disk; }
+  //----------------------------------------------------------------------------
+  /// Files the steps are written to if write_to_disk() is enabled.
+  auto filepaths_to_steps() const -> auto const & {
+    return m_filepaths_to_steps;
+  }
   //----------------------------------------------------------------------------
   auto num_steps() const { return m_steps.size(); }
   //============================================================================
   auto step(std::size_t const i) const -> auto const & {
-    if (m_write_to_disk && m_steps[i] == nullptr) {
-      auto lock = std::lock_guard{m_deletion_mutex};
-      if (m_steps[i] == nullptr) {
-        for (auto &step : m_steps) {
-          step.reset();
-        }
-      }
-      m_steps[i]->read(m_filepaths_to_steps[i]);
-    }
+    load_step(i);
     return *m_steps[i];
   }
   //----------------------------------------------------------------------------
   auto step(std::size_t const i) -> auto & {
-    if (m_write_to_disk && m_steps[i] == nullptr) {
-      auto lock = std::lock_guard{m_deletion_mutex};
-      if (m_steps[i] == nullptr) {
-        for (auto &step : m_steps) {
-          if (step != nullptr) {
-            step.reset();
-          }
+    load_step(i);
+    return *m_steps[i];
+  }
+  //============================================================================
+ private:
+  auto read_step(std::size_t const i) const {
+    return std::make_unique<internal_flowmap_discretization_type>(
+        m_filepaths_to_steps[i]);
+  }
+  //----------------------------------------------------------------------------
+  /// If the steps are written to disk and step i is not loaded all other
+  /// steps are freed and step i is read.
+  auto load_step(std::size_t const i) const -> void {
+    if (!m_write_to_disk || m_steps[i] != nullptr) {
+      return;
+    }
+    auto lock = std::lock_guard{m_deletion_mutex};
+    if (m_steps[i] != nullptr) {
+      return;
+    }
+    for (auto &step : m_steps) {
+      step.reset();
+    }
+    m_steps[i] = read_step(i);
+  }
+  //----------------------------------------------------------------------------
+  /// Pushes all positions through step step_index(0), then through
+  /// step_index(1) and so on. If the steps are written to disk every step is
+  /// read exactly once and the next step is read in the background while the
+  /// current one is applied.
+  template <typename StepIndex>
+  auto sample_step_major(std::span<pos_type>                xs,
+                         forward_or_backward_tag auto const direction,
+                         StepIndex &&step_index) const -> void {
+    if (num_steps() == 0) {
+      return;
+    }
+    if (!m_write_to_disk) {
+      for (std::size_t k = 0; k < num_steps(); ++k) {
+        auto const &s = *m_steps[step_index(k)];
+        for (auto &x : xs) {
+          x = s.sample(x, direction);
         }
       }
-      m_steps[i] = std::make_unique<internal_flowmap_discretization_type>(
-          m_filepaths_to_steps[i]);
+      return;
+    }
+    auto lock = std::lock_guard{m_deletion_mutex};
+    for (std::size_t i = 0; i < num_steps(); ++i) {
+      if (i != step_index(0)) {
+        m_steps[i].reset();
+      }
+    }
+    if (m_steps[step_index(0)] == nullptr) {
+      m_steps[step_index(0)] = read_step(step_index(0));
+    }
+    auto next = std::future<
+        std::unique_ptr<internal_flowmap_discretization_type>>{};
+    for (std::size_t k = 0; k < num_steps(); ++k) {
+      auto const i = step_index(k);
+      if (k + 1 < num_steps()) {
+        next = std::async(std::launch::async,
+                          [this, j = step_index(k + 1)] { return read_step(j); });
+      }
+      auto const &s = *m_steps[i];
+      for (auto &x : xs) {
+        x = s.sample(x, direction);
+      }
+      m_steps[i].reset();
+      if (next.valid()) {
+        m_steps[step_index(k + 1)] = next.get();
+      }
     }
-    return *m_steps[i];
   }
   //============================================================================
+ public:
+  //============================================================================
   /// Evaluates flow map in forward direction at time t0 with maximal available
   /// advection time.
   /// \param x position
@@ -147,6 +228,24 @@ struct staggered_flowmap_discretization {
     }
     return x;
   }
+  //----------------------------------------------------------------------------
+  /// Evaluates flow map in forward direction at time t0 with maximal available
+  /// advection time for all positions in xs. All positions are pushed through
+  /// one step before the next step is used so every step is loaded only once.
+  /// \param xs positions that get replaced by phi(x, t0, t_end - t0)
+  auto sample(std::span<pos_type> xs, forward_tag const tag) const -> void {
+    sample_step_major(xs, tag, [](std::size_t const k) { return k; });
+  }
+  //----------------------------------------------------------------------------
+  /// Evaluates flow map in backward direction at time t0 with maximal available
+  /// advection time for all positions in xs. All positions are pushed through
+  /// one step before the next step is used so every step is loaded only once.
+  /// \param xs positions that get replaced by phi(x, t_end, t0 - t_end)
+  auto sample(std::span<pos_type> xs, backward_tag const tag) const -> void {
+    sample_step_major(xs, tag, [n = num_steps()](std::size_t const k) {
+      return n - 1 - k;
+    });
+  }
 };
 //==============================================================================
 } // namespace tatooine
@@ -16,10 +16,12 @@
 #include <boost/functional.hpp>
 #include <boost/range/algorithm.hpp>
 #include <boost/range/numeric.hpp>
+#include <cmath>
 #include <limits>
 #include <list>
 #include <map>
 #include <memory>
+#include <vector>
 //==============================================================================
 namespace tatooine {
 //==============================================================================
@@ -822,6 +824,7 @@ struct hultquist_discretization
   using parent_type::uv;
   using parent_type::streamsurface;
   using typename parent_type::front_type;
+  using typename parent_type::pos_type;
   using typename parent_type::streamsurface_type;
   using typename parent_type::triangle_handle;
   using typename parent_type::uv_type;
@@ -854,6 +857,9 @@ struct hultquist_discretization
         }
         cur_front = evolve(cur_front, -cur_stepsize, desired_spatial_dist);
         advected_time -= cur_stepsize;
+        if (size(cur_front) < 2) {
+          break;
+        }
       }
     }
 
@@ -867,6 +873,9 @@ struct hultquist_discretization
         }
         cur_front = evolve(cur_front, cur_stepsize, desired_spatial_dist);
         advected_time += cur_stepsize;
+        if (size(cur_front) < 2) {
+          break;
+        }
       }
     }
   }
@@ -878,24 +887,146 @@ struct hultquist_discretization
       -> hultquist_discretization&                                = default;
   ~hultquist_discretization()                                     = default;
   //============================================================================
-  auto advect(front_type front, real_type step) {
-    assert(step != 0);
-    for (auto& v :front) {
-      auto const& uv     = parent_type::uv(v);
-      auto const  new_uv = vec{uv(0), uv(1) + step};
-      auto new_pos = streamsurface()(new_uv);
-      v = insert_vertex(new_pos, uv_type{new_uv(0), new_uv(1)});
+ private:
+  /// Particle of a front that is being advected. It keeps the position and
+  /// parameterization it had on the previous front so that it only has to be
+  /// integrated over one step.
+  struct particle {
+    pos_type x0;
+    uv_type  uv0;
+    pos_type x1;
+  };
+  //----------------------------------------------------------------------------
+  /// Integrates all particles over step in parallel. Particles that leave the
+  /// domain get a NaN position.
+  auto advect(std::vector<particle>& particles, real_type const step) const
+      -> void {
+    auto const& flowmap         = streamsurface().flowmap();
+    auto const  advect_particle = [&](std::size_t const i) {
+      auto& p = particles[i];
+      try {
+        p.x1 = flowmap(p.x0, p.uv0(1), step);
+      } catch (std::exception&) {
+        p.x1 = pos_type::fill(nan<real_type>());
+      }
+    };
+#if TATOOINE_PARALLEL_FOR_LOOPS_AVAILABLE
+    for_loop(advect_particle, execution_policy::parallel, particles.size());
+#else
+    for_loop(advect_particle, execution_policy::sequential, particles.size());
+#endif
+  }
+  //----------------------------------------------------------------------------
+  static auto remove_lost_particles(std::vector<particle>& particles) {
+    std::erase_if(particles,
+                  [](auto const& p) { return std::isnan(p.x1(0)); });
+  }
+  //----------------------------------------------------------------------------
+  /// Splits ribbons that got wider than 1.5 * desired_spatial_dist. As in
+  /// Hultquist's original method the new particle is seeded halfway between
+  /// its neighbours on the previous front and advected over a single step.
+  auto subdivide(std::vector<particle>& particles, real_type const step,
+                 real_type const desired_spatial_dist) const -> void {
+    static auto constexpr max_num_subdivisions = std::size_t(16);
+    auto refined = std::vector<particle>{};
+    for (std::size_t i = 0; i < max_num_subdivisions; ++i) {
+      refined.clear();
+      refined.reserve(particles.size() * 2);
+      auto num_new_particles = std::size_t{};
+      for (std::size_t j = 0; j < particles.size(); ++j) {
+        auto const& p = particles[j];
+        if (j > 0) {
+          auto const& l = particles[j - 1];
+          if (euclidean_distance(l.x1, p.x1) > desired_spatial_dist * 1.5) {
+            refined.push_back(particle{(l.x0 + p.x0) * 0.5,
+                                       (l.uv0 + p.uv0) * 0.5,
+                                       pos_type::fill(nan<real_type>())});
+            ++num_new_particles;
+          }
+        }
+        refined.push_back(p);
+      }
+      if (num_new_particles == 0) {
+        return;
+      }
+      // gather new particles at the back so that they can be advected in one
+      // parallel loop and scatter them back afterwards
+      auto new_particles = std::vector<particle>{};
+      new_particles.reserve(num_new_particles);
+      for (auto const& p : refined) {
+        if (std::isnan(p.x1(0))) {
+          new_particles.push_back(p);
+        }
+      }
+      advect(new_particles, step);
+      auto it = begin(new_particles);
+      for (auto& p : refined) {
+        if (std::isnan(p.x1(0))) {
+          p = *it++;
+        }
+      }
+      remove_lost_particles(refined);
+      std::swap(particles, refined);
     }
-    return front;
   }
+  //----------------------------------------------------------------------------
+  /// Removes particles whose neighbours are closer than
+  /// 1.25 * desired_spatial_dist along the front. The end points of the front
+  /// are kept.
+  static auto reduce(std::vector<particle>& particles,
+                     real_type const        desired_spatial_dist) -> void {
+    if (particles.size() < 3) {
+      return;
+    }
+    auto kept = std::size_t{};
+    for (std::size_t i = 1; i + 1 < particles.size(); ++i) {
+      auto const d = euclidean_distance(particles[kept].x1, particles[i].x1) +
+                     euclidean_distance(particles[i].x1, particles[i + 1].x1);
+      if (d >= desired_spatial_dist * 1.25) {
+        particles[++kept] = particles[i];
+      }
+    }
+    particles[++kept] = particles.back();
+    particles.resize(kept + 1);
+    if (particles.size() > 2 &&
+        euclidean_distance(particles[particles.size() - 1].x1,
+                           particles[particles.size() - 2].x1) <
+            desired_spatial_dist * 0.5) {
+      particles.erase(prev(end(particles), 2));
+    }
+  }
+  //============================================================================
+ public:
+  /// Advects front by step. Every particle continues from its position on
+  /// front so the cost of a step only depends on the size of the front.
+  auto advect(front_type const& front, real_type const step,
+              real_type const desired_spatial_dist) {
+    assert(step != 0);
+    auto particles = std::vector<particle>{};
+    particles.reserve(size(front));
+    for (auto const v : front) {
+      particles.push_back(
+          particle{at(v), uv(v), pos_type::fill(nan<real_type>())});
+    }
+    advect(particles, step);
+    remove_lost_particles(particles);
+    subdivide(particles, step, desired_spatial_dist);
+    reduce(particles, desired_spatial_dist);
 
+    auto advected_front = front_type{};
+    for (auto const& p : particles) {
+      advected_front.push_back(
+          insert_vertex(p.x1, uv_type{p.uv0(0), p.uv0(1) + step}));
+    }
+    return advected_front;
+  }
   //--------------------------------------------------------------------------
   auto evolve(front_type const& front, real_type step,
-              real_type /*desired_spatial_dist*/) {
-    auto advected_front = advect(front, step);
-
-    //this->subdivide(advected_front, desired_spatial_dist);
-    //this->reduce(advected_front, desired_spatial_dist);
+              real_type desired_spatial_dist) {
+    auto advected_front = advect(front, step, desired_spatial_dist);
+    if (size(advected_front) < 2) {
+      return advected_front;
+    }
     if (step > 0) {
       this->triangulate_timeline(front, advected_front);
     } else {
@@ -0,0 +1,461 @@
+#ifndef TATOOINE_BOUNDING_VOLUME_HIERARCHY_H
+#define TATOOINE_BOUNDING_VOLUME_HIERARCHY_H
+//==============================================================================
+#include <tatooine/for_loop.h>
+#include <tatooine/ray.h>
+#include <tatooine/vec.h>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+//==============================================================================
+namespace tatooine {
+//==============================================================================
+/// Bounding volume hierarchy of the simplices of a mesh.
+///
+/// Nodes are stored in one contiguous array. The two children of an inner node
+/// are stored next to each other and every leaf references a range of the
+/// simplex handle array, so every simplex is referenced exactly once. Splits
+/// are chosen with a binned surface area heuristic along the axis of largest
+/// centroid extent. Subtrees below the top levels are built in parallel.
+///
+/// Queries traverse the hierarchy with a fixed-size stack and either call a
+/// function for every candidate or fill a buffer provided by the caller so
+/// that repeated queries do not allocate.
+template <typename Mesh>
+struct bounding_volume_hierarchy {
+  using mesh_type      = Mesh;
+  using real_type      = typename Mesh::real_type;
+  using simplex_handle = typename Mesh::simplex_handle;
+  static auto constexpr num_dimensions() -> std::size_t {
+    return Mesh::num_dimensions();
+  }
+  using vec_type = vec<real_type, num_dimensions()>;
+  //----------------------------------------------------------------------------
+  struct node {
+    vec_type      min;
+    vec_type      max;
+    // leaves: first simplex handle, inner nodes: index of the left child. The
+    // right child follows the left child.
+    std::uint32_t first;
+    // number of simplex handles; 0 for inner nodes
+    std::uint32_t count;
+    //--------------------------------------------------------------------------
+    auto constexpr is_leaf() const { return count > 0; }
+    auto constexpr left_child_index() const { return first; }
+    auto constexpr right_child_index() const { return first + 1; }
+    //--------------------------------------------------------------------------
+    auto constexpr is_inside(vec_type const& x) const {
+      for (std::size_t i = 0; i < num_dimensions(); ++i) {
+        if (x(i) < min(i) || max(i) < x(i)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    //--------------------------------------------------------------------------
+    /// Slab test for the part of the ray with t >= 0.
+    auto constexpr check_intersection(
+        ray<real_type, num_dimensions()> const& r) const {
+      auto t_min = real_type(0);
+      auto t_max = std::numeric_limits<real_type>::infinity();
+      for (std::size_t i = 0; i < num_dimensions(); ++i) {
+        if (r.direction(i) == 0) {
+          if (r.origin(i) < min(i) || max(i) < r.origin(i)) {
+            return false;
+          }
+          continue;
+        }
+        auto const inv_dir = 1 / r.direction(i);
+        auto       t0      = (min(i) - r.origin(i)) * inv_dir;
+        auto       t1      = (max(i) - r.origin(i)) * inv_dir;
+        if (t0 > t1) {
+          std::swap(t0, t1);
+        }
+        t_min = std::max(t_min, t0);
+        t_max = std::min(t_max, t1);
+        if (t_min > t_max) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+  //----------------------------------------------------------------------------
+  static auto constexpr max_leaf_size = std::size_t(4);
+  static auto constexpr num_bins      = std::size_t(12);
+  /// Deeper nodes are split at the median so that the traversal stack never
+  /// overflows.
+  static auto constexpr max_sah_depth = std::size_t(32);
+  static auto constexpr stack_size    = std::size_t(128);
+  //============================================================================
+ private:
+  mesh_type const*            m_mesh;
+  std::vector<node>           m_nodes;
+  std::vector<simplex_handle> m_simplex_handles;
+  //============================================================================
+ public:
+  explicit bounding_volume_hierarchy(mesh_type const& mesh) : m_mesh{&mesh} {
+    build();
+  }
+  //============================================================================
+  auto mesh() const -> auto const& { return *m_mesh; }
+  auto nodes() const -> auto const& { return m_nodes; }
+  auto simplex_handles() const -> auto const& { return m_simplex_handles; }
+  auto empty() const { return m_nodes.empty(); }
+  //----------------------------------------------------------------------------
+  /// Calls f with the simplices of all leaves whose bounds contain pos. These
+  /// include all simplices whose bounding boxes contain pos.
+  /// \param f returns true to stop the traversal
+  /// \return true if f stopped the traversal
+  template <std::predicate<simplex_handle> F>
+  auto for_each_nearby_simplex(vec_type const& pos, F&& f) const -> bool {
+    return traverse([&](node const& n) { return n.is_inside(pos); },
+                    std::forward<F>(f));
+  }
+  //----------------------------------------------------------------------------
+  /// Replaces the content of simplices with the candidates of
+  /// for_each_nearby_simplex.
+  auto nearby_simplices(vec_type const&              pos,
+                        std::vector<simplex_handle>& simplices) const {
+    simplices.clear();
+    for_each_nearby_simplex(pos, [&](simplex_handle const s) {
+      simplices.push_back(s);
+      return false;
+    });
+  }
+  //----------------------------------------------------------------------------
+  auto nearby_simplices(vec_type const& pos) const {
+    auto simplices = std::vector<simplex_handle>{};
+    nearby_simplices(pos, simplices);
+    return simplices;
+  }
+  //----------------------------------------------------------------------------
+  /// Calls f with the simplices of all leaves whose bounds are hit by r.
+  /// \param f returns true to stop the traversal
+  /// \return true if f stopped the traversal
+  template <std::predicate<simplex_handle> F>
+  auto for_each_possible_intersection(ray<real_type, num_dimensions()> const& r,
+                                      F&& f) const -> bool {
+    return traverse([&](node const& n) { return n.check_intersection(r); },
+                    std::forward<F>(f));
+  }
+  //----------------------------------------------------------------------------
+  /// Replaces the content of simplices with the candidates of
+  /// for_each_possible_intersection.
+  auto collect_possible_intersections(
+      ray<real_type, num_dimensions()> const& r,
+      std::vector<simplex_handle>&            simplices) const {
+    simplices.clear();
+    for_each_possible_intersection(r, [&](simplex_handle const s) {
+      simplices.push_back(s);
+      return false;
+    });
+  }
+  //----------------------------------------------------------------------------
+  auto collect_possible_intersections(
+      ray<real_type, num_dimensions()> const& r) const {
+    auto simplices = std::vector<simplex_handle>{};
+    collect_possible_intersections(r, simplices);
+    return simplices;
+  }
+  //============================================================================
+ private:
+  template <typename NodePredicate, typename F>
+  auto traverse(NodePredicate&& visit, F&& f) const -> bool {
+    if (empty()) {
+      return false;
+    }
+    auto stack = std::array<std::uint32_t, stack_size>{};
+    auto top   = std::size_t(0);
+    stack[top++] = 0;
+    while (top > 0) {
+      auto const& n = m_nodes[stack[--top]];
+      if (!visit(n)) {
+        continue;
+      }
+      if (n.is_leaf()) {
+        for (auto i = n.first; i < n.first + n.count; ++i) {
+          if (f(m_simplex_handles[i])) {
+            return true;
+          }
+        }
+      } else {
+        stack[top++] = n.right_child_index();
+        stack[top++] = n.left_child_index();
+      }
+    }
+    return false;
+  }
+  //============================================================================
+  // construction
+  //============================================================================
+  struct primitive_bounds {
+    vec_type min, max, centroid;
+  };
+  // range of simplex handles that still has to be split
+  struct pending_subtree {
+    std::uint32_t node_index;
+    std::uint32_t begin;
+    std::uint32_t end;
+    std::size_t   depth;
+  };
+  //----------------------------------------------------------------------------
+  auto build() -> void {
+    for (auto const s : mesh().simplices()) {
+      m_simplex_handles.push_back(s);
+    }
+    if (m_simplex_handles.empty()) {
+      return;
+    }
+    auto const num_handles = mesh().simplex_index_data().size() /
+                             mesh_type::num_vertices_per_simplex();
+    auto bounds = std::vector<primitive_bounds>(num_handles);
+    auto const compute_bounds = [&](std::size_t const i) {
+      auto const s  = m_simplex_handles[i];
+      auto&      b  = bounds[s.index()];
+      auto const vs = mesh()[s];
+      b.min         = vec_type::fill(std::numeric_limits<real_type>::max());
+      b.max         = vec_type::fill(std::numeric_limits<real_type>::lowest());
+      [&]<std::size_t... Is>(std::index_sequence<Is...> /*seq*/) {
+        (
+            [&] {
+              auto const& x = mesh()[std::get<Is>(vs)];
+              for (std::size_t j = 0; j < num_dimensions(); ++j) {
+                b.min(j) = std::min(b.min(j), x(j));
+                b.max(j) = std::max(b.max(j), x(j));
+              }
+            }(),
+            ...);
+      }(std::make_index_sequence<mesh_type::num_vertices_per_simplex()>{});
+      b.centroid = (b.min + b.max) * real_type(0.5);
+    };
+#if TATOOINE_PARALLEL_FOR_LOOPS_AVAILABLE
+    for_loop(compute_bounds, execution_policy::parallel,
+             m_simplex_handles.size());
+#else
+    for_loop(compute_bounds, execution_policy::sequential,
+             m_simplex_handles.size());
+#endif
+
+    // split the top levels sequentially until there are enough subtrees to
+    // keep all threads busy
+    auto const parallel_subtree_size =
+        std::max<std::size_t>(m_simplex_handles.size() / 256, 1024);
+    auto pending = std::vector<pending_subtree>{};
+    m_nodes.push_back(node{});
+    build_subtree(m_nodes, bounds,
+                  {0, 0, static_cast<std::uint32_t>(m_simplex_handles.size()),
+                   0},
+                  parallel_subtree_size, pending);
+
+    auto subtrees = std::vector<std::vector<node>>(pending.size());
+    auto const build_pending = [&](std::size_t const i) {
+      auto& nodes = subtrees[i];
+      nodes.push_back(node{});
+      auto p       = pending[i];
+      p.node_index = 0;
+      auto none    = std::vector<pending_subtree>{};
+      build_subtree(nodes, bounds, p, 0, none);
+    };
+#if TATOOINE_PARALLEL_FOR_LOOPS_AVAILABLE
+    for_loop(build_pending, execution_policy::parallel, pending.size());
+#else
+    for_loop(build_pending, execution_policy::sequential, pending.size());
+#endif
+    // splice the subtrees into the node array. The root of a subtree replaces
+    // its placeholder, all other nodes are appended.
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+      auto const& nodes  = subtrees[i];
+      auto const  offset = static_cast<std::uint32_t>(m_nodes.size()) - 1;
+      auto const  relocate = [&](node n) {
+        if (!n.is_leaf()) {
+          n.first += offset;
+        }
+        return n;
+      };
+      m_nodes[pending[i].node_index] = relocate(nodes.front());
+      for (std::size_t j = 1; j < nodes.size(); ++j) {
+        m_nodes.push_back(relocate(nodes[j]));
+      }
+    }
+  }
+  //----------------------------------------------------------------------------
+  /// Recursively splits the range of p. Ranges that are smaller than
+  /// deferred_size are stored in deferred instead of being split if
+  /// deferred_size is not 0.
+  auto build_subtree(std::vector<node>&                   nodes,
+                     std::vector<primitive_bounds> const& bounds,
+                     pending_subtree const& p, std::size_t const deferred_size,
+                     std::vector<pending_subtree>& deferred) -> void {
+    auto& n = nodes[p.node_index];
+    n.min   = vec_type::fill(std::numeric_limits<real_type>::max());
+    n.max   = vec_type::fill(std::numeric_limits<real_type>::lowest());
+    auto centroid_min = n.min;
+    auto centroid_max = n.max;
+    for (auto i = p.begin; i < p.end; ++i) {
+      auto const& b = bounds[m_simplex_handles[i].index()];
+      for (std::size_t j = 0; j < num_dimensions(); ++j) {
+        n.min(j)        = std::min(n.min(j), b.min(j));
+        n.max(j)        = std::max(n.max(j), b.max(j));
+        centroid_min(j) = std::min(centroid_min(j), b.centroid(j));
+        centroid_max(j) = std::max(centroid_max(j), b.centroid(j));
+      }
+    }
+    auto const count = p.end - p.begin;
+    n.first          = p.begin;
+    n.count          = count;
+    if (count <= max_leaf_size) {
+      return;
+    }
+    if (deferred_size > 0 && count <= deferred_size) {
+      deferred.push_back(p);
+      return;
+    }
+    auto axis = std::size_t(0);
+    for (std::size_t j = 1; j < num_dimensions(); ++j) {
+      if (centroid_max(j) - centroid_min(j) >
+          centroid_max(axis) - centroid_min(axis)) {
+        axis = j;
+      }
+    }
+    // all centroids coincide
+    if (centroid_max(axis) == centroid_min(axis)) {
+      return;
+    }
+    auto const handles_begin = begin(m_simplex_handles) + p.begin;
+    auto const handles_end   = begin(m_simplex_handles) + p.end;
+    auto const centroid      = [&](simplex_handle const s) {
+      return bounds[s.index()].centroid(axis);
+    };
+    auto mid = p.begin + count / 2;
+    if (auto const split = p.depth < max_sah_depth
+                               ? sah_split(bounds, p, axis, centroid_min(axis),
+                                           centroid_max(axis))
+                               : std::optional<real_type>{};
+        split) {
+      mid = static_cast<std::uint32_t>(
+          std::partition(handles_begin, handles_end,
+                         [&](auto const s) { return centroid(s) < *split; }) -
+          begin(m_simplex_handles));
+      // rounding may put all centroids on one side
+      if (mid == p.begin || mid == p.end) {
+        mid = p.begin + count / 2;
+        std::nth_element(handles_begin, begin(m_simplex_handles) + mid,
+                         handles_end, [&](auto const l, auto const r) {
+                           return centroid(l) < centroid(r);
+                         });
+      }
+    } else if (p.depth < max_sah_depth && count <= 4 * max_leaf_size) {
+      // splitting does not pay off
+      return;
+    } else {
+      std::nth_element(handles_begin, begin(m_simplex_handles) + mid,
+                       handles_end, [&](auto const l, auto const r) {
+                         return centroid(l) < centroid(r);
+                       });
+    }
+    auto const left = static_cast<std::uint32_t>(nodes.size());
+    // n gets invalidated by the resize
+    nodes[p.node_index].first = left;
+    nodes[p.node_index].count = 0;
+    nodes.resize(nodes.size() + 2);
+    build_subtree(nodes, bounds, {left, p.begin, mid, p.depth + 1},
+                  deferred_size, deferred);
+    build_subtree(nodes, bounds, {left + 1, mid, p.end, p.depth + 1},
+                  deferred_size, deferred);
+  }
+  //----------------------------------------------------------------------------
+  /// \return centroid coordinate along axis that separates the cheapest
+  /// partition or nothing if no partition is cheaper than a leaf
+  auto sah_split(std::vector<primitive_bounds> const& bounds,
+                 pending_subtree const& p, std::size_t const axis,
+                 real_type const centroid_min,
+                 real_type const centroid_max) const
+      -> std::optional<real_type> {
+    struct bin {
+      vec_type    min = vec_type::fill(std::numeric_limits<real_type>::max());
+      vec_type    max = vec_type::fill(std::numeric_limits<real_type>::lowest());
+      std::size_t count = 0;
+      auto        grow(vec_type const& bmin, vec_type const& bmax) {
+        for (std::size_t j = 0; j < num_dimensions(); ++j) {
+          min(j) = std::min(min(j), bmin(j));
+          max(j) = std::max(max(j), bmax(j));
+        }
+      }
+      auto area() const {
+        if (count == 0) {
+          return real_type(0);
+        }
+        // surface measure of the box; the half perimeter in 2D
+        auto a = real_type(0);
+        for (std::size_t j = 0; j < num_dimensions(); ++j) {
+          auto side = real_type(1);
+          for (std::size_t k = 0; k < num_dimensions(); ++k) {
+            if (k != j) {
+              side *= max(k) - min(k);
+            }
+          }
+          a += side;
+        }
+        return a;
+      }
+    };
+    auto       bins  = std::array<bin, num_bins>{};
+    auto const scale = num_bins / (centroid_max - centroid_min);
+    auto const bin_index = [&](real_type const c) {
+      return std::min(num_bins - 1, static_cast<std::size_t>((c - centroid_min) *
+                                                             scale));
+    };
+    for (auto i = p.begin; i < p.end; ++i) {
+      auto const& b  = bounds[m_simplex_handles[i].index()];
+      auto&       bi = bins[bin_index(b.centroid(axis))];
+      bi.grow(b.min, b.max);
+      ++bi.count;
+    }
+    // sweep from the right to get the cost of all right partitions
+    auto right_costs = std::array<real_type, num_bins>{};
+    auto acc         = bin{};
+    for (std::size_t i = num_bins - 1; i > 0; --i) {
+      acc.grow(bins[i].min, bins[i].max);
+      acc.count += bins[i].count;
+      right_costs[i] = acc.area() * static_cast<real_type>(acc.count);
+    }
+    acc            = bin{};
+    auto best_cost = std::numeric_limits<real_type>::infinity();
+    auto best_bin  = std::size_t(0);
+    for (std::size_t i = 0; i + 1 < num_bins; ++i) {
+      acc.grow(bins[i].min, bins[i].max);
+      acc.count += bins[i].count;
+      auto const cost =
+          acc.area() * static_cast<real_type>(acc.count) + right_costs[i + 1];
+      if (acc.count > 0 && acc.count < p.end - p.begin && cost < best_cost) {
+        best_cost = cost;
+        best_bin  = i + 1;
+      }
+    }
+    if (best_bin == 0) {
+      return std::nullopt;
+    }
+    // a leaf costs one intersection test per simplex
+    auto total = bin{};
+    for (auto const& b : bins) {
+      total.grow(b.min, b.max);
+      total.count += b.count;
+    }
+    auto const leaf_cost = total.area() * static_cast<real_type>(total.count);
+    if (p.end - p.begin <= 4 * max_leaf_size && best_cost >= leaf_cost) {
+      return std::nullopt;
+    }
+    return centroid_min + static_cast<real_type>(best_bin) / scale;
+  }
+};
+//==============================================================================
+}  // namespace tatooine
+//==============================================================================
+#endif
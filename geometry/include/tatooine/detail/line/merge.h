@@ -1,103 +1,132 @@
 #ifndef TATOOINE_GEOMETRY_DETAIL_LINE_MERGE_H
 #define TATOOINE_GEOMETRY_DETAIL_LINE_MERGE_H
 //==============================================================================
+#include <tatooine/detail/vertex_welder.h>
 #include <tatooine/line.h>
 
+#include <array>
+#include <limits>
 #include <vector>
 //==============================================================================
-namespace tatooine::detail::line {
+namespace tatooine {
 //==============================================================================
-/// \brief Merges two sets of lines
-/// Lines from parameter lines1 will be inserted into lines0 or possibly merged
-/// intto other lines of lines0.
-template <typename Real, std::size_t NumDimensions>
-auto merge(std::vector<tatooine::line<Real, NumDimensions>> &lines0,
-           std::vector<tatooine::line<Real, NumDimensions>> &lines1) -> void {
-  auto const eps = Real(1e-13);
-  // move line1 pairs to line0 pairs
-  auto const size_before = size(lines0);
-  lines0.resize(size(lines0) + size(lines1));
-  std::ranges::move(lines1, next(begin(lines0), size_before));
-  lines1.clear();
-  lines1.shrink_to_fit();
-
-  // merge line0 side
-  for (auto line0 = begin(lines0); line0 != end(lines0); ++line0) {
-    for (auto line1 = begin(lines0); line1 != end(lines0); ++line1) {
-      if (line0 != line1 && !line0->empty() && !line1->empty()) {
-        // [line0front, ..., LINE0BACK] -> [LINE1FRONT, ..., line1back]
-        if (approx_equal(line0->back_vertex(), line1->front_vertex(), eps)) {
-          for (std::size_t i = line0->vertices().size() - 2; i > 0; --i) {
-            line1->push_front(line0->vertex_at(i));
-          }
-          line0->clear();
-
-          // [line1front, ..., LINE1BACK] -> [LINE0FRONT, ..., line0back]
-        } else if (approx_equal(line1->back_vertex(), line0->front_vertex(),
-                                eps)) {
-          for (std::size_t i = 1; i < line0->vertices().size(); ++i) {
-            line1->push_back(line0->vertex_at(i));
-          }
-          line0->clear();
+/// \brief Merges a set of lines and combines lines with equal vertex endings.
+///
+/// End points are welded with a spatial hash and the resulting chains are
+/// stitched in a single pass so that the running time is linear in the number
+/// of vertices. Chains stop at end points shared by more than two lines.
+/// Chains that return to their first vertex are closed.
+template <range_of_lines Lines>
+auto merge(Lines const& unmerged_lines) {
+  using line_t             = std::ranges::range_value_t<Lines>;
+  using real_type          = typename line_t::real_type;
+  using pos_type           = typename line_t::pos_type;
+  using pos_container_type = typename line_t::pos_container_type;
+  static auto constexpr num_dimensions = line_t::num_dimensions();
+  static auto constexpr eps            = real_type(1e-13);
+  static auto constexpr none = std::numeric_limits<std::size_t>::max();
 
-          // [LINE1FRONT, ..., line1back] -> [LINE0FRONT, ..., line0back]
-        } else if (approx_equal(line1->front_vertex(), line0->front_vertex(),
-                                eps)) {
-          // -> [line1back, ..., LINE1FRONT] -> [LINE0FRONT, ..., line0back]
-          for (std::size_t i = line0->vertices().size() - 2; i > 0; --i) {
-            line1->push_back(line0->vertex_at(i));
-          }
-          line0->clear();
+  auto merged_lines = std::vector<line_t>{};
+  auto segments     = std::vector<line_t const*>{};
+  segments.reserve(std::ranges::size(unmerged_lines));
+  for (auto const& l : unmerged_lines) {
+    if (l.num_vertices() >= 2 && !l.is_closed()) {
+      segments.push_back(&l);
+    } else if (!l.empty()) {
+      merged_lines.push_back(l);
+    }
+  }
+  if (segments.empty()) {
+    return merged_lines;
+  }
 
-          // [line0front, ..., LINE0BACK] -> [line1front,..., LINE1BACK]
-        } else if (approx_equal(line0->back_vertex(), line1->back_vertex(),
-                                eps)) {
-          // -> [line1front, ..., LINE1BACK] -> [LINE0BACK, ..., line0front]
-          for (std::size_t i = line0->vertices().size() - 2; i > 0; --i) {
-            line1->push_back(line0->vertex_at(i));
-          }
-          line0->clear();
-        }
+  // weld end points to nodes
+  auto min = pos_type::fill(std::numeric_limits<real_type>::max());
+  auto max = pos_type::fill(std::numeric_limits<real_type>::lowest());
+  for (auto const s : segments) {
+    for (auto const& x : {s->front_vertex(), s->back_vertex()}) {
+      for (std::size_t i = 0; i < num_dimensions; ++i) {
+        min(i) = std::min(min(i), x(i));
+        max(i) = std::max(max(i), x(i));
       }
     }
   }
-
-  const auto [first, last] =
-      std::ranges::remove_if(lines0, [](auto const &l) { return l.empty(); });
-  lines0.erase(first, last);
-}
-//==============================================================================
-} // namespace tatooine::detail::line
-//==============================================================================
-namespace tatooine {
-//==============================================================================
-/// \brief Merges a set of lines and combines lines with equal vertex endings.
-template <range_of_lines Lines> auto merge(Lines const &unmerged_lines) {
-  using line_t = std::ranges::range_value_t<Lines>;
-  auto merged_lines = std::vector<std::vector<line_t>>(unmerged_lines.size());
-
-  auto unmerged_it = begin(unmerged_lines);
-  for (auto &merged_line : merged_lines) {
-    merged_line.push_back({*unmerged_it});
-    ++unmerged_it;
+  auto welder = detail::vertex_welder<real_type, num_dimensions>{
+      min, max, eps, 2 * segments.size()};
+  // end e = 2 * segment + side with side 0 for front and 1 for back
+  auto end_nodes = std::vector<std::size_t>(2 * segments.size());
+  for (std::size_t i = 0; i < segments.size(); ++i) {
+    end_nodes[2 * i]     = welder.node(segments[i]->front_vertex());
+    end_nodes[2 * i + 1] = welder.node(segments[i]->back_vertex());
+  }
+  // the first two ends incident to every node and the number of incident ends
+  auto node_ends   = std::vector<std::array<std::size_t, 2>>(
+      welder.num_nodes(), std::array{none, none});
+  auto node_degree = std::vector<std::size_t>(welder.num_nodes());
+  for (std::size_t e = 0; e < end_nodes.size(); ++e) {
+    auto const n = end_nodes[e];
+    if (node_degree[n] < 2) {
+      node_ends[n][node_degree[n]] = e;
+    }
+    ++node_degree[n];
   }
 
-  auto num_merge_steps =
-      static_cast<std::size_t>(ceil(log2(unmerged_lines.size())));
-
-  for (std::size_t i = 0; i < num_merge_steps; i++) {
-    std::size_t offset = tatooine::pow(std::size_t(2), i);
-
-#pragma omp parallel for
-    for (std::size_t j = 0; j < unmerged_lines.size(); j += offset * 2) {
-      auto left = j;
-      auto right = j + offset;
-      if (right < unmerged_lines.size()) {
-        detail::line::merge(merged_lines[left], merged_lines[right]);
+  // stitch chains
+  auto visited = std::vector<bool>(segments.size(), false);
+  auto stitch  = [&](std::size_t e) {
+    auto       vertices   = pos_container_type{};
+    auto const first_node = end_nodes[e];
+    auto       closed     = false;
+    while (true) {
+      auto const  i = e / 2;
+      auto const& s = *segments[i];
+      visited[i]    = true;
+      auto const n  = s.num_vertices();
+      // the first vertex is shared with the previous segment of the chain
+      auto const skip = vertices.empty() ? 0 : 1;
+      if (e % 2 == 0) {
+        for (std::size_t j = skip; j < n; ++j) {
+          vertices.push_back(s.vertex_at(j));
+        }
+      } else {
+        for (std::size_t j = skip; j < n; ++j) {
+          vertices.push_back(s.vertex_at(n - 1 - j));
+        }
+      }
+      auto const exit_end  = e ^ 1;
+      auto const exit_node = end_nodes[exit_end];
+      if (node_degree[exit_node] != 2) {
+        break;
       }
+      auto const next_end = node_ends[exit_node][0] == exit_end
+                                ? node_ends[exit_node][1]
+                                : node_ends[exit_node][0];
+      if (visited[next_end / 2]) {
+        closed = exit_node == first_node;
+        break;
+      }
+      e = next_end;
+    }
+    if (closed && vertices.size() > 2) {
+      vertices.pop_back();
+    } else {
+      closed = false;
+    }
+    merged_lines.emplace_back(std::move(vertices), closed);
+  };
+  // open chains start at nodes that do not join exactly two ends
+  for (std::size_t e = 0; e < end_nodes.size(); ++e) {
+    if (!visited[e / 2] && node_degree[end_nodes[e]] != 2) {
+      stitch(e);
+    }
+  }
+  // all remaining segments are part of cycles
+  for (std::size_t i = 0; i < segments.size(); ++i) {
+    if (!visited[i]) {
+      stitch(2 * i);
     }
   }
-  return merged_lines.front();
+  return merged_lines;
 }
 //------------------------------------------------------------------------------
 // template <range_of_lines Lines>
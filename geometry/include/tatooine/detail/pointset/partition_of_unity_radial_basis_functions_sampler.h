@@ -0,0 +1,472 @@
+#if TATOOINE_BLAS_AND_LAPACK_AVAILABLE
+#ifndef TATOOINE_DETAIL_POINTSET_PARTITION_OF_UNITY_RADIAL_BASIS_FUNCTIONS_SAMPLER_H
+#define TATOOINE_DETAIL_POINTSET_PARTITION_OF_UNITY_RADIAL_BASIS_FUNCTIONS_SAMPLER_H
+//==============================================================================
+#include <tatooine/concepts.h>
+#include <tatooine/field.h>
+#include <tatooine/for_loop.h>
+#include <tatooine/lapack.h>
+#include <tatooine/pointset.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <numbers>
+#include <vector>
+//==============================================================================
+namespace tatooine::detail::pointset {
+//==============================================================================
+template <floating_point Real, std::size_t NumDimensions, typename T,
+          invocable<Real> Kernel>
+struct partition_of_unity_radial_basis_functions_sampler;
+//==============================================================================
+/// Radial basis functions interpolation that scales to large point clouds.
+///
+/// The bounding box of the vertices is divided into uniform cells and every
+/// cell carries a patch with a spherical support that covers the cell. A
+/// small radial basis functions system with linear polynomial part is fit to
+/// the vertices around each patch. Evaluations blend the local interpolants
+/// of the patches of neighboring cells with Wendland weights that are
+/// normalized to a partition of unity. Setup time and memory are therefore
+/// linear in the number of vertices.
+///
+/// The factorizations of the local systems do not depend on vertex
+/// properties. They are shared by all samplers created with sampler() so that
+/// several properties of the same point cloud are interpolated without
+/// factoring again.
+template <floating_point Real, std::size_t NumDimensions,
+          invocable<Real> Kernel>
+struct partition_of_unity_radial_basis_functions {
+  using this_type =
+      partition_of_unity_radial_basis_functions<Real, NumDimensions, Kernel>;
+  using pointset_type = tatooine::pointset<Real, NumDimensions>;
+  using vertex_handle = typename pointset_type::vertex_handle;
+  using pos_type      = vec<Real, NumDimensions>;
+  using cell_type     = std::array<std::size_t, NumDimensions>;
+  template <typename T>
+  using vertex_property_type =
+      typename pointset_type::template typed_vertex_property_type<T>;
+  static auto constexpr num_dimensions() { return NumDimensions; }
+  static auto constexpr num_polynomial_coefficients() {
+    return NumDimensions + 1;
+  }
+  //----------------------------------------------------------------------------
+  struct patch {
+    pos_type                   center;
+    std::vector<vertex_handle> vertices;
+    // lower part of the factorized local system
+    std::vector<Real> factorization;
+    std::vector<int>  pivots;
+    //--------------------------------------------------------------------------
+    auto system_size() const {
+      return vertices.size() + num_polynomial_coefficients();
+    }
+    /// Patches whose local system is singular do not contribute.
+    auto is_valid() const { return !factorization.empty(); }
+  };
+  //============================================================================
+ private:
+  pointset_type const*                      m_pointset;
+  Kernel                                    m_kernel;
+  pos_type                                  m_origin;
+  Real                                      m_cell_size      = 1;
+  Real                                      m_support_radius = 1;
+  cell_type                                 m_resolution{};
+  std::shared_ptr<std::vector<patch> const> m_patches;
+  //============================================================================
+ public:
+  /// \param points_per_patch Approximate number of vertices that are fit by
+  ///                         each local system.
+  partition_of_unity_radial_basis_functions(
+      pointset_type const& ps, convertible_to<Kernel> auto&& kernel,
+      std::size_t const points_per_patch = 64)
+      : m_pointset{&ps},
+        m_kernel{std::forward<decltype(kernel)>(kernel)},
+        m_patches{std::make_shared<std::vector<patch> const>()} {
+    auto vertices = std::vector<vertex_handle>{};
+    for (auto const v : ps.vertices()) {
+      vertices.push_back(v);
+    }
+    if (vertices.empty()) {
+      return;
+    }
+    setup_cells(vertices, std::max<std::size_t>(points_per_patch, 1));
+    m_patches = std::make_shared<std::vector<patch> const>(
+        create_patches(vertices, std::max<std::size_t>(points_per_patch, 1)));
+  }
+  //============================================================================
+  auto pointset() const -> auto const& { return *m_pointset; }
+  auto kernel() const -> auto const& { return m_kernel; }
+  auto patches() const -> auto const& { return *m_patches; }
+  auto support_radius() const { return m_support_radius; }
+  //----------------------------------------------------------------------------
+  template <typename T>
+  auto sampler(vertex_property_type<T> const& prop) const {
+    return partition_of_unity_radial_basis_functions_sampler<Real,
+                                                             NumDimensions, T,
+                                                             Kernel>{*this,
+                                                                     prop};
+  }
+  //----------------------------------------------------------------------------
+  /// Calls f(patch_index, weight) for every valid patch whose support
+  /// contains q. The weights are not normalized.
+  auto for_each_patch_weight(pos_type const& q, auto&& f) const -> void {
+    if (patches().empty()) {
+      return;
+    }
+    // a support reaches this many cells beyond the cell of its center
+    auto const ring = static_cast<std::int64_t>(
+        std::ceil(m_support_radius / m_cell_size - Real(0.5)));
+    auto lo = cell_type{};
+    auto hi = cell_type{};
+    for (std::size_t i = 0; i < NumDimensions; ++i) {
+      auto const c = static_cast<std::int64_t>(
+          std::floor((q(i) - m_origin(i)) / m_cell_size));
+      auto const max = static_cast<std::int64_t>(m_resolution[i]) - 1;
+      if (c + ring < 0 || c - ring > max) {
+        return;
+      }
+      lo[i] = static_cast<std::size_t>(std::clamp<std::int64_t>(c - ring, 0, max));
+      hi[i] = static_cast<std::size_t>(std::clamp<std::int64_t>(c + ring, 0, max));
+    }
+    for_each_cell(lo, hi, [&](std::size_t const p) {
+      auto const& pa = patches()[p];
+      if (!pa.is_valid()) {
+        return;
+      }
+      auto const r = euclidean_distance(q, pa.center) / m_support_radius;
+      if (r < 1) {
+        // Wendland's C2 function
+        auto const s = 1 - r;
+        f(p, s * s * s * s * (4 * r + 1));
+      }
+    });
+  }
+  //============================================================================
+ private:
+  /// Chooses cells so that the support of a patch contains about
+  /// points_per_patch vertices.
+  auto setup_cells(std::vector<vertex_handle> const& vertices,
+                   std::size_t const                 points_per_patch) {
+    m_origin = pointset()[vertices.front()];
+    auto max = m_origin;
+    for (auto const v : vertices) {
+      for (std::size_t i = 0; i < NumDimensions; ++i) {
+        m_origin(i) = std::min(m_origin(i), pointset()[v](i));
+        max(i)      = std::max(max(i), pointset()[v](i));
+      }
+    }
+    auto max_extent = Real{};
+    for (std::size_t i = 0; i < NumDimensions; ++i) {
+      max_extent = std::max(max_extent, max(i) - m_origin(i));
+    }
+    // the support is the circumsphere of a cell scaled by overlap
+    auto constexpr overlap = Real(1.2);
+    auto const support_factor =
+        overlap * std::sqrt(Real(NumDimensions)) / 2;
+    auto const unit_ball_volume =
+        std::pow(std::numbers::pi_v<Real>, Real(NumDimensions) / 2) /
+        std::tgamma(Real(NumDimensions) / 2 + 1);
+    auto const num_cells =
+        static_cast<Real>(vertices.size()) * unit_ball_volume *
+        std::pow(support_factor, Real(NumDimensions)) /
+        static_cast<Real>(points_per_patch);
+    auto const num_cells_per_axis = std::max<Real>(
+        1, std::round(std::pow(num_cells, Real(1) / NumDimensions)));
+    m_cell_size = max_extent > 0 ? max_extent / num_cells_per_axis : Real(1);
+    m_support_radius = support_factor * m_cell_size;
+    for (std::size_t i = 0; i < NumDimensions; ++i) {
+      m_resolution[i] = std::max<std::size_t>(
+          1, static_cast<std::size_t>(
+                 std::ceil((max(i) - m_origin(i)) / m_cell_size)));
+    }
+  }
+  //----------------------------------------------------------------------------
+  auto num_cells() const {
+    auto n = std::size_t(1);
+    for (auto const r : m_resolution) {
+      n *= r;
+    }
+    return n;
+  }
+  //----------------------------------------------------------------------------
+  auto cell_of(pos_type const& x) const {
+    auto c = cell_type{};
+    for (std::size_t i = 0; i < NumDimensions; ++i) {
+      c[i] = static_cast<std::size_t>(std::clamp<Real>(
+          std::floor((x(i) - m_origin(i)) / m_cell_size), 0,
+          static_cast<Real>(m_resolution[i] - 1)));
+    }
+    return c;
+  }
+  //----------------------------------------------------------------------------
+  auto plain_index(cell_type const& c) const {
+    auto i = std::size_t{};
+    for (std::size_t d = NumDimensions; d > 0; --d) {
+      i = i * m_resolution[d - 1] + c[d - 1];
+    }
+    return i;
+  }
+  //----------------------------------------------------------------------------
+  /// Calls f with the plain index of every cell in [lo, hi].
+  auto for_each_cell(cell_type const& lo, cell_type const& hi, auto&& f) const
+      -> void {
+    auto c = lo;
+    while (true) {
+      f(plain_index(c));
+      auto d = std::size_t{};
+      for (; d < NumDimensions; ++d) {
+        if (c[d] < hi[d]) {
+          ++c[d];
+          break;
+        }
+        c[d] = lo[d];
+      }
+      if (d == NumDimensions) {
+        return;
+      }
+    }
+  }
+  //----------------------------------------------------------------------------
+  auto create_patches(std::vector<vertex_handle> const& vertices,
+                      std::size_t const points_per_patch) const {
+    // sort vertices by cells
+    auto cell_offsets = std::vector<std::size_t>(num_cells() + 1);
+    for (auto const v : vertices) {
+      ++cell_offsets[plain_index(cell_of(pointset()[v])) + 1];
+    }
+    for (std::size_t i = 1; i < cell_offsets.size(); ++i) {
+      cell_offsets[i] += cell_offsets[i - 1];
+    }
+    auto cell_vertices = std::vector<vertex_handle>(vertices.size());
+    {
+      auto insert_positions = cell_offsets;
+      for (auto const v : vertices) {
+        cell_vertices[insert_positions[plain_index(cell_of(pointset()[v]))]++] =
+            v;
+      }
+    }
+
+    auto const min_num_vertices =
+        std::min(vertices.size(),
+                 std::max(2 * num_polynomial_coefficients(),
+                          points_per_patch / 2));
+    auto patches = std::vector<patch>(num_cells());
+    auto create_patch = [&](std::size_t const p) {
+      auto& pa = patches[p];
+      auto  c  = cell_type{};
+      for (std::size_t i = 0, j = p; i < NumDimensions; ++i) {
+        c[i] = j % m_resolution[i];
+        j /= m_resolution[i];
+        pa.center(i) =
+            m_origin(i) + (static_cast<Real>(c[i]) + Real(0.5)) * m_cell_size;
+      }
+      // fit at least min_num_vertices vertices so that the local systems of
+      // sparsely populated regions are not underdetermined
+      for (auto radius = m_support_radius;; radius *= Real(1.5)) {
+        pa.vertices.clear();
+        auto lo = pos_type{};
+        auto hi = pos_type{};
+        for (std::size_t i = 0; i < NumDimensions; ++i) {
+          lo(i) = pa.center(i) - radius;
+          hi(i) = pa.center(i) + radius;
+        }
+        for_each_cell(cell_of(lo), cell_of(hi), [&](std::size_t const cell) {
+          for (auto i = cell_offsets[cell]; i < cell_offsets[cell + 1]; ++i) {
+            if (euclidean_distance(pointset()[cell_vertices[i]], pa.center) <
+                radius) {
+              pa.vertices.push_back(cell_vertices[i]);
+            }
+          }
+        });
+        if (pa.vertices.size() >= min_num_vertices) {
+          break;
+        }
+      }
+      factorize(pa);
+    };
+#if TATOOINE_PARALLEL_FOR_LOOPS_AVAILABLE
+    tatooine::for_loop(create_patch, execution_policy::parallel, size(patches));
+#else
+    tatooine::for_loop(create_patch, execution_policy::sequential,
+                       size(patches));
+#endif
+    return patches;
+  }
+  //----------------------------------------------------------------------------
+  auto factorize(patch& pa) const {
+    auto const n = pa.vertices.size();
+    auto const N = static_cast<int>(pa.system_size());
+    pa.factorization.assign(pa.system_size() * pa.system_size(), 0);
+    pa.pivots.resize(pa.system_size());
+    auto A = [&](std::size_t const r, std::size_t const c) -> Real& {
+      return pa.factorization[r + c * pa.system_size()];
+    };
+    for (std::size_t c = 0; c < n; ++c) {
+      auto const& pc = pointset()[pa.vertices[c]];
+      for (std::size_t r = c; r < n; ++r) {
+        A(r, c) = m_kernel(
+            squared_euclidean_distance(pc, pointset()[pa.vertices[r]]));
+      }
+      A(n, c) = 1;
+      for (std::size_t i = 0; i < NumDimensions; ++i) {
+        A(n + i + 1, c) = pc(i);
+      }
+    }
+    auto const info = lapack::sytrf<Real>(lapack::uplo::lower, N,
+                                          pa.factorization.data(), N,
+                                          pa.pivots.data());
+    if (info != 0) {
+      pa.factorization.clear();
+      pa.pivots.clear();
+    }
+  }
+};
+//==============================================================================
+template <floating_point Real, std::size_t NumDimensions, typename Kernel>
+partition_of_unity_radial_basis_functions(
+    tatooine::pointset<Real, NumDimensions> const& ps, Kernel&& kernel)
+    -> partition_of_unity_radial_basis_functions<Real, NumDimensions,
+                                                 std::decay_t<Kernel>>;
+//------------------------------------------------------------------------------
+template <floating_point Real, std::size_t NumDimensions, typename Kernel>
+partition_of_unity_radial_basis_functions(
+    tatooine::pointset<Real, NumDimensions> const& ps, Kernel&& kernel,
+    std::size_t const)
+    -> partition_of_unity_radial_basis_functions<Real, NumDimensions,
+                                                 std::decay_t<Kernel>>;
+//==============================================================================
+/// Samples a vertex property with a partition_of_unity_radial_basis_functions
+/// interpolation.
+template <floating_point Real, std::size_t NumDimensions, typename T,
+          invocable<Real> Kernel>
+struct partition_of_unity_radial_basis_functions_sampler
+    : field<partition_of_unity_radial_basis_functions_sampler<
+                Real, NumDimensions, T, Kernel>,
+            Real, NumDimensions, T> {
+  using this_type =
+      partition_of_unity_radial_basis_functions_sampler<Real, NumDimensions, T,
+                                                        Kernel>;
+  using parent_type = field<this_type, Real, NumDimensions, T>;
+  using typename parent_type::pos_type;
+  using typename parent_type::real_type;
+  using typename parent_type::tensor_type;
+  using interpolation_type =
+      partition_of_unity_radial_basis_functions<Real, NumDimensions, Kernel>;
+  using pointset_type = tatooine::pointset<Real, NumDimensions>;
+  using vertex_property_type =
+      typename pointset_type::template typed_vertex_property_type<T>;
+  static auto constexpr num_components() {
+    if constexpr (arithmetic<T>) {
+      return std::size_t(1);
+    } else {
+      return T::num_components();
+    }
+  }
+  //============================================================================
+ private:
+  interpolation_type          m_interpolation;
+  vertex_property_type const* m_property;
+  // radial and monomial coefficients of each patch stored column-wise per
+  // component
+  std::vector<std::vector<Real>> m_coefficients;
+  //============================================================================
+ public:
+  partition_of_unity_radial_basis_functions_sampler(
+      interpolation_type interpolation, vertex_property_type const& prop)
+      : m_interpolation{std::move(interpolation)},
+        m_property{&prop},
+        m_coefficients(m_interpolation.patches().size()) {
+    auto solve = [&](std::size_t const p) {
+      auto const& pa = m_interpolation.patches()[p];
+      if (!pa.is_valid()) {
+        return;
+      }
+      auto const N = pa.system_size();
+      auto&      B = m_coefficients[p];
+      B.assign(N * num_components(), 0);
+      for (std::size_t i = 0; i < pa.vertices.size(); ++i) {
+        auto const& value = prop[pa.vertices[i]];
+        if constexpr (arithmetic<T>) {
+          B[i] = value;
+        } else {
+          for (std::size_t j = 0; j < num_components(); ++j) {
+            B[i + j * N] = value.data()[j];
+          }
+        }
+      }
+      lapack::sytrs<Real>(lapack::uplo::lower, static_cast<int>(N),
+                          static_cast<int>(num_components()),
+                          pa.factorization.data(), static_cast<int>(N),
+                          pa.pivots.data(), B.data(), static_cast<int>(N));
+    };
+#if TATOOINE_PARALLEL_FOR_LOOPS_AVAILABLE
+    tatooine::for_loop(solve, execution_policy::parallel,
+                       m_coefficients.size());
+#else
+    tatooine::for_loop(solve, execution_policy::sequential,
+                       m_coefficients.size());
+#endif
+  }
+  //----------------------------------------------------------------------------
+  partition_of_unity_radial_basis_functions_sampler(
+      partition_of_unity_radial_basis_functions_sampler const&) = default;
+  partition_of_unity_radial_basis_functions_sampler(
+      partition_of_unity_radial_basis_functions_sampler&&) noexcept = default;
+  auto operator=(partition_of_unity_radial_basis_functions_sampler const&)
+      -> partition_of_unity_radial_basis_functions_sampler& = default;
+  auto operator=(partition_of_unity_radial_basis_functions_sampler&&) noexcept
+      -> partition_of_unity_radial_basis_functions_sampler& = default;
+  ~partition_of_unity_radial_basis_functions_sampler() = default;
+  //============================================================================
+  auto interpolation() const -> auto const& { return m_interpolation; }
+  //----------------------------------------------------------------------------
+  [[nodiscard]] auto evaluate(pos_type const& q, real_type const /*t*/) const
+      -> tensor_type {
+    auto const& ps           = m_interpolation.pointset();
+    auto        acc          = std::array<Real, num_components()>{};
+    auto        accumulated_weight = Real{};
+    m_interpolation.for_each_patch_weight(
+        q, [&](std::size_t const p, Real const weight) {
+          auto const& pa = m_interpolation.patches()[p];
+          auto const& B  = m_coefficients[p];
+          auto const  n  = pa.vertices.size();
+          auto const  N  = pa.system_size();
+          auto local     = std::array<Real, num_components()>{};
+          for (std::size_t i = 0; i < n; ++i) {
+            auto const phi = m_interpolation.kernel()(
+                squared_euclidean_distance(q, ps[pa.vertices[i]]));
+            for (std::size_t j = 0; j < num_components(); ++j) {
+              local[j] += B[i + j * N] * phi;
+            }
+          }
+          for (std::size_t j = 0; j < num_components(); ++j) {
+            local[j] += B[n + j * N];
+            for (std::size_t k = 0; k < NumDimensions; ++k) {
+              local[j] += B[n + 1 + k + j * N] * q(k);
+            }
+            acc[j] += weight * local[j];
+          }
+          accumulated_weight += weight;
+        });
+    if (accumulated_weight == 0) {
+      return parent_type::ood_tensor();
+    }
+    if constexpr (arithmetic<T>) {
+      return acc[0] / accumulated_weight;
+    } else {
+      auto value = T{};
+      for (std::size_t j = 0; j < num_components(); ++j) {
+        value.data()[j] = acc[j] / accumulated_weight;
+      }
+      return value;
+    }
+  }
+};
+//==============================================================================
+}  // namespace tatooine::detail::pointset
+//==============================================================================
+#endif
+#endif
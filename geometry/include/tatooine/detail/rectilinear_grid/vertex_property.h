@@ -238,6 +238,17 @@ struct typed_vertex_property_interface : vertex_property<Grid> {
   //----------------------------------------------------------------------------
   virtual auto plain_at(std::size_t) -> reference = 0;
   //----------------------------------------------------------------------------
+  auto value_at(integral auto const... indices) const -> value_type
+  requires(sizeof...(indices) == num_dimensions()) {
+    return value_at(std::array{static_cast<std::size_t>(indices)...});
+  }
+  //----------------------------------------------------------------------------
+  /// Returns a copy of the value. Unlike at() this stays safe for containers
+  /// that may free their storage at any time like lazy_reader.
+  virtual auto value_at(
+      std::array<std::size_t, num_dimensions()> const& indices) const
+      -> value_type = 0;
+  //----------------------------------------------------------------------------
 #if TATOOINE_PNG_AVAILABLE
   template <invocable<ValueType> T>
   auto write_png(filesystem::path const& path, T&& f, auto&& color_scale,
@@ -384,6 +395,12 @@ struct typed_vertex_property
   using grid_type        = Grid;
   using real_type        = typename Grid::real_type;
   using prop_parent_type::num_dimensions;
+  using prop_parent_type::value_at;
+  /// Containers like lazy_reader that can only safely hand out copies.
+  static constexpr bool has_value_at = requires(Container const& c) {
+    c.value_at(std::declval<
+               std::array<std::size_t, Grid::num_dimensions()>>());
+  };
   //============================================================================
   // ctors
   //============================================================================
@@ -407,7 +424,11 @@ struct typed_vertex_property
   //----------------------------------------------------------------------------
   constexpr auto operator()(integral auto const... indices) const
       -> decltype(auto) requires(sizeof...(indices) == Grid::num_dimensions()) {
-    return Container::at(indices...);
+    if constexpr (has_value_at) {
+      return Container::value_at(indices...);
+    } else {
+      return Container::at(indices...);
+    }
   }
   //----------------------------------------------------------------------------
   constexpr auto operator()(integral auto const... indices)
@@ -451,6 +472,21 @@ struct typed_vertex_property
     return Container::operator[](i);
   }
   //----------------------------------------------------------------------------
+  template <std::size_t... Is>
+  auto value_at(std::array<std::size_t, num_dimensions()> const& is,
+                std::index_sequence<Is...> /*seq*/) const -> value_type {
+    if constexpr (has_value_at) {
+      return Container::value_at(is[Is]...);
+    } else {
+      return Container::at(is[Is]...);
+    }
+  }
+  //----------------------------------------------------------------------------
+  auto value_at(std::array<std::size_t, num_dimensions()> const& is) const
+      -> value_type override {
+    return value_at(is, std::make_index_sequence<num_dimensions()>{});
+  }
+  //----------------------------------------------------------------------------
   auto plain_at(std::size_t const i) -> reference override {
     return Container::operator[](i);
   }
@@ -10,6 +10,11 @@
 #include <tatooine/invoke_unpacked.h>
 #include <tatooine/tensor_type_traits.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <span>
 #include <vector>
 //==============================================================================
 namespace tatooine::detail::rectilinear_grid {
@@ -84,6 +89,14 @@ struct base_vertex_property_sampler {
   static auto constexpr num_components() {
     return tatooine::tensor_num_components<value_type>;
   }
+  /// Maximal number of vertices used for finite differences.
+  static auto constexpr max_stencil_size() -> std::size_t { return 5; }
+  //----------------------------------------------------------------------------
+  /// Number of vertices used for finite differences in a dimension with
+  /// dim_size vertices.
+  static auto constexpr stencil_size(std::size_t const dim_size) {
+    return std::min(dim_size, max_stencil_size());
+  }
   //----------------------------------------------------------------------------
   /// returns casted as_derived data
   [[nodiscard]] auto constexpr as_derived_sampler() -> DerivedSampler& {
@@ -102,9 +115,11 @@ struct base_vertex_property_sampler {
   //----------------------------------------------------------------------------
   auto grid() const -> auto const& { return as_derived_sampler().grid(); }
   //----------------------------------------------------------------------------
-  /// data at specified indices is...
+  /// Copy of the data at specified indices is... Lazily loaded properties may
+  /// free the memory of a vertex while neighboring vertices are read so no
+  /// references are handed out.
   /// CRTP-virtual method
-  auto data_at(integral auto const... is) const -> value_type const& {
+  auto data_at(integral auto const... is) const -> value_type {
     static_assert(sizeof...(is) == num_dimensions(),
                   "Number of indices does not match number of dimensions.");
     return as_derived_sampler().data_at(is...);
@@ -120,6 +135,14 @@ struct base_vertex_property_sampler {
   auto cell_index(arithmetic auto const x) const -> decltype(auto) {
     return as_derived_sampler().template cell_index<DimensionIndex>(x);
   }
+  //----------------------------------------------------------------------------
+  /// Finite differences coefficients of all vertices of a dimension.
+  /// CRTP-virtual method
+  auto finite_differences_coefficients_table(
+      std::size_t const dimension_index) const -> auto const& {
+    return as_derived_sampler().finite_differences_coefficients_table(
+        dimension_index);
+  }
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   /// indexing of data.
   /// if num_dimensions() == 1 returns actual data otherwise returns a
@@ -135,11 +158,14 @@ struct base_vertex_property_sampler {
   auto operator[](std::size_t i) const -> decltype(auto) { return at(i); }
   //----------------------------------------------------------------------------
  protected:
+  /// Reads the coefficients from the table the top sampler fetched on
+  /// construction so that no lock has to be taken.
   auto finite_differences_coefficients(std::size_t const vertex_index,
                                        std::size_t const stencil_size) const {
-    auto d = grid().finite_differences_coefficients(
-        stencil_size, current_dimension_index(), vertex_index);
-    return d;
+    auto const& table =
+        as_derived_sampler().finite_differences_coefficients_table(
+            current_dimension_index());
+    return std::span{table.data() + vertex_index * stencil_size, stencil_size};
   }
   //----------------------------------------------------------------------------
   /// Calcuates derivative from samples and differential coefficients.
@@ -178,7 +204,7 @@ struct base_vertex_property_sampler {
     auto const [left_global_index, interpolation_factor] = cit_head;
     auto const  right_global_index                = left_global_index + 1;
     auto const& dim = grid().template dimension<current_dimension_index()>();
-    auto const  stencil_size      = min(dim.size(), std::size_t(5));
+    auto const  stencil_size      = this_type::stencil_size(dim.size());
     auto const  half_stencil_size = stencil_size / 2;
 
     auto left_global_begin = left_global_index < half_stencil_size
@@ -206,28 +232,29 @@ struct base_vertex_property_sampler {
     auto const right_local_index = left_local_index + 1;
 
     // get samples for calculating derivatives
-    auto samples = std::vector<value_type>{};
-    samples.reserve(stencil_size + 1);
-    // get samples
-    for (auto i = range_global_begin; i < range_global_end; ++i) {
+    auto samples = std::array<value_type, max_stencil_size() + 1>{};
+    auto const num_samples = range_global_end - range_global_begin;
+    for (std::size_t i = 0; i < num_samples; ++i) {
       if constexpr (num_dimensions() == 1) {
-        samples.push_back(at(i));
+        samples[i] = at(range_global_begin + i);
       } else {
-        samples.push_back(at(i).interpolate_cell(cit_tail...));
+        samples[i] = at(range_global_begin + i).interpolate_cell(cit_tail...);
       }
     }
+    auto const samples_begin = begin(samples);
+    auto const samples_end   = samples_begin + num_samples;
 
     // differentiate left sample
     auto coeffs_left =
         finite_differences_coefficients(left_global_index, stencil_size);
-    auto const dleft_dx = differentiate(coeffs_left, begin(samples),
-                                        begin(samples) + stencil_size);
+    auto const dleft_dx = differentiate(coeffs_left, samples_begin,
+                                        samples_begin + stencil_size);
 
     // differentiate right sample
     auto coeffs_right =
         finite_differences_coefficients(right_global_index, stencil_size);
     auto const dright_dx =
-        differentiate(coeffs_right, end(samples) - stencil_size, end(samples));
+        differentiate(coeffs_right, samples_end - stencil_size, samples_end);
 
     auto const dy = dim[right_global_index] - dim[left_global_index];
     return HeadInterpolationKernel<value_type>{
@@ -290,23 +317,74 @@ struct vertex_property_sampler
   }
   //----------------------------------------------------------------------------
   static_assert(is_floating_point<tatooine::value_type<value_type>>);
+  using finite_differences_coefficients_table_type =
+      std::decay_t<decltype(std::declval<typename property_type::grid_type>()
+                                .finite_differences_coefficients_table(1, 0))>;
   //============================================================================
  private:
   property_type const& m_property;
+  // finite differences coefficients of dimensions that need derivatives and
+  // the generation of the grid's tables they belong to. fetched again when the
+  // grid invalidated its tables. atomic because concurrent evaluations may
+  // fetch at the same time
+  mutable std::array<std::atomic<finite_differences_coefficients_table_type const*>,
+                     num_dimensions()>
+                             m_finite_differences_coefficients_tables = {};
+  mutable std::atomic_size_t m_finite_differences_coefficients_generation =
+      std::numeric_limits<std::size_t>::max();
   //============================================================================
  public:
-  vertex_property_sampler(property_type const& prop) : m_property{prop} {}
+  vertex_property_sampler(property_type const& prop) : m_property{prop} {
+    fetch_finite_differences_coefficients_tables(
+        std::make_index_sequence<num_dimensions()>{});
+  }
   //----------------------------------------------------------------------------
-  vertex_property_sampler(vertex_property_sampler const& other)     = default;
-  vertex_property_sampler(vertex_property_sampler&& other) noexcept = default;
+  vertex_property_sampler(vertex_property_sampler const& other)
+      : vertex_property_sampler{other.m_property} {}
+  vertex_property_sampler(vertex_property_sampler&& other) noexcept
+      : vertex_property_sampler{other.m_property} {}
   //============================================================================
   auto property() const -> auto const& { return m_property; }
   //----------------------------------------------------------------------------
   auto grid() const -> auto const& { return m_property.grid(); }
   //----------------------------------------------------------------------------
-  auto data_at(integral auto const... is) const -> value_type const&
+  auto finite_differences_coefficients_table(
+      std::size_t const dimension_index) const -> auto const& {
+    if (m_finite_differences_coefficients_generation.load(
+            std::memory_order_acquire) !=
+        grid().finite_differences_coefficients_generation()) {
+      fetch_finite_differences_coefficients_tables(
+          std::make_index_sequence<num_dimensions()>{});
+    }
+    return *m_finite_differences_coefficients_tables[dimension_index].load(
+        std::memory_order_relaxed);
+  }
+  //----------------------------------------------------------------------------
+ private:
+  template <std::size_t... Is>
+  auto fetch_finite_differences_coefficients_tables(
+      std::index_sequence<Is...> /*seq*/) const -> void {
+    auto const generation = grid().finite_differences_coefficients_generation();
+    (
+        [&] {
+          if constexpr (InterpolationKernels<value_type>::num_derivatives > 0) {
+            m_finite_differences_coefficients_tables[Is].store(
+                &grid().finite_differences_coefficients_table(
+                    parent_type::stencil_size(
+                        grid().template dimension<Is>().size()),
+                    Is),
+                std::memory_order_relaxed);
+          }
+        }(),
+        ...);
+    m_finite_differences_coefficients_generation.store(
+        generation, std::memory_order_release);
+  }
+  //----------------------------------------------------------------------------
+ public:
+  auto data_at(integral auto const... is) const -> value_type
   requires(sizeof...(is) == GridVertexProperty::grid_type::num_dimensions()) {
-    return m_property(is...);
+    return m_property.value_at(is...);
   }
   //----------------------------------------------------------------------------
   auto position_at(integral auto const... is) const {
@@ -378,9 +456,15 @@ struct vertex_property_sampler_view
   //----------------------------------------------------------------------------
   auto grid() const -> auto const& { return m_top_sampler.grid(); }
   //----------------------------------------------------------------------------
+  auto finite_differences_coefficients_table(
+      std::size_t const dimension_index) const -> auto const& {
+    return m_top_sampler.finite_differences_coefficients_table(
+        dimension_index);
+  }
+  //----------------------------------------------------------------------------
   /// returns data of top vertex_property_sampler at
   /// m_fixed_index and index list is...
-  auto constexpr data_at(integral auto const... is) const -> value_type const& {
+  auto constexpr data_at(integral auto const... is) const -> value_type {
     static_assert(sizeof...(is) == num_dimensions(),
                   "Number of indices is not equal to number of dimensions.");
     return m_top_sampler.data_at(m_fixed_index, is...);
@@ -469,10 +553,10 @@ struct differentiated_sampler<GridVertexProperty, interpolation::linear,
   auto constexpr sample(arithmetic auto x, arithmetic auto y) const {
     auto const [ix, u] = m_sampler.template cell_index<0>(x);
     auto const [iy, v] = m_sampler.template cell_index<1>(y);
-    auto const& a   = m_sampler.data_at(ix, iy);
-    auto const& b   = m_sampler.data_at(ix + 1, iy);
-    auto const& c   = m_sampler.data_at(ix, iy + 1);
-    auto const& d   = m_sampler.data_at(ix + 1, iy + 1);
+    auto const  a   = m_sampler.data_at(ix, iy);
+    auto const  b   = m_sampler.data_at(ix + 1, iy);
+    auto const  c   = m_sampler.data_at(ix, iy + 1);
+    auto const  d   = m_sampler.data_at(ix + 1, iy + 1);
 
     auto const k     = d - c - b + a;
     auto const dx    = k * v + b - a;
@@ -516,14 +600,14 @@ struct differentiated_sampler<GridVertexProperty, interpolation::linear,
     auto const [ix, u] = m_sampler.template cell_index<0>(x);
     auto const [iy, v] = m_sampler.template cell_index<1>(y);
     auto const [iz, w] = m_sampler.template cell_index<2>(z);
-    auto const& a   = m_sampler.data_at(ix, iy, iz);
-    auto const& b   = m_sampler.data_at(ix + 1, iy, iz);
-    auto const& c   = m_sampler.data_at(ix, iy + 1, iz);
-    auto const& d   = m_sampler.data_at(ix + 1, iy + 1, iz);
-    auto const& e   = m_sampler.data_at(ix, iy, iz + 1);
-    auto const& f   = m_sampler.data_at(ix + 1, iy, iz + 1);
-    auto const& g   = m_sampler.data_at(ix, iy + 1, iz + 1);
-    auto const& h   = m_sampler.data_at(ix + 1, iy + 1, iz + 1);
+    auto const  a   = m_sampler.data_at(ix, iy, iz);
+    auto const  b   = m_sampler.data_at(ix + 1, iy, iz);
+    auto const  c   = m_sampler.data_at(ix, iy + 1, iz);
+    auto const  d   = m_sampler.data_at(ix + 1, iy + 1, iz);
+    auto const  e   = m_sampler.data_at(ix, iy, iz + 1);
+    auto const  f   = m_sampler.data_at(ix + 1, iy, iz + 1);
+    auto const  g   = m_sampler.data_at(ix, iy + 1, iz + 1);
+    auto const  h   = m_sampler.data_at(ix + 1, iy + 1, iz + 1);
 
     auto const k  = h - g - f + e - d + c + b - a;
     auto const dx = (k * v + f - e - b + a) * w + (d - c - b + a) * v + b - a;
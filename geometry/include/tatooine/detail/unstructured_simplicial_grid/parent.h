@@ -54,11 +54,8 @@ struct parent<Mesh, Real, 3, 2> : pointset<Real, 3>,
     auto const&      grid         = as_grid();
     auto             global_min_t = std::numeric_limits<real_type>::max();
     auto             inters       = optional_intersection_type{};
-    if (!grid.m_hierarchy) {
-      grid.build_hierarchy();
-    }
     auto const possible_simplices =
-        grid.m_hierarchy->collect_possible_intersections(r);
+        grid.hierarchy().collect_possible_intersections(r);
     for (auto const simplex_handle : possible_simplices) {
       auto const [vi0, vi1, vi2] = grid.simplex_at(simplex_handle);
       auto const& v0             = grid.at(vi0);
@@ -0,0 +1,243 @@
+#ifndef TATOOINE_DETAIL_UNSTRUCTURED_SIMPLICIAL_GRID_POINT_LOCATOR_H
+#define TATOOINE_DETAIL_UNSTRUCTURED_SIMPLICIAL_GRID_POINT_LOCATOR_H
+//==============================================================================
+#include <tatooine/unstructured_simplicial_grid.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <vector>
+//==============================================================================
+namespace tatooine::detail::unstructured_simplicial_grid {
+//==============================================================================
+/// Point location is only available for simplices that span the whole space.
+template <floating_point Real, std::size_t NumDimensions,
+          std::size_t SimplexDim>
+struct point_locator {};
+//==============================================================================
+/// Locates the simplex that contains a position.
+///
+/// For every simplex the inverse of the matrix spanned by its edges is
+/// precomputed so that barycentric coordinates cost one matrix-vector product.
+/// Additionally every simplex knows its neighbor across each of its faces.
+/// Given a start simplex, for example the result of a preceding query along a
+/// pathline, a query walks towards the position by repeatedly crossing the
+/// face with the most negative barycentric coordinate. Only if the walk
+/// leaves the grid or does not arrive within a bounded number of steps the
+/// uniform tree hierarchy of the grid is searched.
+///
+/// The locator must be rebuilt whenever the grid changes.
+template <floating_point Real, std::size_t NumDimensions>
+struct point_locator<Real, NumDimensions, NumDimensions> {
+  using grid_type =
+      tatooine::unstructured_simplicial_grid<Real, NumDimensions,
+                                             NumDimensions>;
+  using simplex_handle = typename grid_type::simplex_handle;
+  using pos_type       = typename grid_type::pos_type;
+  static auto constexpr num_vertices_per_simplex() {
+    return grid_type::num_vertices_per_simplex();
+  }
+  using barycentric_coordinates_type = vec<Real, num_vertices_per_simplex()>;
+  using edge_matrix_type             = mat<Real, NumDimensions, NumDimensions>;
+  //----------------------------------------------------------------------------
+  struct location {
+    simplex_handle               simplex;
+    barycentric_coordinates_type barycentric_coordinates;
+  };
+  //----------------------------------------------------------------------------
+  /// tolerance of barycentric coordinates for positions on faces
+  static auto constexpr eps = Real(1e-8);
+  /// marks faces at the boundary of the grid
+  static auto constexpr boundary = std::numeric_limits<std::size_t>::max();
+  //============================================================================
+ private:
+  grid_type const*              m_grid;
+  std::vector<pos_type>         m_origins;
+  std::vector<edge_matrix_type> m_inverse_edge_matrices;
+  // num_vertices_per_simplex() neighbors per simplex. Neighbor i lies
+  // opposite to the i-th vertex.
+  std::vector<std::size_t> m_neighbors;
+  std::size_t              m_max_walk_steps;
+  //============================================================================
+ public:
+  /// Removed simplices are never located.
+  explicit point_locator(grid_type const& grid)
+      : m_grid{&grid},
+        m_origins(num_simplex_handles(grid)),
+        m_inverse_edge_matrices(
+            num_simplex_handles(grid),
+            edge_matrix_type::fill(std::numeric_limits<Real>::quiet_NaN())),
+        m_neighbors(num_simplex_handles(grid) * num_vertices_per_simplex(),
+                    boundary),
+        // a straight walk crosses about n^(1/d) simplices
+        m_max_walk_steps{std::max<std::size_t>(
+            64, 4 * static_cast<std::size_t>(std::pow(
+                        static_cast<Real>(num_simplex_handles(grid)),
+                        Real(1) / NumDimensions)))} {
+    compute_inverse_edge_matrices();
+    compute_neighbors();
+  }
+  //============================================================================
+  auto grid() const -> auto const& { return *m_grid; }
+  //----------------------------------------------------------------------------
+  /// \return simplex on the other side of the face opposite to vertex i of s
+  auto neighbor(simplex_handle const s, std::size_t const i) const
+      -> std::optional<simplex_handle> {
+    auto const n = m_neighbors[s.index() * num_vertices_per_simplex() + i];
+    if (n == boundary) {
+      return std::nullopt;
+    }
+    return simplex_handle{n};
+  }
+  //----------------------------------------------------------------------------
+  /// Coordinates are NaN for degenerate simplices.
+  auto barycentric_coordinates(simplex_handle const s, pos_type const& x) const
+      -> barycentric_coordinates_type {
+    auto const lambda = m_inverse_edge_matrices[s.index()] *
+                        (x - m_origins[s.index()]);
+    auto b = barycentric_coordinates_type{};
+    b(0)   = 1;
+    for (std::size_t i = 0; i < NumDimensions; ++i) {
+      b(i + 1) = lambda(i);
+      b(0) -= lambda(i);
+    }
+    return b;
+  }
+  //----------------------------------------------------------------------------
+  static auto is_inside(barycentric_coordinates_type const& b) {
+    for (std::size_t i = 0; i < num_vertices_per_simplex(); ++i) {
+      if (!(b(i) >= -eps && b(i) <= 1 + eps)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  //----------------------------------------------------------------------------
+  /// Searches the hierarchy of the grid.
+  auto locate(pos_type const& x) const -> std::optional<location> {
+    if (m_origins.empty()) {
+      return std::nullopt;
+    }
+    auto found = std::optional<location>{};
+    grid().hierarchy().for_each_nearby_simplex(
+        x, [&](simplex_handle const s) {
+          auto const b = barycentric_coordinates(s, x);
+          if (is_inside(b)) {
+            found = location{s, b};
+            return true;
+          }
+          return false;
+        });
+    return found;
+  }
+  //----------------------------------------------------------------------------
+  /// Walks from start to x and falls back to the hierarchy if the walk does
+  /// not succeed.
+  auto locate(pos_type const& x, simplex_handle start) const
+      -> std::optional<location> {
+    if (start.index() >= m_origins.size()) {
+      return locate(x);
+    }
+    for (std::size_t step = 0; step < m_max_walk_steps; ++step) {
+      auto const b = barycentric_coordinates(start, x);
+      // leave the simplex through the face with the most negative coordinate
+      auto exit_face = num_vertices_per_simplex();
+      auto min_b     = -eps;
+      for (std::size_t i = 0; i < num_vertices_per_simplex(); ++i) {
+        if (b(i) < min_b) {
+          min_b     = b(i);
+          exit_face = i;
+        }
+      }
+      if (exit_face == num_vertices_per_simplex()) {
+        if (is_inside(b)) {
+          return location{start, b};
+        }
+        // NaN coordinates of a degenerate simplex
+        break;
+      }
+      auto const next = neighbor(start, exit_face);
+      if (!next) {
+        break;
+      }
+      start = *next;
+    }
+    return locate(x);
+  }
+  //============================================================================
+ private:
+  static auto num_simplex_handles(grid_type const& grid) {
+    return grid.simplex_index_data().size() / num_vertices_per_simplex();
+  }
+  //----------------------------------------------------------------------------
+  /// Degenerate simplices keep NaN matrices.
+  auto compute_inverse_edge_matrices() -> void {
+    for (auto const s : grid().simplices()) {
+      auto const vs = grid().simplex_at(s);
+      auto const x0 = grid()[std::get<0>(vs)];
+      auto       E  = edge_matrix_type{};
+      [&]<std::size_t... Is>(std::index_sequence<Is...> /*seq*/) {
+        (
+            [&] {
+              auto const e = grid()[std::get<Is + 1>(vs)] - x0;
+              for (std::size_t r = 0; r < NumDimensions; ++r) {
+                E(r, Is) = e(r);
+              }
+            }(),
+            ...);
+      }(std::make_index_sequence<NumDimensions>{});
+      m_origins[s.index()] = x0;
+      auto I = edge_matrix_type::eye();
+      if (auto const E_inv = solve(E, I); E_inv) {
+        m_inverse_edge_matrices[s.index()] = *E_inv;
+      }
+    }
+  }
+  //----------------------------------------------------------------------------
+  /// Sorts all faces by their vertices so that the two simplices sharing a
+  /// face become adjacent.
+  auto compute_neighbors() -> void {
+    using face_vertices_type = std::array<std::size_t, NumDimensions>;
+    struct face {
+      face_vertices_type vertices;
+      std::size_t        simplex;
+      std::size_t        opposite_vertex;
+    };
+    auto faces = std::vector<face>{};
+    faces.reserve(m_neighbors.size());
+    for (auto const s : grid().simplices()) {
+      auto const vs       = grid().simplex_at(s);
+      auto       vertices = std::array<std::size_t, num_vertices_per_simplex()>{};
+      [&]<std::size_t... Is>(std::index_sequence<Is...> /*seq*/) {
+        ((vertices[Is] = std::get<Is>(vs).index()), ...);
+      }(std::make_index_sequence<num_vertices_per_simplex()>{});
+      for (std::size_t i = 0; i < num_vertices_per_simplex(); ++i) {
+        auto& f = faces.emplace_back(face{{}, s.index(), i});
+        for (std::size_t j = 0, k = 0; j < num_vertices_per_simplex(); ++j) {
+          if (j != i) {
+            f.vertices[k++] = vertices[j];
+          }
+        }
+        std::ranges::sort(f.vertices);
+      }
+    }
+    std::ranges::sort(faces, {}, &face::vertices);
+    for (std::size_t i = 0; i + 1 < faces.size(); ++i) {
+      if (faces[i].vertices == faces[i + 1].vertices) {
+        auto const& f0 = faces[i];
+        auto const& f1 = faces[i + 1];
+        m_neighbors[f0.simplex * num_vertices_per_simplex() +
+                    f0.opposite_vertex] = f1.simplex;
+        m_neighbors[f1.simplex * num_vertices_per_simplex() +
+                    f1.opposite_vertex] = f0.simplex;
+        ++i;
+      }
+    }
+  }
+};
+//==============================================================================
+}  // namespace tatooine::detail::unstructured_simplicial_grid
+//==============================================================================
+#endif
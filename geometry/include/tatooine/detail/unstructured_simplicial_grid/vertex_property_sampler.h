@@ -2,6 +2,8 @@
 #define TATOOINE_DETAIL_UNSTRUCTURED_SIMPLICIAL_GRID_VERTEX_PROPERTY_SAMPLER_H
 //==============================================================================
 #include <tatooine/unstructured_simplicial_grid.h>
+
+#include <atomic>
 //==============================================================================
 namespace tatooine::detail::unstructured_simplicial_grid {
 //==============================================================================
@@ -26,30 +28,61 @@ struct vertex_property_sampler
  private:
   grid_type const&                  m_grid;
   typed_vertex_property_type const& m_prop;
+  // start of the walk of the next query if the grid has a point locator.
+  // Any simplex is a valid start so concurrent queries may overwrite it.
+  mutable std::atomic<std::size_t> m_last_simplex = 0;
   //--------------------------------------------------------------------------
  public:
   vertex_property_sampler(grid_type const&                  grid,
                           typed_vertex_property_type const& prop)
       : m_grid{grid}, m_prop{prop} {}
   //--------------------------------------------------------------------------
+  vertex_property_sampler(vertex_property_sampler const& other)
+      : parent_type{other},
+        m_grid{other.m_grid},
+        m_prop{other.m_prop},
+        m_last_simplex{other.m_last_simplex.load(std::memory_order_relaxed)} {}
+  //--------------------------------------------------------------------------
   auto grid() const -> auto const& { return m_grid; }
   auto property() const -> auto const& { return m_prop; }
   //--------------------------------------------------------------------------
   [[nodiscard]] auto evaluate(pos_type const& x, real_type const /*t*/) const
       -> T {
+    if constexpr (SimplexDim == NumDimensions) {
+      if (m_grid.has_point_locator()) {
+        return evaluate_with_point_locator(
+            x,
+            std::make_index_sequence<grid_type::num_vertices_per_simplex()>{});
+      }
+    }
     return evaluate(
         x, std::make_index_sequence<grid_type::num_vertices_per_simplex()>{});
   }
   //--------------------------------------------------------------------------
+ private:
   template <std::size_t... VertexSeq>
-  [[nodiscard]] auto evaluate(pos_type const& x,
-                              std::index_sequence<VertexSeq...> /*seq*/) const
+  [[nodiscard]] auto evaluate_with_point_locator(
+      pos_type const& x, std::index_sequence<VertexSeq...> /*seq*/) const
       -> T {
-    auto simplex_handles = m_grid.hierarchy().nearby_simplices(x);
-    if (simplex_handles.empty()) {
+    using simplex_handle = typename grid_type::simplex_handle;
+    auto const location  = m_grid.point_locator().locate(
+        x, simplex_handle{m_last_simplex.load(std::memory_order_relaxed)});
+    if (!location) {
       return parent_type::ood_tensor();
     }
-    for (auto t : simplex_handles) {
+    m_last_simplex.store(location->simplex.index(), std::memory_order_relaxed);
+    auto const  vs = m_grid.simplex_at(location->simplex);
+    auto const& b  = location->barycentric_coordinates;
+    return ((m_prop[std::get<VertexSeq>(vs)] * b(VertexSeq)) + ...);
+  }
+  //--------------------------------------------------------------------------
+ public:
+  template <std::size_t... VertexSeq>
+  [[nodiscard]] auto evaluate(pos_type const& x,
+                              std::index_sequence<VertexSeq...> /*seq*/) const
+      -> T {
+    auto result = parent_type::ood_tensor();
+    m_grid.hierarchy().for_each_nearby_simplex(x, [&](auto const t) {
       auto const            vs = m_grid.simplex_at(t);
       static constexpr auto NV = grid_type::num_vertices_per_simplex();
       auto                  A  = mat<Real, NV, NV>::ones();
@@ -72,12 +105,14 @@ struct vertex_property_sampler
       Real const eps               = 1e-8;
       if (((barycentric_coord(VertexSeq) >= -eps) && ...) &&
           ((barycentric_coord(VertexSeq) <= 1 + eps) && ...)) {
-        return (
+        result = (
             (m_prop[std::get<VertexSeq>(vs)] * barycentric_coord(VertexSeq)) +
             ...);
+        return true;
       }
-    }
-    return parent_type::ood_tensor();
+      return false;
+    });
+    return result;
   }
 };
 //==============================================================================
@@ -0,0 +1,134 @@
+#ifndef TATOOINE_GEOMETRY_DETAIL_VERTEX_WELDER_H
+#define TATOOINE_GEOMETRY_DETAIL_VERTEX_WELDER_H
+//==============================================================================
+#include <tatooine/tensor.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+//==============================================================================
+namespace tatooine::detail {
+//==============================================================================
+/// Welds points that are equal up to a radius to common nodes.
+///
+/// Points are hashed into a uniform grid whose cells are a few radii wide. A
+/// point within radius of x can only lie in the cell of x or in the
+/// neighbouring cells whose borders are closer than radius to x. Usually a
+/// lookup therefore probes a single cell. Node indices are kept in an open
+/// addressing table with linear probing that is sized once for all points.
+template <typename Real, std::size_t NumDimensions>
+struct vertex_welder {
+  using pos_type  = vec<Real, NumDimensions>;
+  using cell_type = std::array<std::int64_t, NumDimensions>;
+  static auto constexpr empty = std::numeric_limits<std::size_t>::max();
+  //----------------------------------------------------------------------------
+ private:
+  Real                     m_radius;
+  pos_type                 m_origin;
+  Real                     m_cell_size;
+  // node indices, hashed by the cells of their positions
+  std::vector<std::size_t> m_slots;
+  std::size_t              m_mask;
+  std::vector<pos_type>    m_nodes;
+  //----------------------------------------------------------------------------
+ public:
+  /// \param min lower corner of all points that will be welded
+  /// \param max upper corner of all points that will be welded
+  /// \param num_points upper bound of the number of points that will be welded
+  vertex_welder(pos_type const& min, pos_type const& max, Real const radius,
+                std::size_t const num_points)
+      : m_radius{radius}, m_origin{min}, m_cell_size{4 * radius} {
+    auto extent = Real{};
+    for (std::size_t i = 0; i < NumDimensions; ++i) {
+      extent = std::max(extent, max(i) - min(i));
+    }
+    // keep cell indices far from overflowing
+    m_cell_size = std::max(m_cell_size, extent / Real(std::int64_t(1) << 40));
+    if (m_cell_size == 0) {
+      m_cell_size = 1;
+    }
+    auto num_slots = std::size_t(16);
+    while (num_slots < 2 * num_points) {
+      num_slots *= 2;
+    }
+    m_slots.resize(num_slots, empty);
+    m_mask = num_slots - 1;
+    m_nodes.reserve(num_points);
+  }
+  //----------------------------------------------------------------------------
+  auto num_nodes() const { return m_nodes.size(); }
+  auto nodes() const -> auto const& { return m_nodes; }
+  //----------------------------------------------------------------------------
+  /// \return index of the node x was welded to. A new node is created if no
+  /// existing node is within radius of x in every dimension.
+  auto node(pos_type const& x) -> std::size_t {
+    return node(x, [this](pos_type const& a, pos_type const& b) {
+      return approx_equal(a, b, m_radius);
+    });
+  }
+  //----------------------------------------------------------------------------
+  /// \param equal decides if x can be welded to an existing node. It must not
+  /// accept nodes that are farther than radius away in any dimension.
+  /// \return index of the node x was welded to. A new node is created if equal
+  /// accepts no existing node.
+  template <typename Equal>
+  auto node(pos_type const& x, Equal&& equal) -> std::size_t {
+    auto cell = cell_type{};
+    auto side = cell_type{};
+    for (std::size_t i = 0; i < NumDimensions; ++i) {
+      auto const c = (x(i) - m_origin(i)) / m_cell_size;
+      auto const f = std::floor(c);
+      cell[i]      = static_cast<std::int64_t>(f);
+      side[i]      = (c - f) * m_cell_size <= m_radius         ? -1
+                     : (f + 1 - c) * m_cell_size <= m_radius ? 1
+                                                             : 0;
+    }
+    for (std::size_t n = 0; n < (std::size_t(1) << NumDimensions); ++n) {
+      auto neighbor = cell;
+      auto probe    = true;
+      for (std::size_t i = 0; i < NumDimensions; ++i) {
+        if (n & (std::size_t(1) << i)) {
+          probe = probe && side[i] != 0;
+          neighbor[i] += side[i];
+        }
+      }
+      if (!probe) {
+        continue;
+      }
+      for (auto i = hash(neighbor); m_slots[i] != empty;
+           i      = (i + 1) & m_mask) {
+        if (equal(m_nodes[m_slots[i]], x)) {
+          return m_slots[i];
+        }
+      }
+    }
+    auto i = hash(cell);
+    while (m_slots[i] != empty) {
+      i = (i + 1) & m_mask;
+    }
+    m_slots[i] = m_nodes.size();
+    m_nodes.push_back(x);
+    return m_nodes.size() - 1;
+  }
+  //----------------------------------------------------------------------------
+ private:
+  auto hash(cell_type const& c) const {
+    auto h = std::size_t{};
+    for (auto const i : c) {
+      h ^= std::hash<std::int64_t>{}(i) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    }
+    // std::hash of integers is the identity so mix the bits before masking
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h & m_mask;
+  }
+};
+//==============================================================================
+}  // namespace tatooine::detail
+//==============================================================================
+#endif
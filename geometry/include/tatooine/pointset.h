@@ -21,8 +21,14 @@
 #include <tatooine/vtk/xml/reader.h>
 #include <tatooine/vtk_legacy.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fstream>
+#include <future>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 //==============================================================================
@@ -56,6 +62,10 @@ struct radial_basis_functions_sampler;
 template <floating_point Real, std::size_t NumDimensions, typename ValueType,
           typename GradientType>
 struct radial_basis_functions_sampler_with_gradients;
+//==============================================================================
+template <floating_point Real, std::size_t NumDimensions,
+          invocable<Real> Kernel>
+struct partition_of_unity_radial_basis_functions;
 #endif
 //==============================================================================
 template <floating_point Real, std::size_t NumDimensions>
@@ -118,8 +128,60 @@ struct pointset {
   std::set<vertex_handle>        m_invalid_vertices;
   vertex_property_container_type m_vertex_properties;
 #if TATOOINE_FLANN_AVAILABLE || defined(TATOOINE_DOC_ONLY)
-  mutable std::unique_ptr<flann_index_type> m_kd_tree;
-  mutable std::mutex                        m_flann_mutex;
+  /// Immutable kd-tree over a copy of the vertex positions that existed when
+  /// it was built. Owning the positions keeps the tree valid while vertices
+  /// are inserted.
+  struct kd_tree_type {
+    std::vector<pos_type>   positions;
+    std::set<vertex_handle> removed_vertices;
+    flann_index_type        index;
+    //--------------------------------------------------------------------------
+    kd_tree_type(std::vector<pos_type> ps, std::set<vertex_handle> removed)
+        : positions(std::move(ps)),
+          removed_vertices(std::move(removed)),
+          index{flann::Matrix<Real>{const_cast<Real *>(positions.front().data()),
+                                    positions.size(), num_dimensions()},
+                flann::KDTreeSingleIndexParams{}} {
+      index.buildIndex();
+      for (auto const v : removed_vertices) {
+        if (v.index() < positions.size()) {
+          index.removePoint(v.index());
+        }
+      }
+    }
+  };
+  /// Positions of the vertices that were inserted after a kd-tree had been
+  /// built. The storage never grows so that queries can read the first size
+  /// positions while new ones are appended.
+  struct kd_tree_delta_type {
+    std::unique_ptr<pos_type[]> positions;
+    std::size_t                 capacity;
+    std::atomic<std::size_t>    size = 0;
+    //--------------------------------------------------------------------------
+    explicit kd_tree_delta_type(std::size_t const c)
+        : positions{std::make_unique<pos_type[]>(c)}, capacity{c} {}
+    //--------------------------------------------------------------------------
+    /// Only called by the thread that holds m_flann_mutex.
+    auto push_back(pos_type const &x) {
+      auto const n = size.load(std::memory_order_relaxed);
+      positions[n] = x;
+      size.store(n + 1, std::memory_order_release);
+    }
+  };
+  /// Everything a query needs. Snapshots are replaced as a whole. The only
+  /// change to a published snapshot is appending to its delta.
+  struct kd_tree_snapshot_type {
+    std::shared_ptr<kd_tree_type const> tree;
+    std::shared_ptr<kd_tree_delta_type> delta;
+    /// Sorted indices of vertices that were removed after tree was built.
+    std::vector<std::size_t>            removed;
+  };
+  // Queries only load the current snapshot. Inserts append to its delta and
+  // removals publish a new snapshot until a background merge replaces the
+  // tree. Snapshots stay alive as long as a query uses them.
+  mutable std::atomic<std::shared_ptr<kd_tree_snapshot_type const>> m_kd_tree;
+  mutable std::future<std::shared_ptr<kd_tree_type const>> m_kd_tree_merge;
+  mutable std::mutex                                       m_flann_mutex;
 #endif
   //============================================================================
  public:
@@ -243,60 +305,46 @@ struct pointset {
   auto insert_vertex(arithmetic auto const... ts)
   requires(sizeof...(ts) == NumDimensions)
   {
-    m_vertex_position_data.push_back(pos_type{static_cast<Real>(ts)...});
+    auto const v_new = push_back_vertex_position(pos_type{static_cast<Real>(ts)...});
     for (auto &[key, prop] : vertex_properties()) {
       prop->push_back();
     }
-#if TATOOINE_FLANN_AVAILABLE
-    {
-      auto lock = std::scoped_lock{m_flann_mutex};
-      if (m_kd_tree != nullptr) {
-        m_kd_tree->addPoints(flann::Matrix<Real>{
-            const_cast<Real *>(m_vertex_position_data.back().data()), 1,
-            num_dimensions()});
-      }
-    }
-#endif
-    return vertex_handle{size(m_vertex_position_data) - 1};
+    return v_new;
   }
   //----------------------------------------------------------------------------
   auto insert_vertex(pos_type const &v) {
-    m_vertex_position_data.push_back(v);
+    auto const v_new = push_back_vertex_position(v);
     for (auto &[key, prop] : vertex_properties()) {
       prop->push_back();
     }
-#if TATOOINE_FLANN_AVAILABLE
-    {
-      auto lock = std::scoped_lock{m_flann_mutex};
-      if (m_kd_tree != nullptr) {
-        m_kd_tree->addPoints(flann::Matrix<Real>{
-            const_cast<Real *>(m_vertex_position_data.back().data()), 1,
-            num_dimensions()});
-      }
-    }
-#endif
-    return vertex_handle{size(m_vertex_position_data) - 1};
+    return v_new;
   }
   //----------------------------------------------------------------------------
   auto insert_vertex(pos_type &&v) {
-    m_vertex_position_data.emplace_back(std::move(v));
+    auto const v_new = push_back_vertex_position(std::move(v));
     for (auto &[key, prop] : vertex_properties()) {
       prop->push_back();
     }
+    return v_new;
+  }
+  ///\}
+  //----------------------------------------------------------------------------
+ private:
+  /// The kd-tree copies positions while holding m_flann_mutex so positions
+  /// are only appended while it is locked.
+  template <typename Pos>
+  auto push_back_vertex_position(Pos &&x) {
 #if TATOOINE_FLANN_AVAILABLE
-    {
-      auto lock = std::scoped_lock{m_flann_mutex};
-      if (m_kd_tree != nullptr) {
-        m_kd_tree->addPoints(flann::Matrix<Real>{
-            const_cast<Real *>(m_vertex_position_data.back().data()), 1,
-            num_dimensions()});
-      }
-    }
+    auto lock = std::scoped_lock{m_flann_mutex};
+    m_vertex_position_data.push_back(std::forward<Pos>(x));
+    add_to_kd_tree_delta(m_vertex_position_data.back());
+#else
+    m_vertex_position_data.push_back(std::forward<Pos>(x));
 #endif
     return vertex_handle{size(m_vertex_position_data) - 1};
   }
-  ///\}
   //----------------------------------------------------------------------------
+ public:
   /// tidies up invalid vertices
   auto tidy_up() {
     // auto decrement_counter = std::size_t{};
@@ -327,35 +375,38 @@ struct pointset {
     }
 
     m_invalid_vertices.clear();
+#if TATOOINE_FLANN_AVAILABLE
+    invalidate_kd_tree();
+#endif
   }
   //----------------------------------------------------------------------------
   auto remove(vertex_handle const v) {
-    if (is_valid(v) &&
-        std::ranges::find(invalid_vertices(), v) == end(invalid_vertices())) {
-      m_invalid_vertices.insert(v);
-    }
 #if TATOOINE_FLANN_AVAILABLE
-    {
-      auto lock = std::scoped_lock{m_flann_mutex};
-      if (m_kd_tree != nullptr) {
-        m_kd_tree->removePoint(v.index());
-      }
+    auto lock = std::scoped_lock{m_flann_mutex};
+#endif
+    if (!is_valid(v)) {
+      return;
     }
+    m_invalid_vertices.insert(v);
+#if TATOOINE_FLANN_AVAILABLE
+    remove_from_kd_tree(v);
 #endif
   }
   //----------------------------------------------------------------------------
   constexpr auto is_valid(vertex_handle const v) const -> bool {
-    return v.is_valid() &&
-           std::ranges::find(invalid_vertices(), v) == end(invalid_vertices());
+    return v.is_valid() && !m_invalid_vertices.contains(v);
   }
 
   //----------------------------------------------------------------------------
   auto clear_vertices() {
     m_vertex_position_data.clear();
     m_vertex_position_data.shrink_to_fit();
-    invalid_vertices().clear();
+    m_invalid_vertices.clear();
     for (auto &[key, val] : vertex_properties())
       val->clear();
+#if TATOOINE_FLANN_AVAILABLE
+    invalidate_kd_tree();
+#endif
   }
   auto clear() { clear_vertices(); }
   //============================================================================
@@ -1008,69 +1059,331 @@ struct pointset {
   /// \{
   auto rebuild_kd_tree() {
     invalidate_kd_tree();
-    build_kd_tree();
+    kd_tree_snapshot();
   }
-  auto build_kd_tree_index() {
+  /// Rebuilds the tree over all current vertices.
+  auto build_kd_tree_index() { freeze_kd_tree(); }
+  //----------------------------------------------------------------------------
+  /// Merges all vertices that were inserted or removed since the kd-tree was
+  /// built into the tree so that queries do not search a delta anymore. Waits
+  /// for a running background merge.
+  ///
+  /// Queries never lock and may run concurrently with inserting, removing and
+  /// freezing. tidy_up() and clear_vertices() change the indices of vertices
+  /// and must not run concurrently with queries.
+  auto freeze_kd_tree() const {
     auto lock = std::scoped_lock{m_flann_mutex};
-    if (m_kd_tree != nullptr) {
-      m_kd_tree->buildIndex();
+    if (m_kd_tree_merge.valid()) {
+      publish_kd_tree(m_kd_tree_merge.get());
+    }
+    auto const snapshot = m_kd_tree.load(std::memory_order_relaxed);
+    if (snapshot == nullptr ||
+        snapshot->delta->size.load(std::memory_order_relaxed) > 0 ||
+        !snapshot->removed.empty()) {
+      publish_kd_tree(make_kd_tree());
     }
   }
   //----------------------------------------------------------------------------
  private:
-  auto build_kd_tree() const -> auto & {
+  /// Builds the tree on the first query. Once it exists queries only need an
+  /// atomic load.
+  auto kd_tree_snapshot() const
+      -> std::shared_ptr<kd_tree_snapshot_type const> {
+    if (auto snapshot = m_kd_tree.load(std::memory_order_acquire);
+        snapshot != nullptr) {
+      return snapshot;
+    }
     auto lock = std::scoped_lock{m_flann_mutex};
-    if (m_kd_tree == nullptr && vertices().size() > 0) {
-      flann::Matrix<Real> dataset{
-          const_cast<Real *>(m_vertex_position_data.front().data()),
-          vertices().size(), num_dimensions()};
-      m_kd_tree = std::make_unique<flann_index_type>(
-          dataset, flann::KDTreeSingleIndexParams{});
-      m_kd_tree->buildIndex();
+    if (m_kd_tree.load(std::memory_order_relaxed) == nullptr) {
+      publish_kd_tree(make_kd_tree());
+    }
+    return m_kd_tree.load(std::memory_order_relaxed);
+  }
+  //----------------------------------------------------------------------------
+  /// Must be called with locked m_flann_mutex.
+  auto make_kd_tree() const -> std::shared_ptr<kd_tree_type const> {
+    if (m_vertex_position_data.empty()) {
+      return nullptr;
+    }
+    return std::make_shared<kd_tree_type const>(m_vertex_position_data,
+                                                m_invalid_vertices);
+  }
+  //----------------------------------------------------------------------------
+  static auto max_num_kd_tree_delta_vertices(kd_tree_type const &tree) {
+    return std::max<std::size_t>(256, tree.positions.size() / 8);
+  }
+  //----------------------------------------------------------------------------
+  /// Publishes a snapshot of tree whose delta holds all vertices the tree
+  /// does not know about.
+  ///
+  /// Must be called with locked m_flann_mutex.
+  auto publish_kd_tree(std::shared_ptr<kd_tree_type const> tree) const {
+    if (tree == nullptr) {
+      m_kd_tree.store(nullptr, std::memory_order_release);
+      return;
+    }
+    auto const num_delta_vertices =
+        m_vertex_position_data.size() - tree->positions.size();
+    auto snapshot  = std::make_shared<kd_tree_snapshot_type>();
+    snapshot->delta = std::make_shared<kd_tree_delta_type>(
+        2 * std::max(max_num_kd_tree_delta_vertices(*tree), num_delta_vertices));
+    for (auto i = tree->positions.size(); i < m_vertex_position_data.size();
+         ++i) {
+      snapshot->delta->push_back(m_vertex_position_data[i]);
+    }
+    for (auto const v : m_invalid_vertices) {
+      if (!tree->removed_vertices.contains(v)) {
+        snapshot->removed.push_back(v.index());
+      }
+    }
+    snapshot->tree = std::move(tree);
+    m_kd_tree.store(std::move(snapshot), std::memory_order_release);
+  }
+  //----------------------------------------------------------------------------
+  /// Swaps in a finished background merge.
+  ///
+  /// Must be called with locked m_flann_mutex.
+  auto publish_finished_kd_tree_merge() -> bool {
+    if (!m_kd_tree_merge.valid() ||
+        m_kd_tree_merge.wait_for(std::chrono::seconds{0}) !=
+            std::future_status::ready) {
+      return false;
+    }
+    publish_kd_tree(m_kd_tree_merge.get());
+    return true;
+  }
+  //----------------------------------------------------------------------------
+  /// Starts building a new tree if the delta or the number of removed
+  /// vertices has grown too large compared to the tree.
+  ///
+  /// Must be called with locked m_flann_mutex.
+  auto merge_kd_tree_delta_in_background(
+      kd_tree_snapshot_type const &snapshot) {
+    if (m_kd_tree_merge.valid() ||
+        snapshot.delta->size.load(std::memory_order_relaxed) +
+                snapshot.removed.size() <=
+            max_num_kd_tree_delta_vertices(*snapshot.tree)) {
+      return;
+    }
+    m_kd_tree_merge =
+        std::async(std::launch::async,
+                   [positions = m_vertex_position_data,
+                    removed   = m_invalid_vertices]() mutable {
+                     return std::make_shared<kd_tree_type const>(
+                         std::move(positions), std::move(removed));
+                   });
+  }
+  //----------------------------------------------------------------------------
+  /// Appends the last inserted vertex to the delta of the current snapshot.
+  ///
+  /// Must be called with locked m_flann_mutex.
+  auto add_to_kd_tree_delta(pos_type const &x) {
+    if (publish_finished_kd_tree_merge()) {
+      return;
+    }
+    auto snapshot = m_kd_tree.load(std::memory_order_relaxed);
+    if (snapshot == nullptr) {
+      return;
+    }
+    auto const &delta = *snapshot->delta;
+    if (delta.size.load(std::memory_order_relaxed) < delta.capacity) {
+      snapshot->delta->push_back(x);
+    } else {
+      // queries may still read the full delta so it is copied
+      auto grown   = std::make_shared<kd_tree_snapshot_type>(*snapshot);
+      grown->delta = std::make_shared<kd_tree_delta_type>(2 * delta.capacity);
+      for (std::size_t i = 0; i < delta.capacity; ++i) {
+        grown->delta->push_back(delta.positions[i]);
+      }
+      grown->delta->push_back(x);
+      m_kd_tree.store(grown, std::memory_order_release);
+      snapshot = std::move(grown);
     }
-    return m_kd_tree;
+    merge_kd_tree_delta_in_background(*snapshot);
+  }
+  //----------------------------------------------------------------------------
+  /// Must be called with locked m_flann_mutex after v has been inserted into
+  /// m_invalid_vertices.
+  auto remove_from_kd_tree(vertex_handle const v) {
+    if (publish_finished_kd_tree_merge()) {
+      return;
+    }
+    auto const snapshot = m_kd_tree.load(std::memory_order_relaxed);
+    if (snapshot == nullptr) {
+      return;
+    }
+    auto next = std::make_shared<kd_tree_snapshot_type>(*snapshot);
+    next->removed.insert(std::ranges::upper_bound(next->removed, v.index()),
+                         v.index());
+    m_kd_tree.store(next, std::memory_order_release);
+    merge_kd_tree_delta_in_background(*next);
+  }
+  //----------------------------------------------------------------------------
+  /// Erases vertices that were removed after the tree of snapshot had been
+  /// built from the result of a tree query and keeps at most max_size of the
+  /// others.
+  static auto erase_removed_kd_tree_vertices(
+      kd_tree_snapshot_type const &snapshot, std::vector<int> &indices,
+      std::vector<Real> &squared_distances,
+      std::size_t const  max_size = std::numeric_limits<std::size_t>::max()) {
+    if (!snapshot.removed.empty()) {
+      auto num_kept = std::size_t{};
+      for (std::size_t i = 0; i < indices.size(); ++i) {
+        if (!std::ranges::binary_search(snapshot.removed,
+                                        static_cast<std::size_t>(indices[i]))) {
+          indices[num_kept]           = indices[i];
+          squared_distances[num_kept] = squared_distances[i];
+          ++num_kept;
+        }
+      }
+      indices.resize(num_kept);
+      squared_distances.resize(num_kept);
+    }
+    if (indices.size() > max_size) {
+      indices.resize(max_size);
+      squared_distances.resize(max_size);
+    }
+  }
+  //----------------------------------------------------------------------------
+  /// Number of neighbors a tree query needs to find so that
+  /// num_nearest_neighbors are left after erasing removed vertices.
+  static auto num_kd_tree_neighbors(kd_tree_snapshot_type const &snapshot,
+                                    std::size_t const num_nearest_neighbors) {
+    return std::min(num_nearest_neighbors + snapshot.removed.size(),
+                    snapshot.tree->positions.size());
+  }
+  //----------------------------------------------------------------------------
+  /// Calls f with the index and position of every vertex in the delta of
+  /// snapshot that has not been removed.
+  static auto for_each_kd_tree_delta_vertex(
+      kd_tree_snapshot_type const &snapshot, auto &&f) {
+    auto const &delta  = *snapshot.delta;
+    auto const  offset = snapshot.tree->positions.size();
+    auto const  n      = delta.size.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < n; ++i) {
+      if (!std::ranges::binary_search(snapshot.removed, offset + i)) {
+        f(offset + i, delta.positions[i]);
+      }
+    }
+  }
+  //----------------------------------------------------------------------------
+  /// Adds the k nearest vertices of the delta of snapshot to the sorted
+  /// result of a tree query.
+  static auto add_kd_tree_delta_nearest_neighbors(
+      kd_tree_snapshot_type const &snapshot, pos_type const &x,
+      std::size_t const num_nearest_neighbors, std::vector<int> &indices,
+      std::vector<Real> &squared_distances) {
+    if (num_nearest_neighbors == 0) {
+      return;
+    }
+    for_each_kd_tree_delta_vertex(
+        snapshot, [&](std::size_t const i, pos_type const &y) {
+          auto const d = static_cast<Real>(squared_euclidean_distance(x, y));
+          if (indices.size() == num_nearest_neighbors &&
+              d >= squared_distances.back()) {
+            return;
+          }
+          auto const j = std::ranges::upper_bound(squared_distances, d) -
+                         begin(squared_distances);
+          squared_distances.insert(begin(squared_distances) + j, d);
+          indices.insert(begin(indices) + j, static_cast<int>(i));
+          if (indices.size() > num_nearest_neighbors) {
+            squared_distances.pop_back();
+            indices.pop_back();
+          }
+        });
+  }
+  //----------------------------------------------------------------------------
+  /// Adds the vertices of the delta of snapshot within radius to the result
+  /// of a tree query.
+  static auto add_kd_tree_delta_radius_neighbors(
+      kd_tree_snapshot_type const &snapshot, pos_type const &x,
+      Real const radius, bool const sorted, std::vector<int> &indices,
+      std::vector<Real> &squared_distances) {
+    for_each_kd_tree_delta_vertex(
+        snapshot, [&](std::size_t const i, pos_type const &y) {
+          auto const d = static_cast<Real>(squared_euclidean_distance(x, y));
+          if (d >= radius) {
+            return;
+          }
+          auto const j = sorted ? std::ranges::upper_bound(squared_distances,
+                                                           d) -
+                                      begin(squared_distances)
+                                : std::ranges::ssize(squared_distances);
+          squared_distances.insert(begin(squared_distances) + j, d);
+          indices.insert(begin(indices) + j, static_cast<int>(i));
+        });
   }
   //----------------------------------------------------------------------------
  public:
   //----------------------------------------------------------------------------
   auto invalidate_kd_tree() const {
     auto lock = std::scoped_lock{m_flann_mutex};
-    m_kd_tree.reset();
+    m_kd_tree_merge = {};
+    publish_kd_tree(nullptr);
   }
   //----------------------------------------------------------------------------
   auto nearest_neighbor(pos_type const &x) const {
-    auto &h = build_kd_tree();
-    if (h == nullptr) {
+    auto const [indices, distances] = nearest_neighbors_raw(x, 1);
+    if (indices.empty()) {
       return std::pair{vertex_handle::invalid(), Real(1) / Real(0)};
     }
-    auto qm =
-        flann::Matrix<Real>{const_cast<Real *>(x.data()), 1, num_dimensions()};
-    auto indices   = std::vector<std::vector<int>>{};
-    auto distances = std::vector<std::vector<Real>>{};
-    auto params    = flann::SearchParams{};
-    h->knnSearch(qm, indices, distances, 1, params);
-    return std::pair{
-        vertex_handle{static_cast<std::size_t>(indices.front().front())},
-        distances.front().front()};
+    return std::pair{vertex_handle{static_cast<std::size_t>(indices.front())},
+                     distances.front()};
   }
   //----------------------------------------------------------------------------
   /// Takes the raw output indices of flann without converting them into vertex
   /// handles.
   auto nearest_neighbors_raw(pos_type const           &x,
                              std::size_t const         num_nearest_neighbors,
-                             flann::SearchParams const params = {}) const {
-    auto &h = build_kd_tree();
-    if (h == nullptr) {
+                             flann::SearchParams const params = {}) const
+      -> std::pair<std::vector<int>, std::vector<Real>> {
+    auto const snapshot = kd_tree_snapshot();
+    if (snapshot == nullptr) {
       return std::pair{std::vector<int>{}, std::vector<Real>{}};
     }
     auto qm =
         flann::Matrix<Real>{const_cast<Real *>(x.data()), 1, num_dimensions()};
     auto indices   = std::vector<std::vector<int>>{};
     auto distances = std::vector<std::vector<Real>>{};
-    h->knnSearch(qm, indices, distances, num_nearest_neighbors, params);
+    snapshot->tree->index.knnSearch(
+        qm, indices, distances,
+        num_kd_tree_neighbors(*snapshot, num_nearest_neighbors), params);
+    erase_removed_kd_tree_vertices(*snapshot, indices.front(),
+                                   distances.front(), num_nearest_neighbors);
+    add_kd_tree_delta_nearest_neighbors(*snapshot, x, num_nearest_neighbors,
+                                        indices.front(), distances.front());
     return std::pair{std::move(indices.front()), std::move(distances.front())};
   }
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  /// Answers all queries with a single flann call. Set params.cores to let
+  /// flann distribute the queries over multiple threads.
+  auto nearest_neighbors_raw(std::vector<pos_type> const &xs,
+                             std::size_t const          num_nearest_neighbors,
+                             flann::SearchParams const  params = {}) const
+      -> std::pair<std::vector<std::vector<int>>,
+                   std::vector<std::vector<Real>>> {
+    auto indices   = std::vector<std::vector<int>>(xs.size());
+    auto distances = std::vector<std::vector<Real>>(xs.size());
+    auto const snapshot = kd_tree_snapshot();
+    if (snapshot == nullptr || xs.empty()) {
+      return std::pair{std::move(indices), std::move(distances)};
+    }
+    auto qm = flann::Matrix<Real>{const_cast<Real *>(xs.front().data()),
+                                  xs.size(), num_dimensions()};
+    snapshot->tree->index.knnSearch(
+        qm, indices, distances,
+        num_kd_tree_neighbors(*snapshot, num_nearest_neighbors), params);
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+      erase_removed_kd_tree_vertices(*snapshot, indices[i], distances[i],
+                                     num_nearest_neighbors);
+      add_kd_tree_delta_nearest_neighbors(*snapshot, xs[i],
+                                          num_nearest_neighbors, indices[i],
+                                          distances[i]);
+    }
+    return std::pair{std::move(indices), std::move(distances)};
+  }
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   auto nearest_neighbors(pos_type const   &x,
                          std::size_t const num_nearest_neighbors) const {
     auto [indices, distances] = nearest_neighbors_raw(x, num_nearest_neighbors);
@@ -1088,22 +1401,49 @@ struct pointset {
   auto nearest_neighbors_radius_raw(pos_type const &x, Real const radius,
                                     flann::SearchParams const params = {}) const
       -> std::pair<std::vector<int>, std::vector<Real>> {
-    auto &h = build_kd_tree();
-    if (h == nullptr) {
+    auto const snapshot = kd_tree_snapshot();
+    if (snapshot == nullptr) {
       return std::pair{std::vector<int>{}, std::vector<Real>{}};
     }
     flann::Matrix<Real>            qm{const_cast<Real *>(x.data()),  // NOLINT
                            1, num_dimensions()};
     std::vector<std::vector<int>>  indices;
     std::vector<std::vector<Real>> distances;
-    {
-      // auto lock = std::scoped_lock{m_flann_mutex};
-      h->radiusSearch(qm, indices, distances, static_cast<float>(radius),
-                      params);
-    }
+    snapshot->tree->index.radiusSearch(qm, indices, distances,
+                                       static_cast<float>(radius), params);
+    erase_removed_kd_tree_vertices(*snapshot, indices.front(),
+                                   distances.front());
+    add_kd_tree_delta_radius_neighbors(*snapshot, x, radius, params.sorted,
+                                       indices.front(), distances.front());
     return {std::move(indices.front()), std::move(distances.front())};
   }
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  /// Answers all queries with a single flann call. Set params.cores to let
+  /// flann distribute the queries over multiple threads.
+  auto nearest_neighbors_radius_raw(std::vector<pos_type> const &xs,
+                                    Real const                   radius,
+                                    flann::SearchParams const params = {}) const
+      -> std::pair<std::vector<std::vector<int>>,
+                   std::vector<std::vector<Real>>> {
+    auto indices   = std::vector<std::vector<int>>(xs.size());
+    auto distances = std::vector<std::vector<Real>>(xs.size());
+    auto const snapshot = kd_tree_snapshot();
+    if (snapshot == nullptr || xs.empty()) {
+      return std::pair{std::move(indices), std::move(distances)};
+    }
+    auto qm = flann::Matrix<Real>{const_cast<Real *>(xs.front().data()),
+                                  xs.size(), num_dimensions()};
+    snapshot->tree->index.radiusSearch(qm, indices, distances,
+                                       static_cast<float>(radius), params);
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+      erase_removed_kd_tree_vertices(*snapshot, indices[i], distances[i]);
+      add_kd_tree_delta_radius_neighbors(*snapshot, xs[i], radius,
+                                         params.sorted, indices[i],
+                                         distances[i]);
+    }
+    return std::pair{std::move(indices), std::move(distances)};
+  }
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   auto nearest_neighbors_radius(pos_type const &x, Real const radius) const {
     auto const [indices, distances] = nearest_neighbors_radius_raw(x, radius);
     auto handles = std::pair{std::vector<vertex_handle>(size(indices)),
@@ -1267,6 +1607,39 @@ struct pointset {
     return detail::pointset::radial_basis_functions_sampler_with_gradients{
         *this, values, gradients};
   }
+  //----------------------------------------------------------------------------
+  /// \brief Constructs a radial basis functions interpolation that scales to
+  /// large point clouds.
+  ///
+  /// Local radial basis functions systems are fit to overlapping patches and
+  /// blended with a partition of unity. The factorizations of the local
+  /// systems are reused by all samplers that are created with
+  /// partition_of_unity_radial_basis_functions::sampler.
+  ///
+  /// \param kernel Kernel function that gets the squared distance.
+  /// \param points_per_patch Approximate number of vertices per local system.
+  auto partition_of_unity_radial_basis_functions(
+      invocable<Real> auto &&kernel,
+      std::size_t const       points_per_patch = 64) const {
+    return detail::pointset::partition_of_unity_radial_basis_functions{
+        *this, std::forward<decltype(kernel)>(kernel), points_per_patch};
+  }
+  //----------------------------------------------------------------------------
+  /// \brief Constructs a partition of unity radial basis functions
+  /// interpolation with thin plate spline kernel.
+  auto partition_of_unity_radial_basis_functions(
+      std::size_t const points_per_patch = 64) const {
+    return partition_of_unity_radial_basis_functions(
+        thin_plate_spline_from_squared, points_per_patch);
+  }
+  //----------------------------------------------------------------------------
+  /// \brief Constructs a sampler of a partition of unity radial basis
+  /// functions interpolation with thin plate spline kernel.
+  template <typename T>
+  auto partition_of_unity_radial_basis_functions_sampler(
+      typed_vertex_property_type<T> const &prop) const {
+    return partition_of_unity_radial_basis_functions().sampler(prop);
+  }
 ///\}
 #endif
 //----------------------------------------------------------------------------
@@ -1310,6 +1683,7 @@ using pointset5 = Pointset<5>;
 #endif
 
 #if TATOOINE_BLAS_AND_LAPACK_AVAILABLE
+#include <tatooine/detail/pointset/partition_of_unity_radial_basis_functions_sampler.h>
 #include <tatooine/detail/pointset/radial_basis_functions_sampler.h>
 #include <tatooine/detail/pointset/radial_basis_functions_sampler_with_gradients.h>
 #endif
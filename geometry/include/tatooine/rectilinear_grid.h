@@ -27,9 +27,11 @@
 #include <tatooine/tuple.h>
 #include <tatooine/vec.h>
 
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <span>
 //==============================================================================
 namespace tatooine {
 //==============================================================================
@@ -84,10 +86,15 @@ private:
   property_container_type m_vertex_properties;
 
   using finite_difference_coefficents_list_type = std::vector<real_type>;
-  // finite difference finite_difference_coefficentss per size per dimension
-  mutable std::vector<
+  // finite difference finite_difference_coefficentss per size per dimension.
+  // A deque keeps the lists in place when tables for larger stencils are
+  // added so that references handed out stay valid.
+  mutable std::deque<
       std::array<finite_difference_coefficents_list_type, num_dimensions()>>
       m_finite_difference_coefficients = {};
+  // incremented whenever the finite difference tables are invalidated so that
+  // samplers know when to fetch them again
+  std::size_t m_finite_difference_coefficients_generation = 0;
   std::size_t m_chunk_size_for_lazy_properties = 2;
   //============================================================================
 public:
@@ -111,7 +118,9 @@ public:
       : m_dimensions{std::move(other.m_dimensions)},
         m_vertex_properties{std::move(other.m_vertex_properties)},
         m_finite_difference_coefficients{
-            std::move(other.m_finite_difference_coefficients)} {
+            std::move(other.m_finite_difference_coefficients)},
+        m_finite_difference_coefficients_generation{
+            other.m_finite_difference_coefficients_generation++} {
     for (auto const &[name, prop] : m_vertex_properties) {
       prop->set_grid(*this);
     }
@@ -179,6 +188,12 @@ public:
     m_vertex_properties = std::move(other.m_vertex_properties);
     m_finite_difference_coefficients =
         std::move(other.m_finite_difference_coefficients);
+    m_finite_difference_coefficients_generation =
+        std::max(m_finite_difference_coefficients_generation,
+                 other.m_finite_difference_coefficients_generation) +
+        1;
+    other.m_finite_difference_coefficients_generation =
+        m_finite_difference_coefficients_generation + 1;
     for (auto const &[name, prop] : m_vertex_properties) {
       prop->set_grid(*this);
     }
@@ -419,6 +434,11 @@ public:
   }
   //----------------------------------------------------------------------------
 private:
+  auto invalidate_finite_differences_coefficients() {
+    m_finite_difference_coefficients.clear();
+    ++m_finite_difference_coefficients_generation;
+  }
+  //----------------------------------------------------------------------------
   auto resize_vertex_properties() {
     for (auto &[name, prop] : vertex_properties()) {
       prop->resize(size());
@@ -430,14 +450,14 @@ public:
   ///
   template <std::size_t I>
   constexpr auto set_dimension(convertible_to<dimension_type<I>> auto &&dim) {
-    m_finite_difference_coefficients.clear();
+    invalidate_finite_differences_coefficients();
     m_dimensions.template at<I>() = std::forward<decltype(dim)>(dim);
     resize_vertex_properties();
   }
   //----------------------------------------------------------------------------
   /// Inserts new discrete point in dimension I with extent of last cell.
   template <std::size_t I> constexpr auto push_back() {
-    m_finite_difference_coefficients.clear();
+    invalidate_finite_differences_coefficients();
     auto &dim = m_dimensions.template at<I>();
     if constexpr (is_linspace<std::decay_t<decltype(dim)>>) {
       dim.push_back();
@@ -451,7 +471,7 @@ public:
   template <std::size_t I>
     requires requires(dimension_type<I> dim) { dim.pop_back(); }
   constexpr auto pop_back() {
-    m_finite_difference_coefficients.clear();
+    invalidate_finite_differences_coefficients();
     m_dimensions.template at<I>().pop_back();
     resize_vertex_properties();
   }
@@ -460,7 +480,7 @@ public:
   template <std::size_t I>
     requires requires(dimension_type<I> dim) { dim.pop_back(); }
   constexpr auto pop_front() {
-    m_finite_difference_coefficients.clear();
+    invalidate_finite_differences_coefficients();
     m_dimensions.template at<I>().pop_front();
     resize_vertex_properties();
   }
@@ -580,17 +600,33 @@ public:
         unpack(std::forward<decltype(xs)>(xs)));
   }
   //----------------------------------------------------------------------------
+  /// Finite difference coefficients of the first derivative of all vertices
+  /// of dimension dim_index. The coefficients of vertex i are stored at
+  /// [i * stencil_size, (i + 1) * stencil_size).
+  ///
+  /// The returned list stays valid until the dimensions of the grid change so
+  /// that it can be read without locking. Such changes increment
+  /// finite_differences_coefficients_generation().
+  auto finite_differences_coefficients_table(std::size_t const stencil_size,
+                                             std::size_t const dim_index) const
+      -> finite_difference_coefficents_list_type const & {
+    auto lock = std::lock_guard{m_finite_difference_coefficients_mutex};
+    if (stencil_size > m_finite_difference_coefficients.size() ||
+        m_finite_difference_coefficients[stencil_size - 1][dim_index].empty()) {
+      create_finite_differences_coefficients(stencil_size);
+    }
+    return m_finite_difference_coefficients[stencil_size - 1][dim_index];
+  }
+  //----------------------------------------------------------------------------
+  auto finite_differences_coefficients_generation() const {
+    return m_finite_difference_coefficients_generation;
+  }
+  //----------------------------------------------------------------------------
   auto finite_differences_coefficients(std::size_t const stencil_size,
                                        std::size_t const dim_index,
                                        std::size_t const i) const {
-    {
-      auto lock = std::lock_guard{m_finite_difference_coefficients_mutex};
-      if (stencil_size > m_finite_difference_coefficients.size()) {
-        create_finite_differences_coefficients(stencil_size);
-      }
-    }
     auto beg =
-        begin(m_finite_difference_coefficients[stencil_size - 1][dim_index]);
+        begin(finite_differences_coefficients_table(stencil_size, dim_index));
     return std::ranges::subrange{beg + stencil_size * i,
                                  beg + stencil_size * (i + 1)};
   }
@@ -612,6 +648,12 @@ public:
     auto local_positions = std::vector<real_type>(stencil_size);
 
     auto foreach_dim = [&, dim_idx = std::size_t{}](auto const &dim) mutable {
+      // dimensions that are too small for the stencil or already have their
+      // coefficients are skipped
+      if (stencil_size > dim.size() || !stencil_per_size[dim_idx].empty()) {
+        ++dim_idx;
+        return;
+      }
       auto stencil_begin = begin(dim);
       auto stencil_end = next(begin(dim), stencil_size);
       assert(stencil_size <= dim.size());
@@ -999,14 +1041,18 @@ public:
     return prop;
   }
   //----------------------------------------------------------------------------
+  /// access_properties can be used to enlarge the raw data chunk cache of
+  /// HDF5 so that chunks of compressed datasets are not decompressed more than
+  /// once per lazily loaded chunk.
   template <typename T, typename GlobalIndexOrder = x_fastest,
             typename LocalIndexOrder = GlobalIndexOrder>
-  auto insert_hdf5_lazy_vertex_property(filesystem::path const &path,
-                                        std::string const &dataset_name)
+  auto insert_hdf5_lazy_vertex_property(
+      filesystem::path const &path, std::string const &dataset_name,
+      hdf5::property_list const &access_properties = hdf5::property_list{})
       -> auto & {
     hdf5::file f{path};
     return insert_lazy_vertex_property<GlobalIndexOrder, LocalIndexOrder>(
-        f.dataset<T>(dataset_name));
+        f.dataset<T>(dataset_name, access_properties));
   }
   //----------------------------------------------------------------------------
   template <typename GlobalIndexOrder = x_fastest,
@@ -1074,6 +1120,18 @@ public:
   }
 #endif
   //============================================================================
+private:
+  /// Fields that can evaluate spans of positions at once.
+  template <typename F>
+  static auto constexpr is_batch_evaluable = requires(
+      F const &f, std::span<pos_type const> xs,
+      std::span<typename F::real_type const> ts,
+      std::span<typename F::tensor_type>     vs) {
+    requires same_as<typename F::pos_type, pos_type>;
+    f.evaluate(xs, ts, vs);
+  };
+  //----------------------------------------------------------------------------
+public:
   template <typename F>
     requires invocable_with_n_integrals<F, num_dimensions()> ||
              invocable<F, pos_type>
@@ -1098,6 +1156,75 @@ public:
     }
   }
   //----------------------------------------------------------------------------
+  /// Samples a field that supports batched evaluation such as any
+  /// polymorphic::field at time t. Positions are evaluated in blocks with one
+  /// call per block instead of one virtual call per vertex.
+  template <typename F>
+    requires is_batch_evaluable<F>
+  auto sample_to_vertex_property(F const &f, std::string const &name,
+                                 arithmetic auto const         t,
+                                 execution_policy_tag auto tag) -> auto & {
+    using field_real_type = typename F::real_type;
+    using tensor_type     = typename F::tensor_type;
+    static auto constexpr block_size = std::size_t(1) << 12;
+    auto &prop = vertex_property<tensor_type>(name);
+
+    auto const num_vertices = vertices().size();
+    auto const time         = static_cast<field_real_type>(t);
+    auto const num_blocks   = (num_vertices + block_size - 1) / block_size;
+    for_loop(
+        [&](std::size_t const b) {
+          auto const first = b * block_size;
+          auto const n     = std::min(block_size, num_vertices - first);
+          // x-fastest indices of the first vertex of the block
+          auto is = std::array<std::size_t, num_dimensions()>{};
+          for (std::size_t d = 0, rest = first; d < num_dimensions(); ++d) {
+            is[d] = rest % size(d);
+            rest /= size(d);
+          }
+          auto const next = [&] {
+            for (std::size_t d = 0; d < num_dimensions(); ++d) {
+              if (++is[d] < size(d)) {
+                return;
+              }
+              is[d] = 0;
+            }
+          };
+          auto const first_is = is;
+          auto       xs       = std::vector<pos_type>(n);
+          auto       vs       = std::vector<tensor_type>(n);
+          for (auto &x : xs) {
+            x = vertex_at(is);
+            next();
+          }
+          try {
+            f.evaluate(std::span<pos_type const>{xs}, std::span{&time, 1},
+                       std::span{vs});
+          } catch (std::exception &) {
+            // only the vertices that fail become NaN
+            for (std::size_t i = 0; i < n; ++i) {
+              try {
+                vs[i] = f(xs[i], time);
+              } catch (std::exception &) {
+                if constexpr (tensor_num_components<tensor_type> == 1) {
+                  vs[i] = tensor_type{nan<tensor_type>()};
+                } else {
+                  vs[i] =
+                      tensor_type::fill(nan<tatooine::value_type<tensor_type>>());
+                }
+              }
+            }
+          }
+          is = first_is;
+          for (auto const &v : vs) {
+            prop(is) = v;
+            next();
+          }
+        },
+        tag, num_blocks);
+    return prop;
+  }
+  //----------------------------------------------------------------------------
 private:
   template <invocable_with_n_integrals<num_dimensions()> F, std::size_t... Is>
   auto sample_to_vertex_property_indices(F &&f, std::string const &name,
@@ -1125,6 +1252,19 @@ private:
   template <invocable<pos_type> F>
   auto sample_to_vertex_property_pos(F &&f, std::string const &name,
                                      execution_policy_tag auto tag) -> auto & {
+    if constexpr (is_batch_evaluable<std::decay_t<F>>) {
+      // fields evaluated without time are sampled at time 0
+      return sample_to_vertex_property(f, name, 0, tag);
+    } else {
+      return sample_to_vertex_property_pos_single(std::forward<F>(f), name,
+                                                  tag);
+    }
+  }
+  //----------------------------------------------------------------------------
+  template <invocable<pos_type> F>
+  auto sample_to_vertex_property_pos_single(F &&f, std::string const &name,
+                                            execution_policy_tag auto tag)
+      -> auto & {
     using invoke_result = std::decay_t<std::invoke_result_t<F, pos_type>>;
     auto &prop = vertex_property<invoke_result>(name);
     vertices().iterate_indices(
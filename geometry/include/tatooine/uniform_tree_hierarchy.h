@@ -5,6 +5,7 @@
 #include <tatooine/for_loop.h>
 #include <tatooine/math.h>
 
+#include <concepts>
 #include <set>
 #include <vector>
 //==============================================================================
@@ -330,6 +331,33 @@ struct uniform_tree_hierarchy<
     collect_nearby_simplices(pos, simplices);
     return simplices;
   }
+  //----------------------------------------------------------------------------
+  /// Calls f with every simplex of the leaves that contain pos without
+  /// collecting them first. Simplices overlapping several of these leaves are
+  /// visited more than once.
+  /// \param f returns true to stop the traversal
+  /// \return true if f stopped the traversal
+  template <std::predicate<simplex_handle> F>
+  auto for_each_nearby_simplex(vec<Real, NumDims> const& pos, F&& f) const
+      -> bool {
+    if (!is_inside(pos)) {
+      return false;
+    }
+    if (is_splitted()) {
+      for (auto const& child : children()) {
+        if (child->for_each_nearby_simplex(pos, f)) {
+          return true;
+        }
+      }
+      return false;
+    }
+    for (auto const s : m_simplex_handles) {
+      if (f(s)) {
+        return true;
+      }
+    }
+    return false;
+  }
 };
 //==============================================================================
 template <typename Real, std::size_t NumDimensions, std::size_t SimplexDim>
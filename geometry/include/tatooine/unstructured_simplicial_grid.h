@@ -15,6 +15,7 @@
 #include <tatooine/detail/unstructured_simplicial_grid/tetrahedral_vtu_writer.h>
 #include <tatooine/detail/unstructured_simplicial_grid/triangular_vtp_writer.h>
 #include <tatooine/detail/unstructured_simplicial_grid/triangular_vtu_writer.h>
+#include <tatooine/detail/vertex_welder.h>
 #include <tatooine/pointset.h>
 #include <tatooine/property.h>
 #include <tatooine/rectilinear_grid.h>
@@ -23,7 +24,10 @@
 
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/algorithm/copy.hpp>
+#include <cmath>
 #include <filesystem>
+#include <limits>
+#include <numeric>
 #include <vector>
 //==============================================================================
 namespace tatooine::detail::unstructured_simplicial_grid {
@@ -40,6 +44,10 @@ template <typename Mesh, floating_point Real, std::size_t NumDimensions,
           std::size_t SimplexDim>
 struct parent;
 //==============================================================================
+template <floating_point Real, std::size_t NumDimensions,
+          std::size_t SimplexDim>
+struct point_locator;
+//==============================================================================
 }  // namespace tatooine::detail::unstructured_simplicial_grid
 //==============================================================================
 namespace tatooine {
@@ -81,6 +89,9 @@ struct unstructured_simplicial_grid
   using typed_vertex_property_type =
       typename parent_type::template typed_vertex_property_type<T>;
   using hierarchy_type = typename parent_type::hierarchy_type;
+  using point_locator_type =
+      detail::unstructured_simplicial_grid::point_locator<Real, NumDimensions,
+                                                          SimplexDim>;
   static constexpr auto num_vertices_per_simplex() { return SimplexDim + 1; }
   static constexpr auto simplex_dimension() { return SimplexDim; }
   //----------------------------------------------------------------------------
@@ -104,6 +115,7 @@ struct unstructured_simplicial_grid
   std::set<simplex_handle>                m_invalid_simplices;
   simplex_property_container_type         m_simplex_properties;
   mutable std::unique_ptr<hierarchy_type> m_hierarchy;
+  mutable std::unique_ptr<point_locator_type> m_point_locator;
 
  public:
   //============================================================================
@@ -112,6 +124,7 @@ struct unstructured_simplicial_grid
   auto simplex_index_data() const -> auto const& {
     return m_simplex_index_data;
   }
+  auto simplex_index_data() -> auto& { return m_simplex_index_data; }
   auto invalid_simplices() const -> auto const& { return m_invalid_simplices; }
   auto simplex_properties() const -> auto const& {
     return m_simplex_properties;
@@ -373,54 +386,82 @@ struct unstructured_simplicial_grid
             simplex_contains_vertex);
   }
   //----------------------------------------------------------------------------
+  /// Welds vertices whose squared distance is at most eps. Simplices that
+  /// reference a duplicate are redirected to the first vertex of its cluster
+  /// and the duplicates are marked as removed. Call tidy_up to compact
+  /// vertices and vertex properties afterwards.
   auto remove_duplicate_vertices(Real const eps = Real{}) {
     remove_duplicate_vertices(execution_policy::parallel, eps);
   }
   //----------------------------------------------------------------------------
   auto remove_duplicate_vertices(execution_policy::parallel_t /*policy*/,
                                  Real const eps = Real{}) {
-    auto m = std::mutex{};
-    for (auto v0 = vertices().cbegin(); v0 != vertices().cend(); ++v0) {
-#pragma omp parallel for
-      for (auto v1 = next(v0); v1 != vertices().cend(); ++v1) {
-        auto const d = squared_euclidean_distance(at(*v0), at(*v1));
-        if (d <= eps) {
-          for (std::size_t is = 0; is < m_simplex_index_data.size();
-               is += num_vertices_per_simplex()) {
-            for (std::size_t ivs = 0; ivs < num_vertices_per_simplex(); ++ivs) {
-              if (m_simplex_index_data[is + ivs] == *v1) {
-                m_simplex_index_data[is + ivs] = *v0;
-              }
-            }
-          }
-          auto l = std::lock_guard{m};
-          parent_type::remove(*v1);
-        }
-      }
-    }
+#if TATOOINE_PARALLEL_FOR_LOOPS_AVAILABLE
+    weld_duplicate_vertices(execution_policy::parallel, eps);
+#else
+    weld_duplicate_vertices(execution_policy::sequential, eps);
+#endif
   }
   //----------------------------------------------------------------------------
-  auto remove_duplicate_vertices(execution_policy::sequential_t /*policy*/,
+  auto remove_duplicate_vertices(execution_policy::sequential_t policy,
                                  Real const eps = Real{}) {
-    // auto const& data = this->m_vertex_position_data;
-    for (auto v0 = vertices().cbegin(); v0 != vertices().cend(); ++v0) {
-      for (auto v1 = next(v0); v1 != vertices().cend(); ++v1) {
-        auto const d = squared_euclidean_distance(at(*v0), at(*v1));
-        if (d <= eps) {
-          for (std::size_t is = 0; is < m_simplex_index_data.size();
-               is += num_vertices_per_simplex()) {
-            for (std::size_t ivs = 0; ivs < num_vertices_per_simplex(); ++ivs) {
-              if (m_simplex_index_data[is + ivs] == *v1) {
-                m_simplex_index_data[is + ivs] = *v0;
-              }
-            }
-          }
-          parent_type::remove(*v1);
-        }
+    weld_duplicate_vertices(policy, eps);
+  }
+  //----------------------------------------------------------------------------
+ private:
+  /// Clusters vertices with a spatial hash in a single pass and rewrites the
+  /// simplex index data once with the resulting remapping table.
+  auto weld_duplicate_vertices(execution_policy_tag auto const policy,
+                               Real const eps) -> void {
+    auto const num_vertex_handles = vertex_position_data().size();
+    if (vertices().size() < 2) {
+      return;
+    }
+    auto min = pos_type::fill(std::numeric_limits<Real>::max());
+    auto max = pos_type::fill(std::numeric_limits<Real>::lowest());
+    for (auto const v : vertices()) {
+      for (std::size_t i = 0; i < NumDimensions; ++i) {
+        min(i) = std::min(min(i), at(v)(i));
+        max(i) = std::max(max(i), at(v)(i));
       }
     }
+    auto welder = detail::vertex_welder<Real, NumDimensions>{
+        min, max, std::sqrt(eps), vertices().size()};
+    auto const is_duplicate = [eps](pos_type const& x, pos_type const& y) {
+      return squared_euclidean_distance(x, y) <= eps;
+    };
+    // first vertex of every cluster
+    auto representatives = std::vector<vertex_handle>{};
+    auto duplicates      = std::vector<vertex_handle>{};
+    auto remapping       = std::vector<vertex_handle>(num_vertex_handles);
+    for (std::size_t i = 0; i < num_vertex_handles; ++i) {
+      remapping[i] = vertex_handle{i};
+    }
+    for (auto const v : vertices()) {
+      auto const node = welder.node(at(v), is_duplicate);
+      if (node == representatives.size()) {
+        representatives.push_back(v);
+      } else {
+        remapping[v.index()] = representatives[node];
+        duplicates.push_back(v);
+      }
+    }
+    if (duplicates.empty()) {
+      return;
+    }
+    for_loop(
+        [&](std::size_t const i) {
+          auto& v = m_simplex_index_data[i];
+          v       = remapping[v.index()];
+        },
+        policy, m_simplex_index_data.size());
+    for (auto const v : duplicates) {
+      parent_type::remove(v);
+    }
   }
   //----------------------------------------------------------------------------
+ public:
+  //----------------------------------------------------------------------------
   auto remove(simplex_handle const ch) { m_invalid_simplices.insert(ch); }
   //----------------------------------------------------------------------------
   template <typename... Handles>
@@ -477,13 +518,22 @@ struct unstructured_simplicial_grid
   //----------------------------------------------------------------------------
   /// tidies up invalid vertices
  private:
-  auto reindex_simplices_vertex_handles() {
-    auto inc     = [](auto i) { return ++i; };
+  /// \return number of invalid vertices with an index less than or equal to
+  /// the index of each vertex handle
+  auto invalid_vertex_offsets() const {
     auto offsets = std::vector<std::size_t>(size(vertex_position_data()), 0);
     for (auto const v : invalid_vertices()) {
-      auto i = begin(offsets) + v.index();
-      std::ranges::transform(i, end(offsets), i, inc);
+      ++offsets[v.index()];
     }
+    std::partial_sum(begin(offsets), end(offsets), begin(offsets));
+    return offsets;
+  }
+  //----------------------------------------------------------------------------
+  auto reindex_simplices_vertex_handles() {
+    if (invalid_vertices().empty()) {
+      return;
+    }
+    auto const offsets = invalid_vertex_offsets();
     for (auto& i : m_simplex_index_data) {
       i -= offsets[i.index()];
     }
@@ -532,12 +582,7 @@ struct unstructured_simplicial_grid
       }
     }
 
-    auto constexpr inc = [](auto i) { return ++i; };
-    auto offsets = std::vector<std::size_t>(size(vertex_position_data()), 0);
-    for (auto const v : invalid_vertices()) {
-      auto i = begin(offsets) + v.index();
-      std::ranges::transform(i, end(offsets), i, inc);
-    }
+    auto const offsets = invalid_vertex_offsets();
     for (auto& i : indices) {
       i -= offsets[i.index()];
     }
@@ -1183,29 +1228,45 @@ struct unstructured_simplicial_grid
            end(m_invalid_simplices);
   }
   //----------------------------------------------------------------------------
+  /// Builds the bounding volume hierarchy of all simplices. It must be rebuilt
+  /// after the grid changed.
   auto build_hierarchy() const {
-    clear_hierarchy();
-    auto& h = hierarchy();
-    if constexpr (is_uniform_tree_hierarchy<hierarchy_type>()) {
-      for (auto v : vertices()) {
-        h.insert_vertex(v);
-      }
-      for (auto c : simplices()) {
-        h.insert_simplex(c);
-      }
-    }
+    m_hierarchy = std::make_unique<hierarchy_type>(*this);
   }
   //----------------------------------------------------------------------------
   auto clear_hierarchy() const { m_hierarchy.reset(); }
   //----------------------------------------------------------------------------
-  auto hierarchy() const -> auto& {
+  auto hierarchy() const -> auto const& {
     if (m_hierarchy == nullptr) {
-      auto const bb = bounding_box();
-      m_hierarchy = std::make_unique<hierarchy_type>(bb.min(), bb.max(), *this);
+      build_hierarchy();
     }
     return *m_hierarchy;
   }
   //----------------------------------------------------------------------------
+  /// Builds the point locator that vertex property samplers use to walk from
+  /// their last hit simplex to the queried position. It also builds the
+  /// hierarchy the walk falls back to. Both must be rebuilt after the grid
+  /// changed.
+  auto build_point_locator() const
+  requires(SimplexDim == NumDimensions)
+  {
+    build_hierarchy();
+    m_point_locator = std::make_unique<point_locator_type>(*this);
+  }
+  //----------------------------------------------------------------------------
+  auto clear_point_locator() const { m_point_locator.reset(); }
+  //----------------------------------------------------------------------------
+  auto has_point_locator() const { return m_point_locator != nullptr; }
+  //----------------------------------------------------------------------------
+  auto point_locator() const -> auto const&
+  requires(SimplexDim == NumDimensions)
+  {
+    if (m_point_locator == nullptr) {
+      build_point_locator();
+    }
+    return *m_point_locator;
+  }
+  //----------------------------------------------------------------------------
   template <typename T>
   auto sampler(typed_vertex_property_type<T> const& prop) const {
     if (m_hierarchy == nullptr) {
@@ -1359,6 +1420,7 @@ static constexpr inline auto constrained_delaunay_available(
 }  // namespace tatooine
 //==============================================================================
 #include <tatooine/detail/unstructured_simplicial_grid/parent.h>
+#include <tatooine/detail/unstructured_simplicial_grid/point_locator.h>
 #include <tatooine/detail/unstructured_simplicial_grid/simplex_container.h>
 #include <tatooine/detail/unstructured_simplicial_grid/vertex_property_sampler.h>
 //==============================================================================
@@ -4,12 +4,15 @@
 #include <tatooine/type_traits.h>
 #include <tatooine/vtk/xml/data_type.h>
 #include <tatooine/vtk/xml/format.h>
+#include <tatooine/vtk/xml/unaligned_view.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <cstring>
 #include <limits>
 #include <rapidxml.hpp>
+#include <span>
 #include <string>
 #include <vector>
 //==============================================================================
@@ -119,7 +122,26 @@ struct data_array {
     }
   }
   //----------------------------------------------------------------------------
+  /// Refers to raw appended data directly inside the memory-mapped file
+  /// without copying it. Appended arrays usually start at unaligned offsets so
+  /// the view copies single elements on access. unaligned_view::aligned()
+  /// gives a std::span if the data happens to be aligned. Returns nothing if
+  /// the data is not raw appended data, is compressed or does not have type T.
+  /// read() can be used in these cases.
+  template <typename T>
+  auto view() const -> std::optional<unaligned_view<T>> {
+    if (format() != xml::format::appended || to_data_type<T>() != type() ||
+        is_compressed()) {
+      return std::nullopt;
+    }
+    return unaligned_view<T>{appended_data()};
+  }
+  //----------------------------------------------------------------------------
+  [[nodiscard]] auto is_compressed() const -> bool;
+  //----------------------------------------------------------------------------
  private:
+  auto appended_data() const -> std::span<std::byte const>;
+  //----------------------------------------------------------------------------
   template <typename T>
   auto read_data_ascii() const {
     throw std::runtime_error{"[vtk::xml::data_array] cannot read ascii"};
@@ -2,6 +2,7 @@
 #define TATOOINE_VTK_XML_READER_H
 //==============================================================================
 #include <tatooine/filesystem.h>
+#include <tatooine/memory_mapped_file.h>
 #include <tatooine/parse.h>
 #include <tatooine/vtk/xml/byte_order.h>
 #include <tatooine/vtk/xml/image_data.h>
@@ -12,29 +13,35 @@
 #include <tatooine/vtk/xml/vtk_type.h>
 
 #include <array>
+#include <cstddef>
 #include <cstring>
-#include <fstream>
 #include <optional>
 #include <rapidxml.hpp>
-#include <sstream>
+#include <span>
 #include <string>
 #include <vector>
 //==============================================================================
 namespace tatooine::vtk::xml {
 //==============================================================================
+/// Parses the XML header of a VTK XML file. The file is memory-mapped and
+/// appended binary data is only touched when a data_array is read.
 struct reader {
   //==============================================================================
   // MEMBERS
   //==============================================================================
  private:
-  vtk_type                 m_type        = vtk_type::unknown;
-  xml::byte_order          m_byte_order  = byte_order::unknown;
-  xml::data_type           m_header_type = data_type::unknown;
-  std::string              m_version     = "";
-  filesystem::path         m_path        = {};
-  mutable std::ifstream    m_file;
+  vtk_type                 m_type               = vtk_type::unknown;
+  xml::byte_order          m_byte_order         = byte_order::unknown;
+  xml::data_type           m_header_type        = data_type::uint32;
+  bool                     m_is_zlib_compressed = false;
+  std::string              m_version            = "";
+  filesystem::path         m_path               = {};
+  memory_mapped_file       m_file;
+  // XML part of the file without the appended data. rapidxml parses in situ so
+  // this has to live as long as m_doc.
+  std::string              m_xml;
   rapidxml::xml_document<> m_doc;
-  std::size_t              m_begin_appended_data = {};
+  std::size_t              m_begin_appended_data = std::string::npos;
 
   std::optional<xml::image_data>        m_image_data;
   std::optional<xml::rectilinear_grid>  m_rectilinear_grid;
@@ -51,33 +58,43 @@ struct reader {
   auto structured_grid() const -> auto const& { return m_structured_grid; }
   auto poly_data() const -> auto const& { return m_poly_data; }
   auto unstructured_grid() const -> auto const& { return m_unstructured_grid; }
+  auto header_type() const { return m_header_type; }
+  /// Appended data blocks are compressed with vtkZLibDataCompressor.
+  auto is_zlib_compressed() const { return m_is_zlib_compressed; }
   auto file() const -> auto const& { return m_file; }
-  auto file() -> auto& { return m_file; }
   auto xml_document() const -> auto const& { return m_doc; }
   auto xml_document() -> auto& { return m_doc; }
 
-  /// Returns number of bytes of the following data block.
+  /// Returns number of bytes of the following data block. For compressed
+  /// data this is the number of uncompressed bytes.
   auto read_appended_data_size(std::size_t offset) const -> std::size_t;
   /// Reads the data block that follows the size of the actual data block.
   /// num_bytes needs to be retrieved from read_appended_data_size method.
+  /// Compressed blocks are decompressed in parallel.
   auto read_appended_data(char* data, std::size_t num_bytes,
                           std::size_t offset) const -> void;
+  /// Bytes of an uncompressed appended data block inside the mapped file.
+  /// Empty for compressed data.
+  auto appended_data(std::size_t offset) const -> std::span<std::byte const>;
 
   //==============================================================================
   // CTORS
   //==============================================================================
   reader(filesystem::path const& path);
-  ~reader() { m_file.close(); }
-  //==============================================================================
-  // STATIC METHODS
-  //==============================================================================
-  /// The binary appended data part needs to be extracted in order to make
-  /// rapidxml read the file.
-  auto extract_appended_data(std::string& content) -> void;
+  reader(reader const&)                    = delete;
+  auto operator=(reader const&) -> reader& = delete;
   //==============================================================================
   // METHODS
   //==============================================================================
+  /// The binary appended data part needs to be excluded in order to make
+  /// rapidxml read the file. Only the remaining XML is copied into m_xml.
+  auto extract_xml() -> void;
   auto read_meta() -> void;
+
+ private:
+  auto read_header_value(std::size_t pos) const -> std::size_t;
+  auto read_compressed_appended_data(char* data, std::size_t num_bytes,
+                                     std::size_t offset) const -> void;
 };
 //==============================================================================
 }  // namespace tatooine::vtk::xml
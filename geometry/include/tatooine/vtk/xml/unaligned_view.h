@@ -0,0 +1,118 @@
+#ifndef TATOOINE_GEOMETRY_VTK_XML_UNALIGNED_VIEW_H
+#define TATOOINE_GEOMETRY_VTK_XML_UNALIGNED_VIEW_H
+//==============================================================================
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <type_traits>
+//==============================================================================
+namespace tatooine::vtk::xml {
+//==============================================================================
+/// Read-only view of values of type T stored at a possibly unaligned address.
+/// Elements are returned by value and copied with std::memcpy which compiles
+/// to a plain load on platforms that support unaligned access.
+template <typename T>
+struct unaligned_view {
+  static_assert(std::is_trivially_copyable_v<T>);
+  using value_type = T;
+  //============================================================================
+  struct iterator {
+    using value_type        = T;
+    using difference_type   = std::ptrdiff_t;
+    using iterator_category = std::input_iterator_tag;
+    using iterator_concept  = std::random_access_iterator_tag;
+
+    std::byte const* m_pos = nullptr;
+    //--------------------------------------------------------------------------
+    auto operator*() const { return load(m_pos); }
+    auto operator[](difference_type const n) const { return *(*this + n); }
+    //--------------------------------------------------------------------------
+    auto operator++() -> iterator& {
+      m_pos += sizeof(T);
+      return *this;
+    }
+    auto operator++(int) {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+    auto operator--() -> iterator& {
+      m_pos -= sizeof(T);
+      return *this;
+    }
+    auto operator--(int) {
+      auto copy = *this;
+      --*this;
+      return copy;
+    }
+    auto operator+=(difference_type const n) -> iterator& {
+      m_pos += n * static_cast<difference_type>(sizeof(T));
+      return *this;
+    }
+    auto operator-=(difference_type const n) -> iterator& {
+      return *this += -n;
+    }
+    //--------------------------------------------------------------------------
+    friend auto operator+(iterator it, difference_type const n) {
+      return it += n;
+    }
+    friend auto operator+(difference_type const n, iterator it) {
+      return it += n;
+    }
+    friend auto operator-(iterator it, difference_type const n) {
+      return it -= n;
+    }
+    friend auto operator-(iterator const& lhs, iterator const& rhs)
+        -> difference_type {
+      return (lhs.m_pos - rhs.m_pos) /
+             static_cast<difference_type>(sizeof(T));
+    }
+    //--------------------------------------------------------------------------
+    auto operator==(iterator const&) const -> bool  = default;
+    auto operator<=>(iterator const&) const         = default;
+  };
+  //============================================================================
+ private:
+  std::span<std::byte const> m_bytes;
+  //============================================================================
+  static auto load(std::byte const* pos) {
+    auto t = T{};
+    std::memcpy(&t, pos, sizeof(T));
+    return t;
+  }
+  //============================================================================
+ public:
+  explicit unaligned_view(std::span<std::byte const> const bytes)
+      : m_bytes{bytes.first(bytes.size() / sizeof(T) * sizeof(T))} {}
+  //----------------------------------------------------------------------------
+  auto size() const { return m_bytes.size() / sizeof(T); }
+  auto empty() const { return m_bytes.empty(); }
+  auto bytes() const { return m_bytes; }
+  //----------------------------------------------------------------------------
+  auto operator[](std::size_t const i) const {
+    return load(m_bytes.data() + i * sizeof(T));
+  }
+  //----------------------------------------------------------------------------
+  auto begin() const { return iterator{m_bytes.data()}; }
+  auto end() const { return iterator{m_bytes.data() + m_bytes.size()}; }
+  //----------------------------------------------------------------------------
+  auto is_aligned() const {
+    return reinterpret_cast<std::uintptr_t>(m_bytes.data()) % alignof(T) == 0;
+  }
+  //----------------------------------------------------------------------------
+  /// Reinterprets the bytes as a span of T if they are suitably aligned.
+  auto aligned() const -> std::optional<std::span<T const>> {
+    if (!is_aligned()) {
+      return std::nullopt;
+    }
+    return std::span{reinterpret_cast<T const*>(m_bytes.data()), size()};
+  }
+};
+//==============================================================================
+}  // namespace tatooine::vtk::xml
+//==============================================================================
+#endif
@@ -3,6 +3,7 @@
 //==============================================================================
 #include <tatooine/concepts.h>
 #include <tatooine/filesystem.h>
+#include <tatooine/memory_mapped_file.h>
 #include <tatooine/parse.h>
 #include <tatooine/swap_endianess.h>
 #include <tatooine/tensor.h>
@@ -10,15 +11,27 @@
 #include <tatooine/type_traits.h>
 #include <tatooine/vtk/cell_type.h>
 
+#if TATOOINE_OPENMP_AVAILABLE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <charconv>
 #include <cstdlib>
+#include <cstring>
 #include <exception>
 #include <fstream>
 #include <future>
 #include <iostream>
 #include <istream>
 #include <map>
+#include <numeric>
 #include <sstream>
+#include <stdexcept>
+#include <string_view>
 #include <vector>
 //=============================================================================
 namespace tatooine::vtk {
@@ -181,269 +194,313 @@ struct legacy_file_listener {
                               ) -> void {}
 };
 //------------------------------------------------------------------------------
+/// Cursor over the content of a legacy VTK file.
+///
+/// ASCII numbers are parsed with std::from_chars. Large ASCII blocks can be
+/// split into chunks at whitespace that are parsed in parallel.
+class legacy_file_tokenizer {
+  std::string_view m_content;
+  std::size_t      m_pos = 0;
+
+ public:
+  /// Minimal number of ASCII values that are parsed in parallel.
+  static constexpr std::size_t parallel_threshold = 1 << 16;
+  //----------------------------------------------------------------------------
+  explicit legacy_file_tokenizer(std::string_view content)
+      : m_content{content} {}
+  //----------------------------------------------------------------------------
+  auto eof() const { return m_pos >= m_content.size(); }
+  auto position() const { return m_pos; }
+  auto seek(std::size_t const pos) { m_pos = std::min(pos, m_content.size()); }
+  //----------------------------------------------------------------------------
+  static constexpr auto is_whitespace(char const c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' ||
+           c == '\f';
+  }
+  //----------------------------------------------------------------------------
+  auto skip_whitespace() -> void;
+  /// Skips leading whitespace and returns the next word. The word is empty at
+  /// the end of the content.
+  auto read_word() -> std::string_view;
+  /// Returns the rest of the current line. The cursor stays in front of the
+  /// line break.
+  auto read_line() -> std::string_view;
+  /// Skips the rest of the current line including the line break. Binary
+  /// blocks start right after the line break of their header.
+  auto skip_line() -> void;
+  //----------------------------------------------------------------------------
+  template <typename T>
+  auto read_number() -> T {
+    return parse_number<T>(read_word());
+  }
+  //----------------------------------------------------------------------------
+  template <typename T>
+  auto read_ascii(T *data, std::size_t const n, bool const in_parallel)
+      -> void {
+#if TATOOINE_OPENMP_AVAILABLE
+    if (in_parallel && n >= parallel_threshold && omp_get_max_threads() > 1) {
+      read_ascii_in_parallel(data, n);
+      return;
+    }
+#else
+    static_cast<void>(in_parallel);
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+      data[i] = read_number<T>();
+    }
+  }
+  //----------------------------------------------------------------------------
+  /// Copies n big endian values and converts them to the native byte order.
+  template <typename T>
+  auto read_big_endian(T *data, std::size_t const n) -> void {
+    auto const num_bytes = sizeof(T) * n;
+    if (m_pos + num_bytes > m_content.size()) {
+      throw std::runtime_error{
+          "[tatooine::vtk::legacy_file] binary data is truncated."};
+    }
+    std::memcpy(data, m_content.data() + m_pos, num_bytes);
+    m_pos += num_bytes;
+    if constexpr (std::endian::native == std::endian::little) {
+      swap_endianess(data, n);
+    }
+  }
+  //----------------------------------------------------------------------------
+  template <typename T>
+  static auto parse_number(std::string_view const word) -> T {
+    auto const *first = word.data();
+    auto const *last  = word.data() + word.size();
+    if (first != last && *first == '+') {
+      ++first;
+    }
+    auto value           = T{};
+    auto const [ptr, ec] = std::from_chars(first, last, value);
+    if (ec != std::errc{} || ptr != last) {
+      throw std::runtime_error{"[tatooine::vtk::legacy_file] could not parse \"" +
+                               std::string{word} + "\" as a number."};
+    }
+    return value;
+  }
+  //----------------------------------------------------------------------------
+ private:
+  auto skip_word() -> void;
+  //----------------------------------------------------------------------------
+#if TATOOINE_OPENMP_AVAILABLE
+  /// Finds the end of the n values, splits them into one chunk per thread at
+  /// whitespace, counts the values of each chunk and parses the chunks in
+  /// parallel.
+  template <typename T>
+  auto read_ascii_in_parallel(T *data, std::size_t const n) -> void {
+    skip_whitespace();
+    auto const begin = m_pos;
+    for (std::size_t i = 0; i < n; ++i) {
+      skip_whitespace();
+      if (eof()) {
+        throw std::runtime_error{
+            "[tatooine::vtk::legacy_file] ASCII data is truncated."};
+      }
+      skip_word();
+    }
+    auto const end = m_pos;
+
+    auto const num_chunks = static_cast<std::size_t>(omp_get_max_threads());
+    auto chunk_begins     = std::vector<std::size_t>(num_chunks + 1, begin);
+    chunk_begins.back()   = end;
+    for (std::size_t c = 1; c < num_chunks; ++c) {
+      auto pos = std::max(chunk_begins[c - 1],
+                          begin + (end - begin) * c / num_chunks);
+      while (pos < end && !is_whitespace(m_content[pos])) {
+        ++pos;
+      }
+      chunk_begins[c] = pos;
+    }
+
+    // first index of each chunk
+    auto chunk_offsets = std::vector<std::size_t>(num_chunks + 1, 0);
+#pragma omp parallel for
+    for (std::size_t c = 0; c < num_chunks; ++c) {
+      auto num_words = std::size_t{};
+      auto prev_is_whitespace = true;
+      for (auto pos = chunk_begins[c]; pos < chunk_begins[c + 1]; ++pos) {
+        auto const cur_is_whitespace = is_whitespace(m_content[pos]);
+        if (prev_is_whitespace && !cur_is_whitespace) {
+          ++num_words;
+        }
+        prev_is_whitespace = cur_is_whitespace;
+      }
+      chunk_offsets[c + 1] = num_words;
+    }
+    std::partial_sum(chunk_offsets.begin(), chunk_offsets.end(),
+                     chunk_offsets.begin());
+
+    auto failed = std::atomic_bool{false};
+#pragma omp parallel for
+    for (std::size_t c = 0; c < num_chunks; ++c) {
+      auto chunk = legacy_file_tokenizer{m_content.substr(
+          chunk_begins[c], chunk_begins[c + 1] - chunk_begins[c])};
+      try {
+        for (auto i = chunk_offsets[c]; i < chunk_offsets[c + 1]; ++i) {
+          data[i] = chunk.read_number<T>();
+        }
+      } catch (...) {
+        failed = true;
+      }
+    }
+    if (failed) {
+      throw std::runtime_error{
+          "[tatooine::vtk::legacy_file] could not parse ASCII data."};
+    }
+  }
+#endif
+};
+//------------------------------------------------------------------------------
 class legacy_file {
   std::vector<legacy_file_listener *> m_listeners;
 
-  filesystem::path        m_path;
-  format                  m_format;
-  reader_data             m_data = reader_data::unknown;
-  std::size_t             m_data_size{};  // cell_data or point_data size
-  std::ifstream::pos_type m_begin_of_data{};
-  char                    buffer[256]{};
+  filesystem::path m_path;
+  format           m_format            = format::unknown;
+  reader_data      m_data              = reader_data::unknown;
+  std::size_t      m_data_size         = 0;  // cell_data or point_data size
+  bool             m_parse_in_parallel = true;
 
  public:
   auto add_listener(legacy_file_listener &listener) -> void;
   //---------------------------------------------------------------------------
   legacy_file(filesystem::path path);
   //---------------------------------------------------------------------------
+  /// Maps the file into memory and notifies all listeners.
   auto read() -> void;
   //---------------------------------------------------------------------------
   auto set_path(filesystem::path const &path) -> void { m_path = path; }
   auto set_path(filesystem::path &&path) -> void { m_path = std::move(path); }
   auto path() const -> auto const & { return m_path; }
   //---------------------------------------------------------------------------
+  /// If set large ASCII blocks are parsed with all OpenMP threads.
+  auto parse_in_parallel() const { return m_parse_in_parallel; }
+  auto parse_in_parallel(bool const p) -> void { m_parse_in_parallel = p; }
+  //---------------------------------------------------------------------------
  private:
-  auto read_header() -> void;
-  auto read_data() -> void;
+  auto read_header(legacy_file_tokenizer &file) -> void;
+  auto read_data(legacy_file_tokenizer &file) -> void;
 
-  auto read_spacing(std::ifstream &file) -> void;
-  auto read_dimensions(std::ifstream &file) -> void;
-  auto read_origin(std::ifstream &file) -> void;
+  auto read_spacing(legacy_file_tokenizer &file) -> void;
+  auto read_dimensions(legacy_file_tokenizer &file) -> void;
+  auto read_origin(legacy_file_tokenizer &file) -> void;
 
-  auto read_points(std::ifstream &file) -> void;
-  template <typename Real>
-  auto read_points_ascii(std::ifstream &file, std::size_t const n) -> void;
+  auto read_points(legacy_file_tokenizer &file) -> void;
   template <typename Real>
-  auto read_points_binary(std::ifstream &file, std::size_t const n) -> void;
+  auto read_points(legacy_file_tokenizer &file, std::size_t const n) -> void;
 
-  auto read_cell_types(std::ifstream &file) -> void;
-  auto read_cell_types_ascii(std::ifstream &file, std::size_t const n) -> void;
-  auto read_cell_types_binary(std::ifstream &file, std::size_t const n) -> void;
+  auto read_cell_types(legacy_file_tokenizer &file) -> void;
 
-  auto        read_indices(std::ifstream &file) -> std::vector<int>;
-  static auto read_indices_ascii(std::ifstream &file, std::size_t const size)
-      -> std::vector<int>;
-  static auto read_indices_binary(std::ifstream &file, std::size_t const size)
-      -> std::vector<int>;
+  auto read_indices(legacy_file_tokenizer &file) -> std::vector<int>;
 
-  auto read_scalars_header(std::ifstream &file);
-  auto read_scalars(std::ifstream &file) -> void;
+  auto read_scalars_header(legacy_file_tokenizer &file);
+  auto read_scalars(legacy_file_tokenizer &file) -> void;
   template <typename Real>
-  auto read_scalars_ascii(std::ifstream &file, std::string const &name,
-                          std::string const &lookup_table,
-                          std::size_t const  num_comps) -> void;
-  template <typename Real>
-  auto read_scalars_binary(std::ifstream &file, std::string const &name,
-                           std::string const &lookup_table,
-                           std::size_t const  num_comps) -> void;
+  auto read_scalars(legacy_file_tokenizer &file, std::string const &name,
+                    std::string const &lookup_table,
+                    std::size_t const  num_comps) -> void;
 
-  auto read_data_header(std::ifstream &file);
-  template <typename Real, std::size_t N>
-  auto read_data(std::ifstream &file) -> std::vector<std::array<Real, N>>;
+  auto read_data_header(legacy_file_tokenizer &file);
   template <typename Real, std::size_t N>
-  auto read_data_ascii(std::ifstream &file) -> std::vector<std::array<Real, N>>;
-  template <typename Real, std::size_t N>
-  auto read_data_binary(std::ifstream &file)
+  auto read_data(legacy_file_tokenizer &file)
       -> std::vector<std::array<Real, N>>;
   //----------------------------------------------------------------------------
   // coordinates
-  auto read_coordinates_header(std::ifstream &file);
-  template <typename Real>
-  auto read_coordinates(std::ifstream &file, std::size_t n);
-  template <typename Real>
-  auto read_coordinates_ascii(std::ifstream &file, std::size_t n)
-      -> std::vector<Real>;
+  auto read_coordinates_header(legacy_file_tokenizer &file);
   template <typename Real>
-  auto read_coordinates_binary(std::ifstream &file, std::size_t n)
+  auto read_coordinates(legacy_file_tokenizer &file, std::size_t n)
       -> std::vector<Real>;
   //----------------------------------------------------------------------------
-  auto read_x_coordinates(std::ifstream &file) -> void;
-  auto read_y_coordinates(std::ifstream &file) -> void;
-  auto read_z_coordinates(std::ifstream &file) -> void;
+  auto read_x_coordinates(legacy_file_tokenizer &file) -> void;
+  auto read_y_coordinates(legacy_file_tokenizer &file) -> void;
+  auto read_z_coordinates(legacy_file_tokenizer &file) -> void;
   //----------------------------------------------------------------------------
   // index data
-  auto read_cells(std::ifstream &file) -> void;
-  auto read_vertices(std::ifstream &file) -> void;
-  auto read_lines(std::ifstream &file) -> void;
-  auto read_polygons(std::ifstream &file) -> void;
-  auto read_triangle_strips(std::ifstream &file) -> void;
+  auto read_cells(legacy_file_tokenizer &file) -> void;
+  auto read_vertices(legacy_file_tokenizer &file) -> void;
+  auto read_lines(legacy_file_tokenizer &file) -> void;
+  auto read_polygons(legacy_file_tokenizer &file) -> void;
+  auto read_triangle_strips(legacy_file_tokenizer &file) -> void;
   //----------------------------------------------------------------------------
   // fixed size data
-  auto read_vectors(std::ifstream &file) -> void;
-  auto read_normals(std::ifstream &file) -> void;
-  auto read_texture_coordinates(std::ifstream &file) -> void;
-  auto read_tensors(std::ifstream &file) -> void;
-  auto read_field_header(std::ifstream &file)
+  auto read_vectors(legacy_file_tokenizer &file) -> void;
+  auto read_normals(legacy_file_tokenizer &file) -> void;
+  auto read_texture_coordinates(legacy_file_tokenizer &file) -> void;
+  auto read_tensors(legacy_file_tokenizer &file) -> void;
+  auto read_field_header(legacy_file_tokenizer &file)
       -> std::pair<std::string, std::size_t>;
   //----------------------------------------------------------------------------
   // field data
-  auto read_field_array_header(std::ifstream &file)
+  auto read_field_array_header(legacy_file_tokenizer &file)
       -> std::tuple<std::string, std::size_t, std::size_t, std::string>;
-  auto read_field(std::ifstream &file) -> void;
-
-  template <typename Real>
-  auto read_field_array_binary(std::ifstream &file, std::size_t num_comps,
-                               std::size_t num_tuples) -> std::vector<Real>;
+  auto read_field(legacy_file_tokenizer &file) -> void;
   template <typename Real>
-  auto read_field_array_ascii(std::ifstream &file, std::size_t num_comps,
-                              std::size_t num_tuples) -> std::vector<Real>;
-
-  static auto consume_trailing_break(std::ifstream &file) -> void;
+  auto read_field_array(legacy_file_tokenizer &file, std::size_t num_comps,
+                        std::size_t num_tuples) -> std::vector<Real>;
+  //----------------------------------------------------------------------------
+  /// Reads n ASCII or big endian binary values depending on the format of the
+  /// file.
+  template <typename T>
+  auto read_values(legacy_file_tokenizer &file, T *data, std::size_t const n)
+      -> void {
+    if (m_format == format::ascii) {
+      file.read_ascii(data, n, m_parse_in_parallel);
+    } else {
+      file.skip_line();
+      file.read_big_endian(data, n);
+    }
+  }
 };
 //------------------------------------------------------------------------------
 template <typename Real>
-auto legacy_file::read_points_ascii(std::ifstream &file, std::size_t const n)
+auto legacy_file::read_points(legacy_file_tokenizer &file, std::size_t const n)
     -> void {
-  std::vector<std::array<Real, 3>> points;
-  for (std::size_t i = 0; i < n; i++)
-    points.push_back(
-        {{static_cast<Real>(parse<Real>(vtk::read_word(file, buffer))),
-          static_cast<Real>(parse<Real>(vtk::read_word(file, buffer))),
-          static_cast<Real>(parse<Real>(vtk::read_word(file, buffer)))}});
-
-  for (auto l : m_listeners)
+  auto points = std::vector<std::array<Real, 3>>(n);
+  read_values(file, reinterpret_cast<Real *>(points.data()), 3 * n);
+  for (auto l : m_listeners) {
     l->on_points(points);
-}
-//-----------------------------------------------------------------------------
-template <typename Real>
-auto legacy_file::read_points_binary(std::ifstream &file, std::size_t const n)
-    -> void {
-  std::vector<std::array<Real, 3>> points(n);
-  if (n > 0) {
-    file.read((char *)points.data(),
-              static_cast<std::streamsize>(sizeof(Real) * 3 * n));
-    swap_endianess(reinterpret_cast<Real *>(points.data()), n * 3);
-    for (auto l : m_listeners)
-      l->on_points(points);
-    consume_trailing_break(file);
   }
-  // file.ignore(sizeof(Real) * 3 * n + 1);
 }
 //------------------------------------------------------------------------------
-template <typename Real, std::size_t n>
-auto legacy_file::read_data(std::ifstream &file)
-    -> std::vector<std::array<Real, n>> {
-  if (m_format == format::ascii)
-    return read_data_ascii<Real, n>(file);
-  else
-    return read_data_binary<Real, n>(file);
-}
-//-----------------------------------------------------------------------------
-template <typename Real, std::size_t n>
-auto legacy_file::read_data_ascii(std::ifstream &file)
-    -> std::vector<std::array<Real, n>> {
-  std::vector<std::array<Real, n>> data(m_data_size);
-  for (std::size_t i = 0; i < m_data_size; i++)
-    for (std::size_t j = 0; j < n; j++)
-      data[i][n] = parse<Real>(vtk::read_word(file, buffer));
-  return data;
-}
-//-----------------------------------------------------------------------------
-template <typename Real, std::size_t n>
-auto legacy_file::read_data_binary(std::ifstream &file)
-    -> std::vector<std::array<Real, n>> {
-  auto data = std::vector<std::array<Real, n>>(m_data_size);
-  file.read((char *)data.data(),
-            static_cast<std::streamsize>(sizeof(Real) * m_data_size * n));
-  swap_endianess(reinterpret_cast<Real *>(data.data()), n * m_data_size);
-  consume_trailing_break(file);
+template <typename Real, std::size_t N>
+auto legacy_file::read_data(legacy_file_tokenizer &file)
+    -> std::vector<std::array<Real, N>> {
+  auto data = std::vector<std::array<Real, N>>(m_data_size);
+  read_values(file, reinterpret_cast<Real *>(data.data()), N * m_data_size);
   return data;
 }
 //------------------------------------------------------------------------------
 template <typename Real>
-auto legacy_file::read_coordinates(std::ifstream &file, std::size_t n) {
-  if (m_format == format::ascii)
-    return read_coordinates_ascii<Real>(file, n);
-
-  else /*if (m_format == format::binary)*/
-    return read_coordinates_binary<Real>(file, n);
-}
-//------------------------------------------------------------------------------
-template <typename Real>
-auto legacy_file::read_coordinates_ascii(std::ifstream    &file,
-                                         std::size_t const n)
-    -> std::vector<Real> {
-  std::vector<Real> coordinates(n);
-  for (std::size_t i = 0; i < n; i++)
-    coordinates[i] = parse<Real>(vtk::read_word(file, buffer));
-  return coordinates;
-}
-//------------------------------------------------------------------------------
-template <typename Real>
-auto legacy_file::read_coordinates_binary(std::ifstream    &file,
-                                          std::size_t const n)
+auto legacy_file::read_coordinates(legacy_file_tokenizer &file,
+                                   std::size_t const      n)
     -> std::vector<Real> {
   auto coordinates = std::vector<Real>(n);
-  file.read((char *)coordinates.data(),
-            static_cast<std::streamsize>(sizeof(Real) * n));
-  swap_endianess(coordinates);
-  consume_trailing_break(file);
+  read_values(file, coordinates.data(), n);
   return coordinates;
 }
 //------------------------------------------------------------------------------
 template <typename Real>
-auto legacy_file::read_field_array_binary(std::ifstream &file,
-                                          std::size_t    num_comps,
-                                          std::size_t    num_tuples)
+auto legacy_file::read_field_array(legacy_file_tokenizer &file,
+                                   std::size_t const      num_comps,
+                                   std::size_t const      num_tuples)
     -> std::vector<Real> {
   auto data = std::vector<Real>(num_comps * num_tuples);
-  file.read((char *)data.data(), static_cast<std::streamsize>(
-                                     sizeof(Real) * num_comps * num_tuples));
-  swap_endianess(data);
-
-  // consume trailing \n
-  auto consumer = char{};
-  file.read(&consumer, sizeof(char));
-
+  read_values(file, data.data(), data.size());
   return data;
 }
 //------------------------------------------------------------------------------
 template <typename Real>
-auto legacy_file::read_field_array_ascii(std::ifstream &file,
-                                         std::size_t    num_comps,
-                                         std::size_t    num_tuples)
-    -> std::vector<Real> {
-  std::vector<Real> data;
-  data.reserve(num_comps * num_tuples);
-  for (std::size_t i = 0; i < num_comps * num_tuples; i++)
-    data.push_back(parse<Real>(vtk::read_word(file, buffer)));
-
-  return data;
-}
-//-----------------------------------------------------------------------------
-template <typename Real>
-auto legacy_file::read_scalars_ascii(std::ifstream     &file,
-                                     std::string const &name,
-                                     std::string const &lookup_table,
-                                     std::size_t const  num_comps) -> void {
-  std::vector<Real> scalars;
-  scalars.reserve(m_data_size * num_comps);
-  std::string val_str;
-  for (std::size_t i = 0; i < m_data_size * num_comps; i++) {
-    scalars.push_back(parse<Real>(vtk::read_word(file, buffer)));
-  }
+auto legacy_file::read_scalars(legacy_file_tokenizer &file,
+                               std::string const     &name,
+                               std::string const     &lookup_table,
+                               std::size_t const      num_comps) -> void {
+  auto scalars = std::vector<Real>(m_data_size * num_comps);
+  read_values(file, scalars.data(), scalars.size());
   for (auto l : m_listeners) {
     l->on_scalars(name, lookup_table, num_comps, scalars, m_data);
   }
 }
-//-----------------------------------------------------------------------------
-template <typename Real>
-auto legacy_file::read_scalars_binary(std::ifstream     &file,
-                                      std::string const &name,
-                                      std::string const &lookup_table,
-                                      std::size_t const  num_comps) -> void {
-  if (m_data_size > 0) {
-    auto data = std::vector<Real>(m_data_size * num_comps);
-    file.read((char *)data.data(), static_cast<std::streamsize>(
-                                       sizeof(Real) * m_data_size * num_comps));
-    swap_endianess(data);
-
-    consume_trailing_break(file);
-    for (auto l : m_listeners) {
-      l->on_scalars(name, lookup_table, num_comps, data, m_data);
-    }
-  }
-}
 //------------------------------------------------------------------------------
 class legacy_file_writer {
  private:
@@ -28,6 +28,14 @@ auto data_array::read_appended_data(char* data, std::size_t num_bytes) const
 auto data_array::read_appended_data_size() const -> std::size_t {
   return m_reader->read_appended_data_size(m_offset);
 }
+//------------------------------------------------------------------------------
+auto data_array::appended_data() const -> std::span<std::byte const> {
+  return m_reader->appended_data(m_offset);
+}
+//------------------------------------------------------------------------------
+auto data_array::is_compressed() const -> bool {
+  return m_format == xml::format::appended && m_reader->is_zlib_compressed();
+}
 //==============================================================================
 }  // namespace tatooine::vtk::xml
 //==============================================================================
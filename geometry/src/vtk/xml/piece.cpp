@@ -51,8 +51,9 @@ piece::piece(reader& r, rapidxml::xml_node<>* node) {
 auto piece::read_data_array_set(reader& r, rapidxml::xml_node<>* node,
                                 std::map<std::string, data_array>& set)
     -> void {
-  for (auto* data_array_node = node->first_node(); data_array_node != nullptr;
-       data_array_node       = data_array_node->next_sibling()) {
+  for (auto* data_array_node = node->first_node("DataArray");
+       data_array_node != nullptr;
+       data_array_node = data_array_node->next_sibling("DataArray")) {
     auto da = data_array{r, data_array_node};
     set.insert(std::pair{*da.name(), da});
   }
@@ -61,7 +62,7 @@ auto piece::read_data_array_set(reader& r, rapidxml::xml_node<>* node,
 auto piece::read_points(reader& r, rapidxml::xml_node<>* node) -> void {
   auto const points_node = node->first_node("Points");
   if (points_node != nullptr) {
-    points = data_array{r, points_node->first_node()};
+    points = data_array{r, points_node->first_node("DataArray")};
   }
 }
 //------------------------------------------------------------------------------
@@ -4,8 +4,8 @@
 namespace tatooine::vtk::xml {
 //==============================================================================
 piece_set::piece_set(reader& r, rapidxml::xml_node<>* node) {
-  for (auto* piece_node = node->first_node(); piece_node != nullptr;
-       piece_node       = piece_node->next_sibling()) {
+  for (auto* piece_node = node->first_node("Piece"); piece_node != nullptr;
+       piece_node       = piece_node->next_sibling("Piece")) {
     pieces.emplace_back(r, piece_node);
   }
 }
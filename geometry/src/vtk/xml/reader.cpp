@@ -1,4 +1,13 @@
 #include <tatooine/vtk/xml/reader.h>
+
+#if TATOOINE_ZLIB_AVAILABLE
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string_view>
 //==============================================================================
 namespace tatooine::vtk::xml {
 //==============================================================================
@@ -7,35 +16,37 @@ reader::reader(filesystem::path const& path) : m_path{path}, m_file{m_path} {
   if (!m_file.is_open()) {
     return;
   }
-  auto content = [&] {
-    auto buffer = std::stringstream{};
-    buffer << m_file.rdbuf();
-    return buffer.str();
-  }();
-  extract_appended_data(content);
+  extract_xml();
   // start parsing
-  m_doc.parse<0>(content.data());
+  m_doc.parse<0>(m_xml.data());
   read_meta();
 }
 //------------------------------------------------------------------------------
-auto reader::extract_appended_data(std::string& content) -> void {
+auto reader::extract_xml() -> void {
   static constexpr std::string_view opening_appended_data = "<AppendedData";
   static constexpr std::string_view closing_appended_data = "</AppendedData>";
+  auto const content = m_file.as_string_view();
   m_begin_appended_data = content.find(opening_appended_data);
-  if (m_begin_appended_data != std::string::npos) {
-    m_begin_appended_data = content.find('>', m_begin_appended_data);
-    m_begin_appended_data = content.find('_', m_begin_appended_data) + 1;
-  } else {
+  if (m_begin_appended_data == std::string_view::npos) {
+    m_xml = content;
     return;
   }
-  auto end_appended_data =
-      m_begin_appended_data == std::string::npos
-          ? std::string::npos
-          : content.find(closing_appended_data, m_begin_appended_data);
-  if (end_appended_data != std::string::npos) {
+  m_begin_appended_data = content.find('>', m_begin_appended_data);
+  m_begin_appended_data = content.find('_', m_begin_appended_data) + 1;
+  // The closing tag is searched from the back because the binary data may
+  // contain any byte sequence.
+  auto end_appended_data = content.rfind(closing_appended_data);
+  if (end_appended_data != std::string_view::npos &&
+      end_appended_data > m_begin_appended_data) {
     end_appended_data = content.rfind('\n', end_appended_data);
   }
-  content.erase(m_begin_appended_data, end_appended_data - m_begin_appended_data);
+  if (end_appended_data == std::string_view::npos ||
+      end_appended_data < m_begin_appended_data) {
+    end_appended_data = content.size();
+  }
+  m_xml.reserve(m_begin_appended_data + content.size() - end_appended_data);
+  m_xml.append(content.substr(0, m_begin_appended_data));
+  m_xml.append(content.substr(end_appended_data));
 }
 //==============================================================================
 auto reader::read_meta() -> void {
@@ -50,6 +61,15 @@ auto reader::read_meta() -> void {
   if (header_type_attr != nullptr) {
     m_header_type = parse_data_type(header_type_attr->value());
   }
+  if (auto compressor_attr = root->first_attribute("compressor");
+      compressor_attr != nullptr) {
+    if (std::strcmp(compressor_attr->value(), "vtkZLibDataCompressor") != 0) {
+      throw std::runtime_error{std::string{"Compressor "} +
+                               compressor_attr->value() +
+                               " is not supported."};
+    }
+    m_is_zlib_compressed = true;
+  }
   auto n = root->first_node(std::string(to_string(m_type)).c_str());
   switch (m_type) {
     case vtk_type::image_data:
@@ -73,23 +93,128 @@ auto reader::read_meta() -> void {
   }
 }
 //==============================================================================
-auto reader::read_appended_data_size(std::size_t offset) const -> std::size_t {
-  m_file.seekg(m_begin_appended_data, m_file.beg);
-  m_file.seekg(offset, m_file.cur);
+auto reader::read_header_value(std::size_t const pos) const -> std::size_t {
+  auto const header_size = xml::size(m_header_type);
+  if (pos + header_size > m_file.size()) {
+    throw std::runtime_error{"Appended data of " + m_path.string() +
+                             " is truncated."};
+  }
   auto size = std::size_t{};
   visit(m_header_type, [&](unsigned_integral auto i) {
-    m_file.read(reinterpret_cast<char*>(&i), sizeof(decltype(i)));
+    std::memcpy(&i, m_file.data() + pos, sizeof(decltype(i)));
     size = static_cast<std::size_t>(i);
   });
   return size;
 }
 //==============================================================================
+auto reader::read_appended_data_size(std::size_t offset) const -> std::size_t {
+  auto const pos = m_begin_appended_data + offset;
+  if (!m_is_zlib_compressed) {
+    return read_header_value(pos);
+  }
+  // header: number of blocks, uncompressed block size, uncompressed size of
+  // last block, compressed block sizes
+  auto const header_size = xml::size(m_header_type);
+  auto const num_blocks  = read_header_value(pos);
+  if (num_blocks == 0) {
+    return 0;
+  }
+  auto const block_size      = read_header_value(pos + header_size);
+  auto const last_block_size = read_header_value(pos + 2 * header_size);
+  return (num_blocks - 1) * block_size +
+         (last_block_size == 0 ? block_size : last_block_size);
+}
+//==============================================================================
 auto reader::read_appended_data(char* data, std::size_t num_bytes,
                                 std::size_t offset) const -> void {
-  m_file.seekg(m_begin_appended_data, m_file.beg);
-  m_file.seekg(offset, m_file.cur);
-  m_file.seekg(xml::size(m_header_type), m_file.cur);
-  m_file.read(data, num_bytes);
+  if (m_is_zlib_compressed) {
+    read_compressed_appended_data(data, num_bytes, offset);
+    return;
+  }
+  auto const bytes = appended_data(offset);
+  std::memcpy(data, bytes.data(), std::min(num_bytes, bytes.size()));
+}
+//------------------------------------------------------------------------------
+auto reader::appended_data(std::size_t offset) const
+    -> std::span<std::byte const> {
+  if (m_is_zlib_compressed) {
+    return {};
+  }
+  auto const pos       = m_begin_appended_data + offset;
+  auto const num_bytes = read_header_value(pos);
+  auto const begin     = pos + xml::size(m_header_type);
+  if (begin + num_bytes > m_file.size()) {
+    throw std::runtime_error{"Appended data of " + m_path.string() +
+                             " is truncated."};
+  }
+  return m_file.bytes().subspan(begin, num_bytes);
+}
+//------------------------------------------------------------------------------
+auto reader::read_compressed_appended_data(
+    [[maybe_unused]] char* data, [[maybe_unused]] std::size_t num_bytes,
+    [[maybe_unused]] std::size_t offset) const -> void {
+#if TATOOINE_ZLIB_AVAILABLE
+  auto const header_size     = xml::size(m_header_type);
+  auto const pos             = m_begin_appended_data + offset;
+  auto const num_blocks      = read_header_value(pos);
+  auto const block_size      = read_header_value(pos + header_size);
+  auto const last_block_size = read_header_value(pos + 2 * header_size);
+
+  // offsets of the compressed blocks in the file
+  auto block_begins = std::vector<std::size_t>(num_blocks + 1);
+  block_begins.front() = pos + (3 + num_blocks) * header_size;
+  for (std::size_t i = 0; i < num_blocks; ++i) {
+    block_begins[i + 1] =
+        block_begins[i] + read_header_value(pos + (3 + i) * header_size);
+  }
+  if (block_begins.back() > m_file.size()) {
+    throw std::runtime_error{"Appended data of " + m_path.string() +
+                             " is truncated."};
+  }
+
+  auto failed = std::atomic_bool{false};
+#pragma omp parallel for
+  for (std::size_t i = 0; i < num_blocks; ++i) {
+    auto const begin_uncompressed = i * block_size;
+    if (begin_uncompressed >= num_bytes) {
+      continue;
+    }
+    auto const cur_block_size =
+        i + 1 == num_blocks && last_block_size != 0 ? last_block_size
+                                                     : block_size;
+    auto uncompressed_size = static_cast<uLongf>(cur_block_size);
+    if (num_bytes - begin_uncompressed >= cur_block_size) {
+      auto const status = uncompress(
+          reinterpret_cast<Bytef*>(data + begin_uncompressed),
+          &uncompressed_size,
+          reinterpret_cast<Bytef const*>(m_file.data() + block_begins[i]),
+          static_cast<uLong>(block_begins[i + 1] - block_begins[i]));
+      if (status != Z_OK) {
+        failed = true;
+      }
+    } else {
+      // the caller requested fewer bytes than the block holds
+      auto block = std::vector<Bytef>(cur_block_size);
+      auto const status = uncompress(
+          block.data(), &uncompressed_size,
+          reinterpret_cast<Bytef const*>(m_file.data() + block_begins[i]),
+          static_cast<uLong>(block_begins[i + 1] - block_begins[i]));
+      if (status != Z_OK) {
+        failed = true;
+      }
+      std::memcpy(data + begin_uncompressed, block.data(),
+                  num_bytes - begin_uncompressed);
+    }
+  }
+  if (failed) {
+    throw std::runtime_error{"Could not decompress appended data of " +
+                             m_path.string() + "."};
+  }
+#else
+  throw std::runtime_error{
+      "Cannot read compressed appended data of " + m_path.string() +
+      " because tatooine was built without zlib."};
+#endif
 }
 //==============================================================================
 }  // namespace tatooine::vtk::xml
@@ -3,7 +3,9 @@
 #include <tatooine/concepts.h>
 #include <tatooine/type_traits.h>
 
+#include <algorithm>
 #include <cassert>
+#include <charconv>
 #include <cstdlib>
 #include <exception>
 #include <fstream>
@@ -133,45 +135,89 @@ auto legacy_file::add_listener(legacy_file_listener &listener) -> void {
   m_listeners.push_back(&listener);
 }
 //===========================================================================
+auto legacy_file_tokenizer::skip_whitespace() -> void {
+  while (!eof() && is_whitespace(m_content[m_pos])) {
+    ++m_pos;
+  }
+}
+//---------------------------------------------------------------------------
+auto legacy_file_tokenizer::skip_word() -> void {
+  while (!eof() && !is_whitespace(m_content[m_pos])) {
+    ++m_pos;
+  }
+}
+//---------------------------------------------------------------------------
+auto legacy_file_tokenizer::read_word() -> std::string_view {
+  skip_whitespace();
+  auto const begin = m_pos;
+  skip_word();
+  return m_content.substr(begin, m_pos - begin);
+}
+//---------------------------------------------------------------------------
+auto legacy_file_tokenizer::read_line() -> std::string_view {
+  auto const begin = m_pos;
+  m_pos            = std::min(m_content.find('\n', m_pos), m_content.size());
+  auto line        = m_content.substr(begin, m_pos - begin);
+  if (!line.empty() && line.back() == '\r') {
+    line.remove_suffix(1);
+  }
+  return line;
+}
+//---------------------------------------------------------------------------
+auto legacy_file_tokenizer::skip_line() -> void {
+  m_pos = std::min(m_content.find('\n', m_pos), m_content.size());
+  if (!eof()) {
+    ++m_pos;
+  }
+}
+//===========================================================================
 legacy_file::legacy_file(filesystem::path path) : m_path(std::move(path)) {}
 //---------------------------------------------------------------------------
 auto legacy_file::read() -> void {
-  read_header();
-  read_data();
+  auto const mapped_file = memory_mapped_file{m_path};
+  if (!mapped_file.is_open()) {
+    throw std::runtime_error{
+        "[tatooine::vtk::legacy_file] could not open file " + m_path.string()};
+  }
+  auto file = legacy_file_tokenizer{mapped_file.as_string_view()};
+  read_header(file);
+  read_data(file);
 }
 //---------------------------------------------------------------------------
-auto legacy_file::read_scalars_header(std::ifstream &file) {
-  std::string       scalar_params = vtk::read_binaryline(file, buffer);
-  std::stringstream scalar_params_stream(scalar_params);
-
-  auto data_name    = vtk::read_word(scalar_params_stream, buffer);
-  auto data_type    = vtk::read_word(scalar_params_stream, buffer);
-  auto num_comp_str = vtk::read_word(scalar_params_stream, buffer);
-  consume_trailing_break(file);
+auto legacy_file::read_scalars_header(legacy_file_tokenizer &file) {
+  auto       params       = legacy_file_tokenizer{file.read_line()};
+  auto const data_name    = std::string{params.read_word()};
+  auto const data_type    = std::string{params.read_word()};
+  auto const num_comp_str = params.read_word();
   // number of components is optional
-  size_t num_comps = 1;
-  if (num_comp_str.empty()) {
-    vtk::read_word(file, buffer);  // consume empty space
-  } else if (num_comp_str != "LOOKUP_TABLE") {
-    num_comps = parse<size_t>(num_comp_str);
-    vtk::read_word(file, buffer);  // consume LOOKUP_TABLE keyword
+  auto const num_comps =
+      num_comp_str.empty()
+          ? std::size_t{1}
+          : legacy_file_tokenizer::parse_number<std::size_t>(num_comp_str);
+  // the lookup table is optional
+  auto       lookup_table_name = std::string{"default"};
+  auto const line_end          = file.position();
+  if (file.read_word() == "LOOKUP_TABLE") {
+    lookup_table_name = file.read_word();
+  } else {
+    file.seek(line_end);
   }
-  auto lookup_table_name = vtk::read_word(file, buffer);
-  return std::make_tuple(data_name, data_type, num_comps, lookup_table_name);
+  return std::tuple{data_name, data_type, num_comps, lookup_table_name};
 }
 //----------------------------------------------------------------------------
-auto legacy_file::read_data_header(std::ifstream &file) {
-  return std::make_pair(vtk::read_word(file, buffer),
-                        vtk::read_word(file, buffer));
+auto legacy_file::read_data_header(legacy_file_tokenizer &file) {
+  auto name = std::string{file.read_word()};
+  auto type = std::string{file.read_word()};
+  return std::pair{std::move(name), std::move(type)};
 }
 //----------------------------------------------------------------------------
 // coordinates
-auto legacy_file::read_coordinates_header(std::ifstream &file) {
-  return std::make_pair(parse<size_t>(vtk::read_word(file, buffer)),
-                        vtk::read_word(file, buffer));
+auto legacy_file::read_coordinates_header(legacy_file_tokenizer &file) {
+  auto const n = file.read_number<std::size_t>();
+  return std::pair{n, std::string{file.read_word()}};
 }
 //----------------------------------------------------------------------------
-auto legacy_file::read_x_coordinates(std::ifstream &file) -> void {
+auto legacy_file::read_x_coordinates(legacy_file_tokenizer &file) -> void {
   auto const  header = read_coordinates_header(file);
   auto const &n      = header.first;
   auto const &type   = header.second;
@@ -179,16 +225,16 @@ auto legacy_file::read_x_coordinates(std::ifstream &file) -> void {
     auto c = read_coordinates<float>(file, n);
     for (auto *l : m_listeners) {
       l->on_x_coordinates(c);
-}
+    }
   } else if (type == "double") {
     auto c = read_coordinates<double>(file, n);
     for (auto *l : m_listeners) {
       l->on_x_coordinates(c);
-}
+    }
   }
 }
 //----------------------------------------------------------------------------
-auto legacy_file::read_y_coordinates(std::ifstream &file) -> void {
+auto legacy_file::read_y_coordinates(legacy_file_tokenizer &file) -> void {
   auto const  header = read_coordinates_header(file);
   auto const &n      = header.first;
   auto const &type   = header.second;
@@ -196,16 +242,16 @@ auto legacy_file::read_y_coordinates(std::ifstream &file) -> void {
     auto c = read_coordinates<float>(file, n);
     for (auto *l : m_listeners) {
       l->on_y_coordinates(c);
-}
+    }
   } else if (type == "double") {
     auto c = read_coordinates<double>(file, n);
     for (auto *l : m_listeners) {
       l->on_y_coordinates(c);
-}
+    }
   }
 }
 //----------------------------------------------------------------------------
-auto legacy_file::read_z_coordinates(std::ifstream &file) -> void {
+auto legacy_file::read_z_coordinates(legacy_file_tokenizer &file) -> void {
   auto const  header = read_coordinates_header(file);
   auto const &n      = header.first;
   auto const &type   = header.second;
@@ -213,45 +259,45 @@ auto legacy_file::read_z_coordinates(std::ifstream &file) -> void {
     auto c = read_coordinates<float>(file, n);
     for (auto *l : m_listeners) {
       l->on_z_coordinates(c);
-}
+    }
   } else if (type == "double") {
     auto c = read_coordinates<double>(file, n);
     for (auto *l : m_listeners) {
       l->on_z_coordinates(c);
-}
+    }
   }
 }
 //----------------------------------------------------------------------------
 // index data
-auto legacy_file::read_cells(std::ifstream &file) -> void {
+auto legacy_file::read_cells(legacy_file_tokenizer &file) -> void {
   auto i = read_indices(file);
   for (auto *l : m_listeners) {
     l->on_cells(i);
   }
 }
 //----------------------------------------------------------------------------
-auto legacy_file::read_vertices(std::ifstream &file) -> void {
+auto legacy_file::read_vertices(legacy_file_tokenizer &file) -> void {
   auto const i = read_indices(file);
   for (auto *l : m_listeners) {
     l->on_vertices(i);
   }
 }
 //----------------------------------------------------------------------------
-auto legacy_file::read_lines(std::ifstream &file) -> void {
+auto legacy_file::read_lines(legacy_file_tokenizer &file) -> void {
   auto const i = read_indices(file);
   for (auto *l : m_listeners) {
     l->on_lines(i);
   }
 }
 //----------------------------------------------------------------------------
-auto legacy_file::read_polygons(std::ifstream &file) -> void {
+auto legacy_file::read_polygons(legacy_file_tokenizer &file) -> void {
   auto const i = read_indices(file);
   for (auto *l : m_listeners) {
     l->on_polygons(i);
   }
 }
 //----------------------------------------------------------------------------
-auto legacy_file::read_triangle_strips(std::ifstream &file) -> void {
+auto legacy_file::read_triangle_strips(legacy_file_tokenizer &file) -> void {
   auto const i = read_indices(file);
   for (auto *l : m_listeners) {
     l->on_triangle_strips(i);
@@ -259,7 +305,7 @@ auto legacy_file::read_triangle_strips(std::ifstream &file) -> void {
 }
 //----------------------------------------------------------------------------
 // fixed size data
-auto legacy_file::read_vectors(std::ifstream &file) -> void {
+auto legacy_file::read_vectors(legacy_file_tokenizer &file) -> void {
   auto const  header = read_data_header(file);
   auto const &name   = header.first;
   auto const &type   = header.second;
@@ -267,16 +313,16 @@ auto legacy_file::read_vectors(std::ifstream &file) -> void {
     auto data = read_data<float, 3>(file);
     for (auto *l : m_listeners) {
       l->on_vectors(name, data, m_data);
-}
+    }
   } else if (type == "double") {
     auto data = read_data<double, 3>(file);
     for (auto *l : m_listeners) {
       l->on_vectors(name, data, m_data);
-}
+    }
   }
 }
 //----------------------------------------------------------------------------
-auto legacy_file::read_normals(std::ifstream &file) -> void {
+auto legacy_file::read_normals(legacy_file_tokenizer &file) -> void {
   auto const  header = read_data_header(file);
   auto const &name   = header.first;
   auto const &type   = header.second;
@@ -284,16 +330,17 @@ auto legacy_file::read_normals(std::ifstream &file) -> void {
     auto data = read_data<float, 3>(file);
     for (auto *l : m_listeners) {
       l->on_normals(name, data, m_data);
-}
+    }
   } else if (type == "double") {
     auto data = read_data<double, 3>(file);
     for (auto *l : m_listeners) {
       l->on_normals(name, data, m_data);
-}
+    }
   }
 }
 //----------------------------------------------------------------------------
-auto legacy_file::read_texture_coordinates(std::ifstream &file) -> void {
+auto legacy_file::read_texture_coordinates(legacy_file_tokenizer &file)
+    -> void {
   auto const  header = read_data_header(file);
   auto const &name   = header.first;
   auto const &type   = header.second;
@@ -301,16 +348,16 @@ auto legacy_file::read_texture_coordinates(std::ifstream &file) -> void {
     auto data = read_data<float, 2>(file);
     for (auto *l : m_listeners) {
       l->on_texture_coordinates(name, data, m_data);
-}
+    }
   } else if (type == "double") {
     auto data = read_data<double, 2>(file);
     for (auto *l : m_listeners) {
       l->on_texture_coordinates(name, data, m_data);
-}
+    }
   }
 }
 //----------------------------------------------------------------------------
-auto legacy_file::read_tensors(std::ifstream &file) -> void {
+auto legacy_file::read_tensors(legacy_file_tokenizer &file) -> void {
   auto const  header = read_data_header(file);
   auto const &name   = header.first;
   auto const &type   = header.second;
@@ -318,46 +365,38 @@ auto legacy_file::read_tensors(std::ifstream &file) -> void {
     auto data = read_data<float, 9>(file);
     for (auto *l : m_listeners) {
       l->on_tensors(name, data, m_data);
-}
+    }
   } else if (type == "double") {
     auto data = read_data<double, 9>(file);
     for (auto *l : m_listeners) {
       l->on_tensors(name, data, m_data);
-}
+    }
   }
 }
 //----------------------------------------------------------------------------
-auto legacy_file::read_field_header(std::ifstream &file)
+auto legacy_file::read_field_header(legacy_file_tokenizer &file)
     -> std::pair<std::string, size_t> {
-  std::string       field_params = vtk::read_binaryline(file, buffer);
-  std::stringstream field_params_stream(field_params);
-
-  return {vtk::read_word(field_params_stream, buffer),
-          parse<size_t>(vtk::read_word(field_params_stream, buffer))};
+  auto name       = std::string{file.read_word()};
+  auto num_arrays = file.read_number<std::size_t>();
+  return {std::move(name), num_arrays};
 }
 //----------------------------------------------------------------------------
 // field data
-auto legacy_file::read_field_array_header(std::ifstream &file)
+auto legacy_file::read_field_array_header(legacy_file_tokenizer &file)
     -> std::tuple<std::string, size_t, size_t, std::string> {
-  std::string       field_array_params = vtk::read_binaryline(file, buffer);
-  std::stringstream field_array_params_stream(field_array_params);
-  std::string       array_name;
-  field_array_params_stream >> array_name;
-  while (array_name == "METADATA" || array_name == "INFORMATION" ||
-         field_array_params.empty()) {
-    field_array_params        = vtk::read_binaryline(file, buffer);
-    field_array_params_stream = std::stringstream{field_array_params};
-    if (!field_array_params.empty()) {
-      field_array_params_stream >> array_name;
-    }
+  auto array_name = file.read_word();
+  while (array_name == "METADATA" || array_name == "INFORMATION") {
+    file.skip_line();
+    array_name = file.read_word();
   }
-  size_t num_comps = 0, num_tuples = 0;
-  std::string datatype_str;
-  field_array_params_stream >> num_comps >> num_tuples >> datatype_str;
-  return {array_name, num_comps, num_tuples, datatype_str};
+  auto const num_comps  = file.read_number<std::size_t>();
+  auto const num_tuples = file.read_number<std::size_t>();
+  auto const datatype   = file.read_word();
+  return {std::string{array_name}, num_comps, num_tuples,
+          std::string{datatype}};
 }
 //----------------------------------------------------------------------------
-auto legacy_file::read_field(std::ifstream &file) -> void {
+auto legacy_file::read_field(legacy_file_tokenizer &file) -> void {
   auto const  header     = read_field_header(file);
   auto const &field_name = header.first;
   auto const &num_arrays = header.second;
@@ -365,312 +404,206 @@ auto legacy_file::read_field(std::ifstream &file) -> void {
     auto const [field_array_name, num_comps, num_tuples, datatype_str] =
         read_field_array_header(file);
 
-    if (m_format == format::ascii) {
-      if (datatype_str == "int") {
-        auto data = read_field_array_ascii<int>(file, num_comps, num_tuples);
-        for (auto *l : m_listeners) {
-          l->on_field_array(field_name, field_array_name, data, num_comps,
-                            num_tuples);
-        }
-      } else if (datatype_str == "float") {
-        auto data = read_field_array_ascii<float>(file, num_comps, num_tuples);
-        for (auto *l : m_listeners) {
-          l->on_field_array(field_name, field_array_name, data, num_comps,
-                            num_tuples);
-        }
-      } else if (datatype_str == "double") {
-        auto data = read_field_array_ascii<double>(file, num_comps, num_tuples);
-        for (auto *l : m_listeners) {
-          l->on_field_array(field_name, field_array_name, data, num_comps,
-                            num_tuples);
-        }
+    if (datatype_str == "int") {
+      auto data = read_field_array<int>(file, num_comps, num_tuples);
+      for (auto *l : m_listeners) {
+        l->on_field_array(field_name, field_array_name, data, num_comps,
+                          num_tuples);
+      }
+    } else if (datatype_str == "float") {
+      auto data = read_field_array<float>(file, num_comps, num_tuples);
+      for (auto *l : m_listeners) {
+        l->on_field_array(field_name, field_array_name, data, num_comps,
+                          num_tuples);
       }
-    } else if (m_format == format::binary) {
-      if (datatype_str == "int") {
-        auto data = read_field_array_binary<int>(file, num_comps, num_tuples);
-        for (auto *l : m_listeners) {
-          l->on_field_array(field_name, field_array_name, data, num_comps,
-                            num_tuples);
-        }
-      } else if (datatype_str == "float") {
-        auto data = read_field_array_binary<float>(file, num_comps, num_tuples);
-        for (auto *l : m_listeners) {
-          l->on_field_array(field_name, field_array_name, data, num_comps,
-                            num_tuples);
-        }
-      } else if (datatype_str == "double") {
-        auto data =
-            read_field_array_binary<double>(file, num_comps, num_tuples);
-        for (auto *l : m_listeners) {
-          l->on_field_array(field_name, field_array_name, data, num_comps,
-                            num_tuples);
-        }
+    } else if (datatype_str == "double") {
+      auto data = read_field_array<double>(file, num_comps, num_tuples);
+      for (auto *l : m_listeners) {
+        l->on_field_array(field_name, field_array_name, data, num_comps,
+                          num_tuples);
       }
     }
   }
 }
-//------------------------------------------------------------------------------
-auto legacy_file::consume_trailing_break(std::ifstream &file) -> void {
-  char consumer = 0;
-  file.read(&consumer, sizeof(char));
-}
 //-----------------------------------------------------------------------------------------------
-auto legacy_file::read_header() -> void {
-#if TATOOINE_STD_FILESYSTEM_AVAILABLE
-  std::ifstream file(m_path, std::ifstream::binary);
-#else
-  std::ifstream file(m_path.string(), std::ifstream::binary);
-#endif
-  if (file.is_open()) {
-    // read part1 # vtk DataFile Version x.x
-    std::string part1 = vtk::read_binaryline(file, buffer);
-    for (auto *listener : m_listeners) {
-      listener->on_version((unsigned short)(atoi(&buffer[23])),
-                           (unsigned short)(atoi(&buffer[25])));
-}
-
-    // read part2 maximal 256 characters
-    std::string part2 = vtk::read_binaryline(file, buffer);
-    for (auto *listener : m_listeners) {
-      listener->on_title(part2);
-    }
-
-    // read part3 ASCII | BINARY
-    std::string part3 = vtk::read_binaryline(file, buffer);
-    if (part3 == "ASCII" || part3 == "ascii") {
-      m_format = format::ascii;
-    } else if (part3 == "BINARY" || part3 == "binary") {
-      m_format = format::binary;
-    } else {
-      m_format = format::unknown;
+auto legacy_file::read_header(legacy_file_tokenizer &file) -> void {
+  // read part1 # vtk DataFile Version x.x
+  auto const part1 = file.read_line();
+  file.skip_line();
+  auto major = (unsigned short)0;
+  auto minor = (unsigned short)0;
+  if (auto const version_pos = part1.find("Version");
+      version_pos != std::string_view::npos) {
+    auto const version =
+        legacy_file_tokenizer{part1.substr(version_pos + 7)}.read_word();
+    auto const [dot, ec] = std::from_chars(
+        version.data(), version.data() + version.size(), major);
+    if (ec == std::errc{} && dot != version.data() + version.size()) {
+      std::from_chars(dot + 1, version.data() + version.size(), minor);
     }
+  }
+  for (auto *listener : m_listeners) {
+    listener->on_version(major, minor);
+  }
 
-    for (auto *listener : m_listeners) {
-      listener->on_format(m_format);
-}
+  // read part2 maximal 256 characters
+  auto const part2 = std::string{file.read_line()};
+  file.skip_line();
+  for (auto *listener : m_listeners) {
+    listener->on_title(part2);
+  }
 
-    // read part4 STRUCTURED_POINTS | STRUCTURED_GRID | UNSTRUCTURED_GRID |
-    // POLYDATA | RECTILINEAR_GRID | FIELD
-    file.read(buffer, sizeof(char) * 8);  // consume "DATASET "
-    auto part4 = parse_dataset_type(vtk::read_binaryline(file, buffer));
-    for (auto *listener : m_listeners) {
-      listener->on_dataset_type(part4);
-    }
+  // read part3 ASCII | BINARY
+  auto const part3 = file.read_word();
+  file.skip_line();
+  if (part3 == "ASCII" || part3 == "ascii") {
+    m_format = format::ascii;
+  } else if (part3 == "BINARY" || part3 == "binary") {
+    m_format = format::binary;
+  } else {
+    m_format = format::unknown;
+  }
+  for (auto *listener : m_listeners) {
+    listener->on_format(m_format);
+  }
 
-    m_begin_of_data = file.tellg();
-    file.close();
+  // read part4 STRUCTURED_POINTS | STRUCTURED_GRID | UNSTRUCTURED_GRID |
+  // POLYDATA | RECTILINEAR_GRID | FIELD
+  auto const begin_of_part4 = file.position();
+  auto       part4          = dataset_type::unknown;
+  if (file.read_word() == "DATASET") {
+    part4 = parse_dataset_type(std::string{file.read_word()});
   } else {
-    throw std::runtime_error{"[vtk::legacy_file] could not open file " +
-                             m_path.string()};
+    // files that only hold field data have no DATASET keyword
+    file.seek(begin_of_part4);
+  }
+  for (auto *listener : m_listeners) {
+    listener->on_dataset_type(part4);
   }
 }
 //-----------------------------------------------------------------------------
-auto legacy_file::read_data() -> void {
-#if TATOOINE_STD_FILESYSTEM_AVAILABLE
-  std::ifstream file(m_path, std::ifstream::binary);
-#else
-  std::ifstream file(m_path.string(), std::ifstream::binary);
-#endif
-  if (file.is_open()) {
-    file.seekg(m_begin_of_data, file.beg);
-    std::string keyword;
-
-    while (!file.eof()) {
-      keyword = vtk::read_word(file, buffer);
-      if (!keyword.empty()) {
-        if (keyword == "POINTS") {
-          read_points(file);
-        } else if (keyword == "LINES") {
-          read_lines(file);
-        } else if (keyword == "VERTICES") {
-          read_vertices(file);
-        } else if (keyword == "POLYGONS") {
-          read_polygons(file);
-        } else if (keyword == "CELLS") {
-          read_cells(file);
-        } else if (keyword == "CELL_TYPES") {
-          read_cell_types(file);
-        } else if (keyword == "DIMENSIONS") {
-          read_dimensions(file);
-        } else if (keyword == "ORIGIN") {
-          read_origin(file);
-        } else if (keyword == "SPACING") {
-          read_spacing(file);
-        } else if (keyword == "X_COORDINATES") {
-          read_x_coordinates(file);
-        } else if (keyword == "Y_COORDINATES") {
-          read_y_coordinates(file);
-        } else if (keyword == "Z_COORDINATES") {
-          read_z_coordinates(file);
-        } else if (keyword == "POINT_DATA") {
-          auto const word = vtk::read_word(file, buffer);
-          m_data_size     = size_t(parse<int>(word));
-          m_data          = reader_data::point_data;
-          for (auto *l : m_listeners) {
-            l->on_point_data(m_data_size);
-          }
-        } else if (keyword == "CELL_DATA") {
-          m_data_size = size_t(parse<int>(vtk::read_word(file, buffer)));
-          m_data      = reader_data::point_data;
-          for (auto *l : m_listeners) {
-            l->on_cell_data(m_data_size);
-}
-        } else if (keyword == "SCALARS") {
-          read_scalars(file);
-        } else if (keyword == "VECTORS") {
-          read_vectors(file);
-        } else if (keyword == "NORMALS") {
-          read_normals(file);
-        } else if (keyword == "TEXTURE_COORDINATES") {
-          read_texture_coordinates(file);
-        } else if (keyword == "FIELD") {
-          read_field(file);
-        } else {
-            //std::cerr << "[tatooine::vtk::legacy_file] unknown keyword: "
-          //          << keyword << '\n';
-        }
+auto legacy_file::read_data(legacy_file_tokenizer &file) -> void {
+  while (!file.eof()) {
+    auto const keyword = file.read_word();
+    if (keyword.empty()) {
+      continue;
+    }
+    if (keyword == "POINTS") {
+      read_points(file);
+    } else if (keyword == "LINES") {
+      read_lines(file);
+    } else if (keyword == "VERTICES") {
+      read_vertices(file);
+    } else if (keyword == "POLYGONS") {
+      read_polygons(file);
+    } else if (keyword == "TRIANGLE_STRIPS") {
+      read_triangle_strips(file);
+    } else if (keyword == "CELLS") {
+      read_cells(file);
+    } else if (keyword == "CELL_TYPES") {
+      read_cell_types(file);
+    } else if (keyword == "DIMENSIONS") {
+      read_dimensions(file);
+    } else if (keyword == "ORIGIN") {
+      read_origin(file);
+    } else if (keyword == "SPACING") {
+      read_spacing(file);
+    } else if (keyword == "X_COORDINATES") {
+      read_x_coordinates(file);
+    } else if (keyword == "Y_COORDINATES") {
+      read_y_coordinates(file);
+    } else if (keyword == "Z_COORDINATES") {
+      read_z_coordinates(file);
+    } else if (keyword == "POINT_DATA") {
+      m_data_size = file.read_number<std::size_t>();
+      m_data      = reader_data::point_data;
+      for (auto *l : m_listeners) {
+        l->on_point_data(m_data_size);
       }
+    } else if (keyword == "CELL_DATA") {
+      m_data_size = file.read_number<std::size_t>();
+      m_data      = reader_data::cell_data;
+      for (auto *l : m_listeners) {
+        l->on_cell_data(m_data_size);
+      }
+    } else if (keyword == "SCALARS") {
+      read_scalars(file);
+    } else if (keyword == "VECTORS") {
+      read_vectors(file);
+    } else if (keyword == "NORMALS") {
+      read_normals(file);
+    } else if (keyword == "TEXTURE_COORDINATES") {
+      read_texture_coordinates(file);
+    } else if (keyword == "TENSORS") {
+      read_tensors(file);
+    } else if (keyword == "FIELD") {
+      read_field(file);
     }
-  } else {
-    throw std::runtime_error{
-        "[tatooine::vtk::legacy_file] could not open file " + m_path.string()};
-};
+  }
 }
 //------------------------------------------------------------------------------
-auto legacy_file::read_spacing(std::ifstream &file) -> void {
-  std::array<double, 3> spacing{parse<double>(vtk::read_word(file, buffer)),
-                                parse<double>(vtk::read_word(file, buffer)),
-                                parse<double>(vtk::read_word(file, buffer))};
+auto legacy_file::read_spacing(legacy_file_tokenizer &file) -> void {
+  auto spacing = std::array<double, 3>{};
+  file.read_ascii(spacing.data(), 3, false);
   for (auto *l : m_listeners) {
     l->on_spacing(spacing[0], spacing[1], spacing[2]);
   }
 }
 //------------------------------------------------------------------------------
-auto legacy_file::read_dimensions(std::ifstream &file) -> void {
-  std::array<size_t, 3> dims{parse<size_t>(vtk::read_word(file, buffer)),
-                             parse<size_t>(vtk::read_word(file, buffer)),
-                             parse<size_t>(vtk::read_word(file, buffer))};
+auto legacy_file::read_dimensions(legacy_file_tokenizer &file) -> void {
+  auto dims = std::array<std::size_t, 3>{};
+  file.read_ascii(dims.data(), 3, false);
   for (auto *l : m_listeners) {
     l->on_dimensions(dims[0], dims[1], dims[2]);
   }
 }
 //------------------------------------------------------------------------------
-auto legacy_file::read_origin(std::ifstream &file) -> void {
-  std::array<double, 3> origin{parse<double>(vtk::read_word(file, buffer)),
-                               parse<double>(vtk::read_word(file, buffer)),
-                               parse<double>(vtk::read_word(file, buffer))};
+auto legacy_file::read_origin(legacy_file_tokenizer &file) -> void {
+  auto origin = std::array<double, 3>{};
+  file.read_ascii(origin.data(), 3, false);
   for (auto *l : m_listeners) {
     l->on_origin(origin[0], origin[1], origin[2]);
   }
 }
 //------------------------------------------------------------------------------
-auto legacy_file::read_points(std::ifstream &file) -> void {
-  auto const num_points_str = vtk::read_word(file, buffer);
-  auto const n              = parse<size_t>(num_points_str);
-  auto const datatype_str   = vtk::read_word(file, buffer);
-
-  if (m_format == format::ascii) {
-    if (datatype_str == "float") {
-      read_points_ascii<float>(file, n);
-    } else if (datatype_str == "double") {
-      read_points_ascii<double>(file, n);
-    }
-  } else if (m_format == format::binary) {
-    if (datatype_str == "float") {
-      read_points_binary<float>(file, n);
-    } else if (datatype_str == "double") {
-      read_points_binary<double>(file, n);
-    }
+auto legacy_file::read_points(legacy_file_tokenizer &file) -> void {
+  auto const n            = file.read_number<std::size_t>();
+  auto const datatype_str = file.read_word();
+  if (datatype_str == "float") {
+    read_points<float>(file, n);
+  } else if (datatype_str == "double") {
+    read_points<double>(file, n);
   }
 }
 //-----------------------------------------------------------------------------------------------
-auto legacy_file::read_cell_types(std::ifstream &file) -> void {
-  auto num_cell_types_str = vtk::read_word(file, buffer);
-  auto num_cell_types     = parse<size_t>(num_cell_types_str);
-
-  if (m_format == format::ascii) {
-    read_cell_types_ascii(file, num_cell_types);
-  } else if (m_format == format::binary) {
-    read_cell_types_binary(file, num_cell_types);
-}
-}
-//-----------------------------------------------------------------------------------------------
-auto legacy_file::read_cell_types_ascii(std::ifstream &file,
-                                        size_t const   num_cell_types) -> void {
-  std::vector<cell_type> cell_types;
-  std::string            cell_type_str;
-  for (size_t i = 0; i < num_cell_types; i++) {
-    cell_type_str = vtk::read_word(file, buffer);
-    cell_types.push_back((cell_type)parse<int>(cell_type_str));
-  }
+auto legacy_file::read_cell_types(legacy_file_tokenizer &file) -> void {
+  auto const num_cell_types = file.read_number<std::size_t>();
+  // cell types are stored as int but cell_type only holds one byte
+  auto ints = std::vector<int>(num_cell_types);
+  read_values(file, ints.data(), num_cell_types);
+  auto cell_types = std::vector<cell_type>(num_cell_types);
+  std::ranges::transform(ints, begin(cell_types),
+                         [](auto const i) { return static_cast<cell_type>(i); });
   for (auto *listener : m_listeners) {
     listener->on_cell_types(cell_types);
-}
-}
-//-----------------------------------------------------------------------------
-auto legacy_file::read_cell_types_binary(std::ifstream &file,
-                                         size_t const num_cell_types) -> void {
-  std::vector<cell_type> cell_types(num_cell_types);
-  file.read((char *)cell_types.data(),
-            static_cast<std::streamsize>(sizeof(int) * num_cell_types));
-  swap_endianess(cell_types);
-  for (auto *listener : m_listeners) {
-    listener->on_cell_types(cell_types);
-}
-  consume_trailing_break(file);
-}
-//-----------------------------------------------------------------------------------------------
-auto legacy_file::read_indices(std::ifstream &file) -> std::vector<int> {
-  auto const num_indices_str = vtk::read_word(file, buffer);
-  auto const size_str        = vtk::read_word(file, buffer);
-
-  [[maybe_unused]] auto const num_indices = parse<size_t>(num_indices_str);
-  auto const                  size        = parse<size_t>(size_str);
-
-  if (m_format == format::ascii) {
-    return read_indices_ascii(file, size);
   }
-  /* if (m_format == format::binary) */     return read_indices_binary(file, size);
-
 }
-//-----------------------------------------------------------------------------
-auto legacy_file::read_indices_ascii(std::ifstream & /*file*/,
-                                     size_t const /*size*/)
+//-----------------------------------------------------------------------------------------------
+auto legacy_file::read_indices(legacy_file_tokenizer &file)
     -> std::vector<int> {
-  std::vector<int> indices;
-  // indices.reserve(size);
-  // std::string val_str;
-  // for (size_t i = 0; i < size; i++)
-  //  indices.push_back(parse<size_t>(vtk::read_word(file, buffer)));
+  [[maybe_unused]] auto const num_indices = file.read_number<std::size_t>();
+  auto const                  size        = file.read_number<std::size_t>();
+  auto                        indices     = std::vector<int>(size);
+  read_values(file, indices.data(), size);
   return indices;
 }
-//-----------------------------------------------------------------------------
-auto legacy_file::read_indices_binary(std::ifstream &file, size_t const size)
-    -> std::vector<int> {
-  auto data = std::vector<int>(size);
-  if (size > 0) {
-    file.read((char *)data.data(),
-              static_cast<std::streamsize>(sizeof(int) * size));
-    swap_endianess(data);
-    consume_trailing_break(file);
-  }
-  return data;
-}
 //------------------------------------------------------------------------------
-auto legacy_file::read_scalars(std::ifstream &file) -> void {
+auto legacy_file::read_scalars(legacy_file_tokenizer &file) -> void {
   auto const &[name, type, num_comps, lookup_table] = read_scalars_header(file);
-  if (m_format == format::ascii) {
-    if (type == "float") {
-      read_scalars_ascii<float>(file, name, lookup_table, num_comps);
-    } else if (type == "double") {
-      read_scalars_ascii<double>(file, name, lookup_table, num_comps);
-    }
-  } else if (m_format == format::binary) {
-    if (type == "float") {
-      read_scalars_binary<float>(file, name, lookup_table, num_comps);
-    } else if (type == "double") {
-      read_scalars_binary<double>(file, name, lookup_table, num_comps);
-    }
+  if (type == "float") {
+    read_scalars<float>(file, name, lookup_table, num_comps);
+  } else if (type == "double") {
+    read_scalars<double>(file, name, lookup_table, num_comps);
   }
 }
 //------------------------------------------------------------------------------
@@ -1,32 +1,73 @@
 #ifndef TATOOINE_CACHE_H
 #define TATOOINE_CACHE_H
 //==============================================================================
-#include <map>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <list>
 #include <optional>
-#include <algorithm>
-//#include <tatooine/memory_usage.h>
+#include <unordered_map>
 //==============================================================================
 namespace tatooine {
 //==============================================================================
-template <typename Key, typename Value>
+/// Least recently used cache.
+///
+/// Entries live in a list that is ordered by usage. A hash index maps keys to
+/// list nodes so that lookups, insertions, refreshing the usage and evictions
+/// are all O(1).
+///
+/// Every entry has a memory usage that is counted against max_memory_usage.
+/// It is computed by the memory usage function or passed explicitly as cost on
+/// insertion.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
 class cache {
   //----------------------------------------------------------------------------
   // typedefs
   //----------------------------------------------------------------------------
  public:
-  using container_type = std::map<Key, Value>;
-  using const_iterator = typename container_type::const_iterator;
-  using usage_type     = std::list<const_iterator>;
+  using key_type       = Key;
+  using mapped_type    = Value;
+  using value_type     = std::pair<Key const, Value>;
+  using usage_type     = std::list<value_type>;
+  using iterator       = typename usage_type::iterator;
+  using const_iterator = typename usage_type::const_iterator;
+  using memory_usage_function_type =
+      std::function<std::uint64_t(Key const&, Value const&)>;
+
+ private:
+  using key_ref_type = std::reference_wrapper<Key const>;
+  struct key_ref_hash {
+    Hash hash;
+    auto operator()(key_ref_type const& key) const { return hash(key.get()); }
+  };
+  struct key_ref_equal {
+    KeyEqual equal;
+    auto operator()(key_ref_type const& lhs, key_ref_type const& rhs) const {
+      return equal(lhs.get(), rhs.get());
+    }
+  };
+  struct index_entry {
+    iterator      it;
+    std::uint64_t memory_usage;
+  };
+  using index_type =
+      std::unordered_map<key_ref_type, index_entry, key_ref_hash, key_ref_equal>;
 
   //----------------------------------------------------------------------------
   // members
   //----------------------------------------------------------------------------
- private:
-  container_type m_data;
-  mutable usage_type m_usage;
-  uint64_t m_max_elements;
-  uint64_t m_max_memory_usage;
+  // most recently used entry first
+  mutable usage_type         m_usage;
+  index_type                 m_index;
+  uint64_t                   m_max_elements;
+  uint64_t                   m_max_memory_usage;
+  uint64_t                   m_memory_usage = 0;
+  memory_usage_function_type m_memory_usage_function =
+      [](Key const&, Value const&) -> std::uint64_t {
+    return sizeof(value_type);
+  };
 
   //----------------------------------------------------------------------------
   // ctors
@@ -36,22 +77,21 @@ class cache {
         uint64_t max_memory_usage = std::numeric_limits<uint64_t>::max())
       : m_max_elements{max_elements}, m_max_memory_usage{max_memory_usage} {}
   cache(const cache& other)
-      : m_data{other.m_data},
-        m_max_elements{other.m_max_elements},
-        m_max_memory_usage{other.m_max_memory_usage} {
-    for (auto it : other.m_usage) {
-      m_usage.push_back(next(begin(m_data), distance(begin(other.m_data), it)));
-    }
+      : m_max_elements{other.m_max_elements},
+        m_max_memory_usage{other.m_max_memory_usage},
+        m_memory_usage_function{other.m_memory_usage_function} {
+    copy_entries(other);
   }
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   cache(cache&& other) = default;
   auto& operator=(const cache& other) {
-    m_data = other.m_data;
-    m_max_elements = other.m_max_elements;
-    m_max_memory_usage = other.m_max_memory_usage;
-    for (auto it : other.m_usage) {
-      m_usage.push_back(next(begin(m_data), distance(begin(other.m_data), it)));
+    if (&other == this) {
+      return *this;
     }
+    m_max_elements          = other.m_max_elements;
+    m_max_memory_usage      = other.m_max_memory_usage;
+    m_memory_usage_function = other.m_memory_usage_function;
+    copy_entries(other);
     return *this;
   }
   cache& operator=(cache&& other) = default;
@@ -60,52 +100,84 @@ class cache {
   // methods
   //----------------------------------------------------------------------------
  private:
-  void capacity_check() {
-    while (m_data.size() > m_max_elements
-           //|| (memory_usage().first / 1024.0 > m_max_memory_usage &&
-           //    !m_data.empty())
-    ) {
-      m_data.erase(m_usage.back());
-      m_usage.pop_back();
+  void copy_entries(cache const& other) {
+    clear();
+    for (auto const& [key, value] : other.m_usage) {
+      m_usage.emplace_back(key, value);
+      auto const it  = std::prev(end(m_usage));
+      auto const mem = other.m_index.at(std::cref(key)).memory_usage;
+      m_index.emplace(std::cref(it->first), index_entry{it, mem});
+      m_memory_usage += mem;
     }
   }
   //----------------------------------------------------------------------------
-  void enqueue(const_iterator it, bool ins) {
-    if (ins) {
-      m_usage.push_front(it);
-      capacity_check();
+  auto exceeds_capacity() const {
+    return m_index.size() > m_max_elements ||
+           m_memory_usage > m_max_memory_usage;
+  }
+  //----------------------------------------------------------------------------
+  /// Evicts least recently used entries until the limits are met. keep is
+  /// never evicted so that iterators handed out by insert stay valid.
+  void capacity_check(std::optional<const_iterator> const keep = {}) {
+    while (!m_usage.empty() && exceeds_capacity()) {
+      auto const lru = std::prev(end(m_usage));
+      if (keep && lru == *keep) {
+        break;
+      }
+      erase(lru);
     }
   }
   //----------------------------------------------------------------------------
-  void refresh_usage(const_iterator it) {
-    m_usage.erase(std::find(begin(m_usage), end(m_usage), it));
-    m_usage.push_front(it);
-  } 
+  void erase(const_iterator it) {
+    auto const index_it = m_index.find(std::cref(it->first));
+    m_memory_usage -= index_it->second.memory_usage;
+    m_index.erase(index_it);
+    m_usage.erase(it);
+  }
+  //----------------------------------------------------------------------------
+  void refresh_usage(const_iterator it) const {
+    m_usage.splice(begin(m_usage), m_usage, it);
+  }
+  //----------------------------------------------------------------------------
+  template <typename K, typename V>
+  auto insert_impl(K&& key, V&& value, std::optional<std::uint64_t> const cost)
+      -> std::pair<iterator, bool> {
+    if (auto const index_it = m_index.find(std::cref(key));
+        index_it != end(m_index)) {
+      return {index_it->second.it, false};
+    }
+    m_usage.emplace_front(std::forward<K>(key), std::forward<V>(value));
+    auto const it = begin(m_usage);
+    auto const mem =
+        cost ? *cost : m_memory_usage_function(it->first, it->second);
+    m_index.emplace(std::cref(it->first), index_entry{it, mem});
+    m_memory_usage += mem;
+    capacity_check(it);
+    return {it, true};
+  }
 
  public:
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-  auto insert(const Key& key, const Value& value) {
-    auto insertion = m_data.insert(std::pair{key, value});
-    enqueue(insertion.first, insertion.second);
-    return insertion;
+  /// If cost is set it is used as memory usage of the entry instead of the
+  /// memory usage function.
+  auto insert(const Key& key, const Value& value,
+              std::optional<std::uint64_t> const cost = {}) {
+    return insert_impl(key, value, cost);
   }
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-  auto insert(Key&& key, const Value& value) {
-    auto insertion = m_data.insert(std::pair{std::move(key), value});
-    enqueue(insertion.first, insertion.second);
-    return insertion;
+  auto insert(Key&& key, const Value& value,
+              std::optional<std::uint64_t> const cost = {}) {
+    return insert_impl(std::move(key), value, cost);
   }
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-  auto insert(const Key& key, Value&& value) {
-    auto insertion = m_data.insert(std::pair{key, std::move(value)});
-    enqueue(insertion.first, insertion.second);
-    return insertion;
+  auto insert(const Key& key, Value&& value,
+              std::optional<std::uint64_t> const cost = {}) {
+    return insert_impl(key, std::move(value), cost);
   }
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-  auto insert(Key&& key, Value&& value) {
-    auto insertion = m_data.insert(std::pair{std::move(key), std::move(value)});
-    enqueue(insertion.first, insertion.second);
-    return insertion;
+  auto insert(Key&& key, Value&& value,
+              std::optional<std::uint64_t> const cost = {}) {
+    return insert_impl(std::move(key), std::move(value), cost);
   }
   //----------------------------------------------------------------------------
   template <typename... Args>
@@ -118,33 +190,78 @@ class cache {
   auto& operator[](const Key& key) { return at(key); }
   //----------------------------------------------------------------------------
   const auto& at(const Key& key) const {
-    auto it = m_data.find(key);
+    auto it = m_index.at(std::cref(key)).it;
     refresh_usage(it);
     return *it;
   }
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   auto& at(const Key& key) {
-    auto it = m_data.find(key);
+    auto it = m_index.at(std::cref(key)).it;
     refresh_usage(it);
     return *it;
   }
   //----------------------------------------------------------------------------
   std::optional<const_iterator> contains(const Key& key) const {
-    if (auto it = m_data.find(key); it != end(m_data)) {
-      return it;
+    if (auto it = m_index.find(std::cref(key)); it != end(m_index)) {
+      return it->second.it;
     }
     return {};
   }
   //----------------------------------------------------------------------------
   bool is_cached(const Key& key) const {
-    return m_data.find(key) != end(m_data);
+    return m_index.find(std::cref(key)) != end(m_index);
+  }
+  //----------------------------------------------------------------------------
+  /// Removes key from the cache. Returns true if it was cached.
+  bool erase(const Key& key) {
+    if (auto it = m_index.find(std::cref(key)); it != end(m_index)) {
+      erase(it->second.it);
+      return true;
+    }
+    return false;
+  }
+  //----------------------------------------------------------------------------
+  auto size() const { return m_index.size(); }
+  //----------------------------------------------------------------------------
+  auto max_elements() const { return m_max_elements; }
+  auto set_max_elements(uint64_t const max_elements) {
+    m_max_elements = max_elements;
+    capacity_check();
   }
   //----------------------------------------------------------------------------
-  auto size() const { return m_data.size(); }
+  /// Sum of the memory usages of all entries.
+  auto memory_usage() const { return m_memory_usage; }
+  auto max_memory_usage() const { return m_max_memory_usage; }
+  auto set_max_memory_usage(uint64_t const max_memory_usage) {
+    m_max_memory_usage = max_memory_usage;
+    capacity_check();
+  }
+  //----------------------------------------------------------------------------
+  /// Sets the function that computes the memory usage of an entry in bytes.
+  /// Only affects entries inserted afterwards or refreshed with
+  /// refresh_memory_usage.
+  auto set_memory_usage_function(memory_usage_function_type f) {
+    m_memory_usage_function = std::move(f);
+  }
+  //----------------------------------------------------------------------------
+  /// Recomputes the memory usage of an entry whose value has grown or shrunk
+  /// since insertion and evicts other entries if necessary.
+  auto refresh_memory_usage(const Key& key) {
+    auto index_it = m_index.find(std::cref(key));
+    if (index_it == end(m_index)) {
+      return;
+    }
+    auto& [it, mem] = index_it->second;
+    m_memory_usage -= mem;
+    mem = m_memory_usage_function(it->first, it->second);
+    m_memory_usage += mem;
+    capacity_check(it);
+  }
   //----------------------------------------------------------------------------
   void clear() {
-    m_data.clear();
+    m_index.clear();
     m_usage.clear();
+    m_memory_usage = 0;
   }
 };
 
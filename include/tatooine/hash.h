@@ -0,0 +1,25 @@
+#ifndef TATOOINE_HASH_H
+#define TATOOINE_HASH_H
+//==============================================================================
+#include <cstddef>
+#include <functional>
+//==============================================================================
+namespace tatooine {
+//==============================================================================
+/// Mixes the hash of value into seed like boost::hash_combine.
+template <typename T>
+constexpr auto hash_combine(std::size_t& seed, T const& value) -> void {
+  seed ^= std::hash<T>{}(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) +
+          (seed >> 2);
+}
+//------------------------------------------------------------------------------
+template <typename... Ts>
+constexpr auto hash_all(Ts const&... values) {
+  auto seed = std::size_t{};
+  (hash_combine(seed, values), ...);
+  return seed;
+}
+//==============================================================================
+}  // namespace tatooine
+//==============================================================================
+#endif
@@ -13,7 +13,9 @@
 
 #include <boost/range/algorithm/reverse.hpp>
 #include <boost/range/numeric.hpp>
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <memory>
 #include <numeric>
 #include <vector>
@@ -78,6 +80,7 @@ struct property_list : id_holder {
   // FACTORIES
   //============================================================================
   static auto dataset_creation() { return property_list{H5P_DATASET_CREATE}; }
+  static auto dataset_access() { return property_list{H5P_DATASET_ACCESS}; }
 
   //============================================================================
   // CTORS
@@ -85,10 +88,11 @@ struct property_list : id_holder {
  public:
   explicit property_list(hid_t cls_id = H5P_DEFAULT)
       : id_holder{cls_id == H5P_DEFAULT ? H5P_DEFAULT : H5Pcreate(cls_id)} {}
-  property_list(property_list const& other) : id_holder{H5Pcopy(other.id())} {}
+  property_list(property_list const& other)
+      : id_holder{other.is_default() ? H5P_DEFAULT : H5Pcopy(other.id())} {}
   auto operator=(property_list const& other) -> property_list& {
     close();
-    set_id(H5Pcopy(other.id()));
+    set_id(other.is_default() ? H5P_DEFAULT : H5Pcopy(other.id()));
     return *this;
   }
   ~property_list() { close(); }
@@ -96,7 +100,15 @@ struct property_list : id_holder {
   //============================================================================
   // GETTERS
   //============================================================================
-  [[nodiscard]] auto is_default() const { return id() == H5P_DEFAULT; }
+  [[nodiscard]] auto is_default() const -> bool { return id() == H5P_DEFAULT; }
+  //----------------------------------------------------------------------------
+  [[nodiscard]] auto is_chunked() const {
+    return !is_default() && H5Pget_layout(id()) == H5D_CHUNKED;
+  }
+  //----------------------------------------------------------------------------
+  [[nodiscard]] auto num_filters() const {
+    return is_default() ? 0 : H5Pget_nfilters(id());
+  }
 
   //============================================================================
   // METHODS
@@ -107,9 +119,51 @@ struct property_list : id_holder {
     }
   }
   //----------------------------------------------------------------------------
+  // DATASET CREATION
+  //----------------------------------------------------------------------------
+  /// Sizes are given in the same order as the resolution of a dataspace.
   auto set_chunk(integral auto const... size) {
-    auto dim = std::array{static_cast<hsize_t>(size)...};
-    H5Pset_chunk(id(), sizeof...(size), dim.data());
+    set_chunk(std::vector{static_cast<hsize_t>(size)...});
+  }
+  //----------------------------------------------------------------------------
+  auto set_chunk(std::vector<hsize_t> size) {
+    H5Pset_chunk(id(), static_cast<int>(size.size()),
+                 boost::reverse(size).data());
+  }
+  //----------------------------------------------------------------------------
+  /// Compresses every chunk with gzip. level is in [0, 9].
+  auto set_deflate(unsigned int const level = 6) {
+    H5Pset_deflate(id(), level);
+  }
+  //----------------------------------------------------------------------------
+  /// Groups the bytes of all values in a chunk by significance which lets
+  /// deflate compress floating point data much better. Must be set before
+  /// set_deflate.
+  auto set_shuffle() { H5Pset_shuffle(id()); }
+  //----------------------------------------------------------------------------
+  /// Only available if the HDF5 library was built with szip.
+  auto set_szip(unsigned int const options_mask     = H5_SZIP_NN_OPTION_MASK,
+                unsigned int const pixels_per_block = 16) {
+    H5Pset_szip(id(), options_mask, pixels_per_block);
+  }
+  //----------------------------------------------------------------------------
+  /// Lossy for floating point data with H5Z_SO_FLOAT_DSCALE where
+  /// scale_factor is the number of kept decimal digits. Integer data with
+  /// H5Z_SO_INT and H5Z_SO_INT_MINBITS_DEFAULT is stored losslessly.
+  auto set_scaleoffset(H5Z_SO_scale_type_t const scale_type,
+                       int const                 scale_factor) {
+    H5Pset_scaleoffset(id(), scale_type, scale_factor);
+  }
+  //----------------------------------------------------------------------------
+  // DATASET ACCESS
+  //----------------------------------------------------------------------------
+  /// The raw data chunk cache of a dataset has to hold all chunks that are
+  /// touched by a read or they are decompressed again on every read.
+  /// num_slots should be a prime number about 100 times the number of chunks
+  /// that fit into num_bytes.
+  auto set_chunk_cache(std::size_t const num_slots, std::size_t const num_bytes,
+                       double const preemption_policy = 0.75) {
+    H5Pset_chunk_cache(id(), num_slots, num_bytes, preemption_policy);
   }
 };
 //==============================================================================
@@ -364,14 +418,26 @@ struct dataset : id_holder, attribute_creator<dataset<T>> {
  public:
   using this_type     = dataset<T>;
   using value_type = T;
+  /// Maximal chunk extent per dimension if filters are requested without
+  /// specifying chunks.
+  static constexpr auto default_chunk_size = hsize_t{64};
 
  private:
   hid_t       m_parent_id;
   std::string m_name;
   //============================================================================
  public:
-  template <typename... Size>
+  template <integral... Size>
   dataset(hid_t const parent_id, std::string const& name, Size const... size)
+      : dataset{parent_id, name, property_list{}, property_list{}, size...} {}
+  //----------------------------------------------------------------------------
+  /// Creates the dataset if size is given and opens it otherwise.
+  /// Chunks are chosen automatically if creation_properties contain filters
+  /// but no chunks.
+  template <integral... Size>
+  dataset(hid_t const parent_id, std::string const& name,
+          property_list const& creation_properties,
+          property_list const& access_properties, Size const... size)
       : id_holder{-1}, m_parent_id{parent_id}, m_name{name} {
     if constexpr (sizeof...(Size) > 0) {
       auto dims                    = std::array{static_cast<hsize_t>(size)...};
@@ -382,7 +448,7 @@ struct dataset : id_holder, attribute_creator<dataset<T>> {
           break;
         }
       }
-      auto plist   = property_list{};
+      auto plist   = creation_properties;
       auto maxdims = dims;
       if (has_unlimited_dimension) {
         for (auto& dim : dims) {
@@ -390,49 +456,91 @@ struct dataset : id_holder, attribute_creator<dataset<T>> {
             dim = 0;
           }
         }
-        plist = property_list::dataset_creation();
+      }
+      if ((has_unlimited_dimension || plist.num_filters() > 0) &&
+          !plist.is_chunked()) {
+        if (plist.is_default()) {
+          plist = property_list::dataset_creation();
+        }
+        auto const filtered = plist.num_filters() > 0;
         plist.set_chunk(
-            (static_cast<hsize_t>(size) == unlimited ? 100 : size)...);
+            (static_cast<hsize_t>(size) == unlimited ? hsize_t{100}
+             : filtered ? std::clamp<hsize_t>(static_cast<hsize_t>(size), 1,
+                                              default_chunk_size)
+                        : static_cast<hsize_t>(size))...);
       }
       auto ds = hdf5::dataspace{dims, maxdims};
       set_id(H5Dcreate(parent_id, name.data(), type_id<T>(), ds.id(),
-                       H5P_DEFAULT, plist.id(), H5P_DEFAULT));
+                       H5P_DEFAULT, plist.id(), access_properties.id()));
       if (id() < 0) {
-        set_id(H5Dopen(m_parent_id, name.c_str(), H5P_DEFAULT));
+        set_id(H5Dopen(m_parent_id, name.c_str(), access_properties.id()));
         resize(size...);
       }
     } else {
-      set_id(H5Dopen(m_parent_id, name.c_str(), H5P_DEFAULT));
+      set_id(H5Dopen(m_parent_id, name.c_str(), access_properties.id()));
     }
   }
   //----------------------------------------------------------------------------
+  /// Copies share the HDF5 dataset which stays open until all copies are
+  /// destroyed.
   dataset(dataset const& other)
       : id_holder{other.id()},
         m_parent_id{other.m_parent_id},
-        m_name{other.m_name} {}
+        m_name{other.m_name} {
+    if (id() != H5I_INVALID_HID) {
+      H5Iinc_ref(id());
+    }
+  }
   //----------------------------------------------------------------------------
-  dataset(dataset&&) noexcept = default;
+  /// Takes over the dataset. other does not refer to any dataset anymore.
+  dataset(dataset&& other) noexcept
+      : id_holder{other.id()},
+        m_parent_id{other.m_parent_id},
+        m_name{std::move(other.m_name)} {
+    other.set_id(H5I_INVALID_HID);
+  }
   //----------------------------------------------------------------------------
   auto operator=(dataset const& other) -> dataset& {
     // if (m_parent_id != nullptr) {
     //  H5Fclose(m_parent_id);
     //}
-    H5Dclose(id());
+    if (other.id() != H5I_INVALID_HID) {
+      H5Iinc_ref(other.id());
+    }
+    close();
     set_id(other.id());
     m_parent_id = other.m_parent_id;
     m_name      = other.m_name;
     return *this;
   }
   //----------------------------------------------------------------------------
-  auto operator=(dataset&&) noexcept -> dataset& = default;
+  auto operator=(dataset&& other) noexcept -> dataset& {
+    if (&other != this) {
+      close();
+      set_id(other.id());
+      other.set_id(H5I_INVALID_HID);
+      m_parent_id = other.m_parent_id;
+      m_name      = std::move(other.m_name);
+    }
+    return *this;
+  }
   //----------------------------------------------------------------------------
   ~dataset() {
     // if (m_parent_id != nullptr) {
     //  H5Fclose(m_parent_id);
     //}
-    H5Dclose(id());
+    close();
   }
   //============================================================================
+ private:
+  auto close() {
+    if (id() != H5I_INVALID_HID) {
+      H5Dclose(id());
+    }
+  }
+  //----------------------------------------------------------------------------
+ public:
+  //============================================================================
   auto resize(hsize_t const extent) { H5Dset_extent(id(), &extent); }
   //----------------------------------------------------------------------------
   auto resize(std::vector<hsize_t> const& extent) {
@@ -723,22 +831,19 @@ struct dataset : id_holder, attribute_creator<dataset<T>> {
         count_without_ones.push_back(count[i]);
       }
     }
-    std::size_t num_dimensions = 0;
+    // arrays whose sizes only differ in ones (e.g. chunks at the border of a
+    // lazy_reader) keep their shape
+    std::vector<hsize_t> arr_size_without_ones;
     for (std::size_t i = 0; i < arr.num_dimensions(); ++i) {
       if (arr.size(i) > 1) {
-        ++num_dimensions;
+        arr_size_without_ones.push_back(arr.size(i));
       }
     }
 
-    if (rank != num_dimensions) {
+    if (rank != arr_size_without_ones.size()) {
       arr.resize(count);
-    } else {
-      for (std::size_t i = 0; i < rank; ++i) {
-        if (arr.size(i) != count_without_ones[i]) {
-          arr.resize(count_without_ones);
-          break;
-        }
-      }
+    } else if (arr_size_without_ones != count_without_ones) {
+      arr.resize(count_without_ones);
     }
     ds.select_hyperslab(offset, count);
     auto memory_space = hdf5::dataspace{count};
@@ -777,6 +882,9 @@ struct dataset : id_holder, attribute_creator<dataset<T>> {
   auto flush() { H5Dflush(id()); }
   //----------------------------------------------------------------------------
   auto size() const { return dataspace().current_resolution(); }
+  //----------------------------------------------------------------------------
+  /// Number of bytes the possibly compressed data occupies in the file.
+  auto storage_size() const { return H5Dget_storage_size(id()); }
 };
 //==============================================================================
 template <typename IDHolder>
@@ -790,6 +898,33 @@ struct dataset_creator {
     return hdf5::dataset<T>{as_id_holder().id(), name, size...};
   }
   //----------------------------------------------------------------------------
+  /// Creates a dataset with filters, chunks and access properties, e.g.:
+  /// \code
+  /// auto creation = hdf5::property_list::dataset_creation();
+  /// creation.set_chunk(64, 64, 64);
+  /// creation.set_shuffle();
+  /// creation.set_deflate(4);
+  /// auto ds = f.create_dataset<double>("data", creation, 512, 512, 512);
+  /// \endcode
+  template <typename T, typename IndexOrder = x_fastest>
+  auto create_dataset(std::string const&   name,
+                      property_list const& creation_properties,
+                      integral auto const... size) {
+    return create_dataset<T, IndexOrder>(name, creation_properties,
+                                         property_list{}, size...);
+  }
+  //----------------------------------------------------------------------------
+  /// Same as above but additionally with access properties such as
+  /// property_list::dataset_access() with a custom chunk cache.
+  template <typename T, typename IndexOrder = x_fastest>
+  auto create_dataset(std::string const&   name,
+                      property_list const& creation_properties,
+                      property_list const& access_properties,
+                      integral auto const... size) {
+    return hdf5::dataset<T>{as_id_holder().id(), name, creation_properties,
+                            access_properties, size...};
+  }
+  //----------------------------------------------------------------------------
   template <typename T>
   [[nodiscard]] auto dataset(char const* name) const {
     return hdf5::dataset<T>{as_id_holder().id(), name};
@@ -799,6 +934,13 @@ struct dataset_creator {
   [[nodiscard]] auto dataset(std::string const& name) const {
     return dataset<T>(name.c_str());
   }
+  //----------------------------------------------------------------------------
+  template <typename T>
+  [[nodiscard]] auto dataset(std::string const&   name,
+                             property_list const& access_properties) const {
+    return hdf5::dataset<T>{as_id_holder().id(), name, property_list{},
+                            access_properties};
+  }
 };
 //==============================================================================
 struct group;
@@ -3,11 +3,39 @@
 //==============================================================================
 #include <tatooine/chunked_multidim_array.h>
 #include <tatooine/index_order.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <limits>
 #include <mutex>
 #include <map>
+#include <thread>
+#include <utility>
 //==============================================================================
 namespace tatooine {
 //==============================================================================
+/// Reads chunks of a data set on demand and keeps them in a bounded cache.
+///
+/// Loaded chunks are managed with the CLOCK algorithm: every access sets a
+/// reference flag of the chunk without taking a global lock. When the number
+/// of loaded chunks or the memory used by them exceeds the configured budget
+/// the clock hand sweeps over the loaded chunks, gives referenced chunks a
+/// second chance and evicts the first unreferenced chunk that is not
+/// currently in use by another thread.
+///
+/// Without a budget chunks are never evicted and references returned by at()
+/// stay valid as long as the reader. With a budget a chunk may be evicted as
+/// soon as at() returns. operator() and value_at() return copies and are
+/// always safe. References returned by at() are only guaranteed to stay valid
+/// while a guard returned by pin() is alive: evicted chunks are retired and
+/// freed when the last guard is released. Vertex properties of grids and
+/// their samplers only read through value_at().
+///
+/// Optionally a pool of I/O threads prefetches the next chunks along the
+/// direction in which the chunk structure is traversed, up to a configurable
+/// radius. With a budget at most half of it is used for prefetched chunks.
 template <typename DataSet, typename GlobalIndexOrder = x_fastest,
           typename LocalIndexOrder = GlobalIndexOrder>
 struct lazy_reader
@@ -17,6 +45,8 @@ struct lazy_reader
   using parent_type   = chunked_multidim_array<value_type, GlobalIndexOrder, LocalIndexOrder>;
   using parent_type::chunk_at;
 
+  static constexpr auto not_loaded = std::numeric_limits<std::size_t>::max();
+
   static auto default_value() -> value_type& {
     static value_type t{};
     return t;
@@ -24,12 +54,45 @@ struct lazy_reader
 
  private:
   DataSet                     m_dataset;
-  mutable std::vector<bool>   m_read;
   std::size_t                      m_max_num_chunks_loaded   = 1024;
   bool                        m_limit_num_chunks_loaded = false;
+  std::size_t                 m_max_memory_usage        = 0;
   mutable std::mutex          m_chunks_loaded_mutex;
+  // loaded chunks in clock order. guarded by m_chunks_loaded_mutex
   mutable std::vector<std::size_t> m_chunks_loaded;
+  // position of each chunk in m_chunks_loaded or not_loaded. guarded by
+  // m_chunks_loaded_mutex
+  mutable std::vector<std::size_t> m_chunk_positions;
+  // CLOCK reference flags. only accessed through std::atomic_ref
+  mutable std::vector<std::uint8_t> m_referenced;
+  mutable std::size_t              m_clock_hand   = 0;
+  mutable std::size_t              m_memory_usage = 0;
+  mutable std::atomic_size_t       m_num_hits      = 0;
+  mutable std::atomic_size_t       m_num_misses    = 0;
+  mutable std::atomic_size_t       m_num_evictions = 0;
   mutable std::vector<std::unique_ptr<std::mutex>> m_mutexes;
+  // number of alive pin_guards and chunks evicted while at least one of them
+  // was alive. guarded by m_chunks_loaded_mutex
+  mutable std::size_t                                    m_num_pins = 0;
+  mutable std::vector<typename parent_type::chunk_ptr_t> m_retired_chunks;
+
+  std::size_t m_prefetch_radius         = 1;
+  std::size_t m_max_prefetch_queue_size = 256;
+  // chunks queued for prefetching. guarded by m_prefetch_mutex
+  mutable std::deque<std::size_t>   m_prefetch_queue;
+  mutable std::vector<std::uint8_t> m_prefetch_queued;
+  // chunk indices of the last prefetch origin to detect the access direction.
+  // guarded by m_prefetch_mutex
+  mutable std::vector<std::size_t> m_last_prefetch_origin;
+  bool                              m_stop_prefetching = false;
+  mutable std::mutex                m_prefetch_mutex;
+  mutable std::condition_variable   m_prefetch_condition;
+  std::vector<std::thread>          m_prefetch_threads;
+  // set for chunks that were loaded by prefetching and not accessed yet. only
+  // accessed through std::atomic_ref
+  mutable std::vector<std::uint8_t> m_prefetched;
+  mutable std::atomic_size_t        m_num_prefetched     = 0;
+  mutable std::atomic_size_t        m_num_prefetch_hits  = 0;
 
  public:
   lazy_reader(DataSet const& file, std::vector<std::size_t> const& chunk_size)
@@ -41,19 +104,31 @@ struct lazy_reader
   lazy_reader(lazy_reader const& other)
       : parent_type{other},
         m_dataset{other.m_dataset},
-        m_read{other.m_read}
-        //, m_max_num_chunks_loaded{other.m_max_num_chunks_loaded}
-        //, m_limit_num_chunks_loaded{other.m_limit_num_chunks_loaded}
-  {
+        m_max_num_chunks_loaded{other.m_max_num_chunks_loaded},
+        m_limit_num_chunks_loaded{other.m_limit_num_chunks_loaded},
+        m_max_memory_usage{other.m_max_memory_usage},
+        m_prefetch_radius{other.m_prefetch_radius},
+        m_max_prefetch_queue_size{other.m_max_prefetch_queue_size} {
     create_mutexes();
+    create_clock();
+    for (std::size_t i = 0; i < this->num_chunks(); ++i) {
+      if (!this->chunk_at_is_null(i)) {
+        register_chunk(i);
+      }
+    }
+    if (other.is_prefetching()) {
+      start_prefetching(other.m_prefetch_threads.size(), m_prefetch_radius);
+    }
   }
   //----------------------------------------------------------------------------
+  ~lazy_reader() { stop_prefetching(); }
+  //----------------------------------------------------------------------------
  private:
   auto init(std::vector<std::size_t> const& chunk_size) -> void {
     auto s = m_dataset.size();
     this->resize(s, chunk_size);
-    m_read.resize(this->num_chunks(), false);
     create_mutexes();
+    create_clock();
   }
   //----------------------------------------------------------------------------
   auto create_mutexes() {
@@ -63,6 +138,104 @@ struct lazy_reader
     }
   }
   //----------------------------------------------------------------------------
+  auto create_clock() {
+    m_chunks_loaded.clear();
+    m_chunks_loaded.reserve(this->num_chunks());
+    m_chunk_positions.assign(this->num_chunks(), not_loaded);
+    m_referenced.assign(this->num_chunks(), 0);
+    m_prefetched.assign(this->num_chunks(), 0);
+    m_prefetch_queued.assign(this->num_chunks(), 0);
+    m_last_prefetch_origin.clear();
+    m_clock_hand   = 0;
+    m_memory_usage = 0;
+  }
+  //----------------------------------------------------------------------------
+  auto chunk_memory_usage(std::size_t const plain_chunk_index) const {
+    return this->chunk_at(plain_chunk_index)->num_components() *
+           sizeof(value_type);
+  }
+  //----------------------------------------------------------------------------
+  auto mark_referenced(std::size_t const plain_chunk_index) const {
+    std::atomic_ref{m_referenced[plain_chunk_index]}.store(
+        1, std::memory_order_relaxed);
+  }
+  //----------------------------------------------------------------------------
+  /// Needs m_chunks_loaded_mutex to be locked.
+  auto register_chunk(std::size_t const plain_chunk_index) const {
+    m_chunk_positions[plain_chunk_index] = m_chunks_loaded.size();
+    m_chunks_loaded.push_back(plain_chunk_index);
+    m_memory_usage += chunk_memory_usage(plain_chunk_index);
+    mark_referenced(plain_chunk_index);
+  }
+  //----------------------------------------------------------------------------
+  /// Needs m_chunks_loaded_mutex and the mutex of the chunk to be locked.
+  auto unregister_chunk(std::size_t const plain_chunk_index) const {
+    auto const pos = m_chunk_positions[plain_chunk_index];
+    auto const last = m_chunks_loaded.back();
+    m_chunks_loaded[pos]    = last;
+    m_chunk_positions[last] = pos;
+    m_chunks_loaded.pop_back();
+    m_chunk_positions[plain_chunk_index] = not_loaded;
+    m_memory_usage -= chunk_memory_usage(plain_chunk_index);
+    std::atomic_ref{m_prefetched[plain_chunk_index]}.store(
+        0, std::memory_order_relaxed);
+    if (m_num_pins == 0) {
+      this->destroy_chunk_at(plain_chunk_index);
+      return;
+    }
+    m_retired_chunks.push_back(std::move(this->m_chunks[plain_chunk_index]));
+  }
+  //----------------------------------------------------------------------------
+  auto add_pin() const {
+    auto chunks_loaded_lock = std::lock_guard{m_chunks_loaded_mutex};
+    ++m_num_pins;
+  }
+  //----------------------------------------------------------------------------
+  auto remove_pin() const {
+    auto chunks_loaded_lock = std::lock_guard{m_chunks_loaded_mutex};
+    if (--m_num_pins == 0) {
+      m_retired_chunks.clear();
+    }
+  }
+  //----------------------------------------------------------------------------
+  auto exceeds_budget() const {
+    return (m_limit_num_chunks_loaded &&
+            m_chunks_loaded.size() > m_max_num_chunks_loaded) ||
+           (m_max_memory_usage > 0 && m_memory_usage > m_max_memory_usage);
+  }
+  //----------------------------------------------------------------------------
+  /// Evicts chunks until the budget is met. Chunks whose mutexes are held by
+  /// other threads are skipped so that this never blocks. If every loaded
+  /// chunk is in use the budget is exceeded temporarily.
+  ///
+  /// Needs m_chunks_loaded_mutex to be locked. The chunk keep must not be
+  /// evicted because the calling thread owns its mutex.
+  auto evict_until_within_budget(std::size_t const keep = not_loaded) const {
+    // two sweeps clear all reference flags and visit every chunk once more
+    auto num_visits_left = 2 * m_chunks_loaded.size();
+    while (exceeds_budget() && num_visits_left-- > 0) {
+      if (m_clock_hand >= m_chunks_loaded.size()) {
+        m_clock_hand = 0;
+      }
+      auto const candidate = m_chunks_loaded[m_clock_hand];
+      if (candidate == keep ||
+          std::atomic_ref{m_referenced[candidate]}.exchange(
+              0, std::memory_order_relaxed) != 0) {
+        ++m_clock_hand;
+        continue;
+      }
+      auto lock = std::unique_lock{*m_mutexes[candidate], std::try_to_lock};
+      if (!lock.owns_lock()) {
+        ++m_clock_hand;
+        continue;
+      }
+      // the last loaded chunk moves to the clock hand's position and will be
+      // visited next
+      unregister_chunk(candidate);
+      ++m_num_evictions;
+    }
+  }
+  //----------------------------------------------------------------------------
   auto read_chunk(std::size_t const plain_chunk_index, integral auto const... indices) const
       -> auto const& {
 #ifndef NDEBUG
@@ -81,32 +254,206 @@ struct lazy_reader
     assert(sizeof...(indices) == this->num_dimensions());
     assert(this->in_range(indices...));
 
-    if (this->chunk_at_is_null(plain_chunk_index) && !m_read[plain_chunk_index]) {
-      {
-        auto chunks_loaded_lock = std::lock_guard{m_chunks_loaded_mutex};
-        m_chunks_loaded.push_back(plain_chunk_index);
-        //if (m_limit_num_chunks_loaded &&
-        //    num_chunks_loaded() > m_max_num_chunks_loaded) {
-        //  // TODO reimplement
-        //}
+    if (!this->chunk_at_is_null(plain_chunk_index)) {
+      ++m_num_hits;
+      mark_referenced(plain_chunk_index);
+      if (std::atomic_ref{m_prefetched[plain_chunk_index]}.exchange(
+              0, std::memory_order_relaxed) != 0) {
+        // the access pattern reached a prefetched chunk so keep on going
+        ++m_num_prefetch_hits;
+        prefetch_neighbors(plain_chunk_index);
       }
+      return this->chunk_at(plain_chunk_index);
+    }
+    ++m_num_misses;
+    auto const chunk_indices =
+        this->chunk_indices_from_global_indices(indices...);
+    load_chunk(plain_chunk_index, chunk_indices);
+    prefetch_neighbors(plain_chunk_index, chunk_indices);
 
-      this->create_chunk_at(plain_chunk_index);
-      auto& chunk               = *this->chunk_at(plain_chunk_index);
-      m_read[plain_chunk_index] = true;
-      auto const offset         = this->global_indices_from_chunk_indices(
-          this->chunk_indices_from_global_indices(indices...));
-      for (std::size_t i = 0; i < offset.size(); ++i) {
-        assert(offset[i] + chunk.size()[i] <= this->size()[i]);
+    return this->chunk_at(plain_chunk_index);
+  }
+  //----------------------------------------------------------------------------
+  /// Needs the mutex of the chunk to be locked.
+  auto load_chunk(std::size_t const               plain_chunk_index,
+                  std::vector<std::size_t> const& chunk_indices) const {
+    this->create_chunk_at(plain_chunk_index);
+    auto&      chunk  = *this->chunk_at(plain_chunk_index);
+    auto const offset = this->global_indices_from_chunk_indices(chunk_indices);
+    for (std::size_t i = 0; i < offset.size(); ++i) {
+      assert(offset[i] + chunk.size()[i] <= this->size()[i]);
+    }
+    m_dataset.read(offset, chunk.size(), chunk);
+    auto chunks_loaded_lock = std::lock_guard{m_chunks_loaded_mutex};
+    register_chunk(plain_chunk_index);
+    evict_until_within_budget(plain_chunk_index);
+  }
+  //----------------------------------------------------------------------------
+  auto prefetch_neighbors(std::size_t const plain_chunk_index) const {
+    if (is_prefetching()) {
+      prefetch_neighbors(
+          plain_chunk_index,
+          this->chunk_indices_from_plain_chunk_index(plain_chunk_index));
+    }
+  }
+  //----------------------------------------------------------------------------
+  /// Maximum number of chunks that may wait for prefetching. With a budget
+  /// at most half of it is spent on prefetched chunks so that they do not
+  /// evict the chunks that are currently worked on.
+  auto max_num_queued_prefetches() const {
+    auto max_num_queued = m_max_prefetch_queue_size;
+    auto chunks_loaded_lock = std::lock_guard{m_chunks_loaded_mutex};
+    if (m_limit_num_chunks_loaded) {
+      max_num_queued = std::min(max_num_queued, m_max_num_chunks_loaded / 2);
+    }
+    if (m_max_memory_usage > 0) {
+      auto full_chunk_memory_usage = sizeof(value_type);
+      for (auto const s : this->internal_chunk_size()) {
+        full_chunk_memory_usage *= s;
       }
-      m_dataset.read(offset, chunk.size(), chunk);
-
+      max_num_queued = std::min(
+          max_num_queued, m_max_memory_usage / (2 * full_chunk_memory_usage));
+    }
+    return max_num_queued;
+  }
+  //----------------------------------------------------------------------------
+  /// Needs m_prefetch_mutex to be locked.
+  auto queue_prefetch(std::vector<std::size_t> const& chunk_indices,
+                      std::size_t const               max_num_queued) const {
+    auto const n = this->plain_chunk_index_from_chunk_indices(chunk_indices);
+    if (m_prefetch_queued[n] != 0) {
+      return;
+    }
+    m_prefetch_queued[n] = 1;
+    m_prefetch_queue.push_back(n);
+    if (m_prefetch_queue.size() > max_num_queued) {
+      m_prefetch_queued[m_prefetch_queue.front()] = 0;
+      m_prefetch_queue.pop_front();
+    }
+  }
+  //----------------------------------------------------------------------------
+  /// Queues the next prefetch radius many chunks along the direction in which
+  /// the chunk structure was traversed since the last call. Without a
+  /// direction only the direct neighbors along each axis are queued.
+  auto prefetch_neighbors(std::size_t const /*plain_chunk_index*/,
+                          std::vector<std::size_t> const& chunk_indices) const {
+    if (!is_prefetching() || m_prefetch_radius == 0) {
+      return;
+    }
+    auto const max_num_queued = max_num_queued_prefetches();
+    if (max_num_queued == 0) {
+      return;
     }
+    auto const num_dims  = chunk_indices.size();
+    auto const r         = static_cast<std::ptrdiff_t>(m_prefetch_radius);
+    auto       direction = std::vector<std::ptrdiff_t>(num_dims, 0);
+    auto       neighbor  = std::vector<std::size_t>(num_dims);
+    // writes chunk_indices + k * dir to neighbor if it is in range
+    auto const step = [&](std::vector<std::ptrdiff_t> const& dir,
+                          std::ptrdiff_t const               k) {
+      for (std::size_t i = 0; i < num_dims; ++i) {
+        auto const n = static_cast<std::ptrdiff_t>(chunk_indices[i]) + k * dir[i];
+        if (n < 0 || n >= static_cast<std::ptrdiff_t>(this->chunk_size(i))) {
+          return false;
+        }
+        neighbor[i] = static_cast<std::size_t>(n);
+      }
+      return true;
+    };
 
-    return this->chunk_at(plain_chunk_index);
+    auto lock          = std::lock_guard{m_prefetch_mutex};
+    auto has_direction = false;
+    if (m_last_prefetch_origin.size() == num_dims) {
+      for (std::size_t i = 0; i < num_dims; ++i) {
+        direction[i] = (chunk_indices[i] > m_last_prefetch_origin[i]) -
+                       (chunk_indices[i] < m_last_prefetch_origin[i]);
+        has_direction |= direction[i] != 0;
+      }
+    }
+    m_last_prefetch_origin = chunk_indices;
+    if (has_direction) {
+      // the queue is processed from the back so the nearest chunk goes last
+      for (auto k = r; k > 0; --k) {
+        if (step(direction, k)) {
+          queue_prefetch(neighbor, max_num_queued);
+        }
+      }
+    } else {
+      for (std::size_t i = 0; i < num_dims; ++i) {
+        direction[i] = 1;
+        for (auto const k : {std::ptrdiff_t{-1}, std::ptrdiff_t{1}}) {
+          if (step(direction, k)) {
+            queue_prefetch(neighbor, max_num_queued);
+          }
+        }
+        direction[i] = 0;
+      }
+    }
+    m_prefetch_condition.notify_all();
+  }
+  //----------------------------------------------------------------------------
+  auto prefetch_chunk(std::size_t const plain_chunk_index) const {
+    // a chunk that is locked is being read by another thread anyway
+    auto lock =
+        std::unique_lock{*m_mutexes[plain_chunk_index], std::try_to_lock};
+    if (!lock.owns_lock() || !this->chunk_at_is_null(plain_chunk_index)) {
+      return;
+    }
+    load_chunk(plain_chunk_index,
+               this->chunk_indices_from_plain_chunk_index(plain_chunk_index));
+    std::atomic_ref{m_prefetched[plain_chunk_index]}.store(
+        1, std::memory_order_relaxed);
+    ++m_num_prefetched;
+  }
+  //----------------------------------------------------------------------------
+  auto prefetch_loop() const {
+    while (true) {
+      auto plain_chunk_index = std::size_t{};
+      {
+        auto lock = std::unique_lock{m_prefetch_mutex};
+        m_prefetch_condition.wait(lock, [this] {
+          return m_stop_prefetching || !m_prefetch_queue.empty();
+        });
+        if (m_stop_prefetching) {
+          return;
+        }
+        // most recently requested chunks first
+        plain_chunk_index = m_prefetch_queue.back();
+        m_prefetch_queue.pop_back();
+        m_prefetch_queued[plain_chunk_index] = 0;
+      }
+      prefetch_chunk(plain_chunk_index);
+    }
   }
   //----------------------------------------------------------------------------
  public:
+  /// Keeps chunks that are evicted during its lifetime alive so that
+  /// references returned by at() stay valid. Retired chunks are freed when the
+  /// last guard is released and are not accounted for in memory_usage().
+  struct pin_guard {
+   private:
+    this_type const* m_reader;
+
+   public:
+    explicit pin_guard(this_type const& reader) : m_reader{&reader} {
+      m_reader->add_pin();
+    }
+    pin_guard(pin_guard const&) = delete;
+    pin_guard(pin_guard&& other) noexcept
+        : m_reader{std::exchange(other.m_reader, nullptr)} {}
+    auto operator=(pin_guard const&) -> pin_guard& = delete;
+    auto operator=(pin_guard&&) noexcept -> pin_guard& = delete;
+    ~pin_guard() {
+      if (m_reader != nullptr) {
+        m_reader->remove_pin();
+      }
+    }
+  };
+  //----------------------------------------------------------------------------
+  [[nodiscard]] auto pin() const { return pin_guard{*this}; }
+  //----------------------------------------------------------------------------
+  /// Returns a reference into the chunk holding the value. If a budget is set
+  /// the reference is only guaranteed to be valid while a pin_guard is alive.
   auto at(integral auto const... indices) const -> value_type const& {
     auto const      plain_chunk_index =
         this->plain_chunk_index_from_global_indices(indices...);
@@ -134,9 +481,36 @@ struct lazy_reader
     return at(indices, std::make_index_sequence<N>{});
   }
   //----------------------------------------------------------------------------
-  auto operator()(integral auto const... indices) const -> value_type const& {
+  /// Copies the value while the chunk is locked so that it cannot be evicted
+  /// in between.
+  auto value_at(integral auto const... indices) const -> value_type {
+    auto const plain_chunk_index =
+        this->plain_chunk_index_from_global_indices(indices...);
+    auto        lock  = std::lock_guard{*m_mutexes[plain_chunk_index]};
+    auto const& chunk = read_chunk(plain_chunk_index, indices...);
+    if (chunk == nullptr) {
+      return default_value();
+    }
+    return (*chunk)[this->plain_internal_chunk_index_from_global_indices(
+        plain_chunk_index, indices...)];
+  }
+
+ private:
+  template <integral Index, std::size_t N, std::size_t... Seq>
+  auto value_at(std::array<Index, N> const& indices,
+                std::index_sequence<Seq...> /*seq*/) const -> value_type {
+    return value_at(indices[Seq]...);
+  }
+
+ public:
+  template <integral Index, std::size_t N>
+  auto value_at(std::array<Index, N> const& indices) const -> value_type {
+    return value_at(indices, std::make_index_sequence<N>{});
+  }
+  //----------------------------------------------------------------------------
+  auto operator()(integral auto const... indices) const -> value_type {
     assert(sizeof...(indices) == this->num_dimensions());
-    return at(indices...);
+    return value_at(indices...);
   }
   //----------------------------------------------------------------------------
   auto is_chunk_filled_with_value(std::size_t const      plain_chunk_index,
@@ -155,24 +529,143 @@ struct lazy_reader
     return is_chunk_filled_with_value(plain_chunk_index, 0);
   }
   //----------------------------------------------------------------------------
-  auto set_max_num_chunks_loaded(std::size_t const /*max_num_chunks_loaded*/) {
-    //limit_num_chunks_loaded();
-    //m_max_num_chunks_loaded = max_num_chunks_loaded;
+  /// Limits the number of chunks that are kept in memory.
+  auto set_max_num_chunks_loaded(std::size_t const max_num_chunks_loaded) {
+    auto chunks_loaded_lock = std::lock_guard{m_chunks_loaded_mutex};
+    m_limit_num_chunks_loaded = true;
+    m_max_num_chunks_loaded   = max_num_chunks_loaded;
+    evict_until_within_budget();
   }
   //----------------------------------------------------------------------------
-  auto limit_num_chunks_loaded(bool const /*l*/ = true) {
-    //m_limit_num_chunks_loaded = l;
+  auto max_num_chunks_loaded() const { return m_max_num_chunks_loaded; }
+  //----------------------------------------------------------------------------
+  auto limit_num_chunks_loaded(bool const l = true) {
+    auto chunks_loaded_lock = std::lock_guard{m_chunks_loaded_mutex};
+    m_limit_num_chunks_loaded = l;
+    evict_until_within_budget();
+  }
+  //----------------------------------------------------------------------------
+  /// Limits the number of bytes that loaded chunks may occupy. 0 means no
+  /// limit.
+  auto set_max_memory_usage(std::size_t const max_memory_usage) {
+    auto chunks_loaded_lock = std::lock_guard{m_chunks_loaded_mutex};
+    m_max_memory_usage = max_memory_usage;
+    evict_until_within_budget();
+  }
+  //----------------------------------------------------------------------------
+  auto max_memory_usage() const { return m_max_memory_usage; }
+  //----------------------------------------------------------------------------
+  /// Number of evicted chunks that are kept alive by pin_guards.
+  auto num_retired_chunks() const {
+    auto chunks_loaded_lock = std::lock_guard{m_chunks_loaded_mutex};
+    return m_retired_chunks.size();
+  }
+  //----------------------------------------------------------------------------
+  /// Number of bytes occupied by currently loaded chunks.
+  auto memory_usage() const {
+    auto chunks_loaded_lock = std::lock_guard{m_chunks_loaded_mutex};
+    return m_memory_usage;
   }
   //----------------------------------------------------------------------------
   auto num_chunks_loaded() const {
+    auto chunks_loaded_lock = std::lock_guard{m_chunks_loaded_mutex};
     return size(m_chunks_loaded);
   }
   //----------------------------------------------------------------------------
+  /// Indices of loaded chunks in clock order. Must not be called while other
+  /// threads access the reader.
   auto chunks_loaded() const -> auto const& { return m_chunks_loaded; }
   //----------------------------------------------------------------------------
   auto chunk_is_loaded(std::size_t const plain_chunk_index) const {
-    return std::find(begin(m_chunks_loaded), end(m_chunks_loaded),
-                     plain_chunk_index) != end(m_chunks_loaded);
+    auto chunks_loaded_lock = std::lock_guard{m_chunks_loaded_mutex};
+    return m_chunk_positions[plain_chunk_index] != not_loaded;
+  }
+  //----------------------------------------------------------------------------
+  /// Number of accesses that found their chunk already loaded.
+  auto num_hits() const { return m_num_hits.load(); }
+  //----------------------------------------------------------------------------
+  /// Number of accesses that had to read their chunk from the data set.
+  auto num_misses() const { return m_num_misses.load(); }
+  //----------------------------------------------------------------------------
+  auto num_evictions() const { return m_num_evictions.load(); }
+  //----------------------------------------------------------------------------
+  auto hit_rate() const {
+    auto const hits     = num_hits();
+    auto const accesses = hits + num_misses();
+    return accesses == 0 ? 0.0
+                         : static_cast<double>(hits) /
+                               static_cast<double>(accesses);
+  }
+  //----------------------------------------------------------------------------
+  /// Number of chunks loaded by the prefetching threads.
+  auto num_prefetched() const { return m_num_prefetched.load(); }
+  //----------------------------------------------------------------------------
+  /// Number of prefetched chunks that were accessed before being evicted.
+  auto num_prefetch_hits() const { return m_num_prefetch_hits.load(); }
+  //----------------------------------------------------------------------------
+  auto prefetch_hit_rate() const {
+    auto const prefetched = num_prefetched();
+    return prefetched == 0 ? 0.0
+                           : static_cast<double>(num_prefetch_hits()) /
+                                 static_cast<double>(prefetched);
+  }
+  //----------------------------------------------------------------------------
+  auto reset_statistics() {
+    m_num_hits          = 0;
+    m_num_misses        = 0;
+    m_num_evictions     = 0;
+    m_num_prefetched    = 0;
+    m_num_prefetch_hits = 0;
+  }
+  //----------------------------------------------------------------------------
+  /// Starts num_threads I/O threads that load up to radius chunks ahead of
+  /// the current access direction in the background. Must not be called while
+  /// other threads access the reader.
+  auto start_prefetching(std::size_t const num_threads = 1,
+                         std::size_t const radius      = 1) -> void {
+    stop_prefetching();
+    m_prefetch_radius  = radius;
+    m_stop_prefetching = false;
+    m_prefetch_threads.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i) {
+      m_prefetch_threads.emplace_back([this] { prefetch_loop(); });
+    }
+  }
+  //----------------------------------------------------------------------------
+  /// Stops and joins the prefetching threads. Queued chunks are discarded.
+  auto stop_prefetching() -> void {
+    if (m_prefetch_threads.empty()) {
+      return;
+    }
+    {
+      auto lock          = std::lock_guard{m_prefetch_mutex};
+      m_stop_prefetching = true;
+      for (auto const i : m_prefetch_queue) {
+        m_prefetch_queued[i] = 0;
+      }
+      m_prefetch_queue.clear();
+    }
+    m_prefetch_condition.notify_all();
+    for (auto& thread : m_prefetch_threads) {
+      thread.join();
+    }
+    m_prefetch_threads.clear();
+  }
+  //----------------------------------------------------------------------------
+  auto is_prefetching() const { return !m_prefetch_threads.empty(); }
+  //----------------------------------------------------------------------------
+  auto prefetch_radius() const { return m_prefetch_radius; }
+  //----------------------------------------------------------------------------
+  /// Must not be called while other threads access the reader.
+  auto set_prefetch_radius(std::size_t const radius) {
+    m_prefetch_radius = radius;
+  }
+  //----------------------------------------------------------------------------
+  /// Limits the number of chunks waiting to be prefetched. If the queue is
+  /// full the oldest requests are dropped.
+  auto set_max_prefetch_queue_size(std::size_t const max_size) {
+    auto lock                 = std::lock_guard{m_prefetch_mutex};
+    m_max_prefetch_queue_size = max_size;
   }
 };
 //==============================================================================
@@ -0,0 +1,132 @@
+#ifndef TATOOINE_MEMORY_MAPPED_FILE_H
+#define TATOOINE_MEMORY_MAPPED_FILE_H
+//==============================================================================
+#include <tatooine/filesystem.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstddef>
+#include <fstream>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+//==============================================================================
+namespace tatooine {
+//==============================================================================
+/// Read-only view of a whole file.
+///
+/// On POSIX systems the file is mapped into memory so that only the pages
+/// that are actually touched are read from disk. On other systems the file is
+/// read into a buffer.
+struct memory_mapped_file {
+ private:
+  std::byte const*       m_data = nullptr;
+  std::size_t            m_size = 0;
+  bool                   m_is_open = false;
+  bool                   m_is_mapped = false;
+  std::vector<std::byte> m_buffer;
+  //============================================================================
+ public:
+  memory_mapped_file() = default;
+  //----------------------------------------------------------------------------
+  explicit memory_mapped_file(filesystem::path const& path) { open(path); }
+  //----------------------------------------------------------------------------
+  memory_mapped_file(memory_mapped_file const&) = delete;
+  auto operator=(memory_mapped_file const&) -> memory_mapped_file& = delete;
+  //----------------------------------------------------------------------------
+  memory_mapped_file(memory_mapped_file&& other) noexcept
+      : m_data{std::exchange(other.m_data, nullptr)},
+        m_size{std::exchange(other.m_size, 0)},
+        m_is_open{std::exchange(other.m_is_open, false)},
+        m_is_mapped{std::exchange(other.m_is_mapped, false)},
+        m_buffer{std::move(other.m_buffer)} {}
+  //----------------------------------------------------------------------------
+  auto operator=(memory_mapped_file&& other) noexcept -> memory_mapped_file& {
+    close();
+    m_data      = std::exchange(other.m_data, nullptr);
+    m_size      = std::exchange(other.m_size, 0);
+    m_is_open   = std::exchange(other.m_is_open, false);
+    m_is_mapped = std::exchange(other.m_is_mapped, false);
+    m_buffer    = std::move(other.m_buffer);
+    return *this;
+  }
+  //----------------------------------------------------------------------------
+  ~memory_mapped_file() { close(); }
+  //============================================================================
+  auto is_open() const { return m_is_open; }
+  auto is_mapped() const { return m_is_mapped; }
+  auto data() const { return m_data; }
+  auto size() const { return m_size; }
+  auto bytes() const { return std::span{m_data, m_size}; }
+  auto as_string_view() const {
+    return std::string_view{reinterpret_cast<char const*>(m_data), m_size};
+  }
+  //============================================================================
+  auto open(filesystem::path const& path) -> void {
+    close();
+#if defined(__unix__) || defined(__APPLE__)
+    auto const fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) == 0) {
+      m_size = static_cast<std::size_t>(info.st_size);
+      if (m_size == 0) {
+        m_is_open = true;
+      } else if (auto* const mapped =
+                     ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                 mapped != MAP_FAILED) {
+        // the data is typically consumed front to back
+        ::madvise(mapped, m_size, MADV_SEQUENTIAL);
+        m_data      = static_cast<std::byte const*>(mapped);
+        m_is_open   = true;
+        m_is_mapped = true;
+      }
+    }
+    ::close(fd);
+    if (m_is_open) {
+      return;
+    }
+#endif
+    read_into_buffer(path);
+  }
+  //----------------------------------------------------------------------------
+  auto close() -> void {
+#if defined(__unix__) || defined(__APPLE__)
+    if (m_is_mapped) {
+      ::munmap(const_cast<std::byte*>(m_data), m_size);
+    }
+#endif
+    m_data      = nullptr;
+    m_size      = 0;
+    m_is_open   = false;
+    m_is_mapped = false;
+    m_buffer    = {};
+  }
+  //============================================================================
+ private:
+  auto read_into_buffer(filesystem::path const& path) -> void {
+    auto file = std::ifstream{path, std::ios::binary | std::ios::ate};
+    if (!file.is_open()) {
+      return;
+    }
+    m_buffer.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(m_buffer.data()),
+              static_cast<std::streamsize>(m_buffer.size()));
+    m_data    = m_buffer.data();
+    m_size    = m_buffer.size();
+    m_is_open = true;
+  }
+};
+//==============================================================================
+}  // namespace tatooine
+//==============================================================================
+#endif
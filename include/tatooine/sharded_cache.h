@@ -0,0 +1,186 @@
+#ifndef TATOOINE_SHARDED_CACHE_H
+#define TATOOINE_SHARDED_CACHE_H
+//==============================================================================
+#include <tatooine/cache.h>
+#include <tatooine/cache_alignment.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+//==============================================================================
+namespace tatooine {
+//==============================================================================
+/// Thread-safe cache that distributes its entries over NumShards independent
+/// tatooine::cache instances. Every shard has its own mutex so threads that
+/// work on different keys rarely contend.
+///
+/// Values are held by std::shared_ptr. A value that was handed out stays alive
+/// even if it gets evicted in the meantime. Synchronizing access to the value
+/// itself is up to the caller.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          std::size_t NumShards = 64>
+class sharded_cache {
+  static_assert(NumShards > 0);
+  //----------------------------------------------------------------------------
+  // typedefs
+  //----------------------------------------------------------------------------
+ public:
+  using key_type        = Key;
+  using value_type      = Value;
+  using value_ptr_type  = std::shared_ptr<Value>;
+  using shard_data_type = cache<Key, value_ptr_type, Hash>;
+  using memory_usage_function_type =
+      std::function<std::uint64_t(Value const&)>;
+  static constexpr auto num_shards() { return NumShards; }
+
+ private:
+  struct shard_type {
+    mutable std::mutex mutex;
+    shard_data_type    data;
+  };
+  //----------------------------------------------------------------------------
+  // members
+  //----------------------------------------------------------------------------
+  Hash                                        m_hash;
+  mutable std::array<aligned<shard_type>, NumShards> m_shards;
+  //----------------------------------------------------------------------------
+  // ctors
+  //----------------------------------------------------------------------------
+ public:
+  explicit sharded_cache(Hash const& hash = Hash{}) : m_hash{hash} {}
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  explicit sharded_cache(memory_usage_function_type const& f,
+                         Hash const&                       hash = Hash{})
+      : m_hash{hash} {
+    set_memory_usage_function(f);
+  }
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  /// Copies share their values with the original.
+  sharded_cache(sharded_cache const& other) : m_hash{other.m_hash} {
+    for (std::size_t i = 0; i < NumShards; ++i) {
+      auto lock           = std::lock_guard{other.m_shards[i]->mutex};
+      m_shards[i]->data = other.m_shards[i]->data;
+    }
+  }
+  //----------------------------------------------------------------------------
+  // methods
+  //----------------------------------------------------------------------------
+ private:
+  auto shard(Key const& key) const -> shard_type& {
+    // the upper bits are usually better mixed than the lower bits
+    auto const h = m_hash(key);
+    return *m_shards[(h ^ (h >> (sizeof(std::size_t) * 4))) % NumShards];
+  }
+  //----------------------------------------------------------------------------
+ public:
+  /// Returns the value cached for key. If there is none a default constructed
+  /// value is inserted. The second member of the returned pair is true if the
+  /// value was inserted.
+  auto get_or_create(Key const& key) const -> std::pair<value_ptr_type, bool> {
+    auto& s    = shard(key);
+    auto  lock = std::lock_guard{s.mutex};
+    if (s.data.is_cached(key)) {
+      return {s.data.at(key).second, false};
+    }
+    auto value = std::make_shared<Value>();
+    s.data.insert(key, value);
+    return {std::move(value), true};
+  }
+  //----------------------------------------------------------------------------
+  /// Returns nullptr if key is not cached.
+  auto find(Key const& key) const -> value_ptr_type {
+    auto& s    = shard(key);
+    auto  lock = std::lock_guard{s.mutex};
+    if (s.data.is_cached(key)) {
+      return s.data.at(key).second;
+    }
+    return nullptr;
+  }
+  //----------------------------------------------------------------------------
+  auto is_cached(Key const& key) const {
+    auto& s    = shard(key);
+    auto  lock = std::lock_guard{s.mutex};
+    return s.data.is_cached(key);
+  }
+  //----------------------------------------------------------------------------
+  auto size() const {
+    auto s = std::size_t{};
+    for (auto& shard : m_shards) {
+      auto lock = std::lock_guard{shard->mutex};
+      s += shard->data.size();
+    }
+    return s;
+  }
+  //----------------------------------------------------------------------------
+  /// Limits the total number of cached values. The limit is split evenly
+  /// among the shards.
+  auto set_max_elements(std::uint64_t const max_elements) {
+    auto const per_shard = split_among_shards(max_elements);
+    for (auto& shard : m_shards) {
+      auto lock = std::lock_guard{shard->mutex};
+      shard->data.set_max_elements(per_shard);
+    }
+  }
+  //----------------------------------------------------------------------------
+  /// Limits the total memory usage of cached values in bytes. The limit is
+  /// split evenly among the shards.
+  auto set_max_memory_usage(std::uint64_t const max_memory_usage) {
+    auto const per_shard = split_among_shards(max_memory_usage);
+    for (auto& shard : m_shards) {
+      auto lock = std::lock_guard{shard->mutex};
+      shard->data.set_max_memory_usage(per_shard);
+    }
+  }
+  //----------------------------------------------------------------------------
+  auto memory_usage() const {
+    auto m = std::uint64_t{};
+    for (auto& shard : m_shards) {
+      auto lock = std::lock_guard{shard->mutex};
+      m += shard->data.memory_usage();
+    }
+    return m;
+  }
+  //----------------------------------------------------------------------------
+  /// Sets the function that computes the memory usage of a value in bytes. It
+  /// may be called concurrently with modifications of the value so it must
+  /// synchronize its access to the value.
+  auto set_memory_usage_function(memory_usage_function_type const& f) {
+    for (auto& shard : m_shards) {
+      auto lock = std::lock_guard{shard->mutex};
+      shard->data.set_memory_usage_function(
+          [f](Key const&, value_ptr_type const& value) { return f(*value); });
+    }
+  }
+  //----------------------------------------------------------------------------
+  /// Recomputes the memory usage of the value cached for key after it has
+  /// changed.
+  auto refresh_memory_usage(Key const& key) const {
+    auto& s    = shard(key);
+    auto  lock = std::lock_guard{s.mutex};
+    s.data.refresh_memory_usage(key);
+  }
+  //----------------------------------------------------------------------------
+ private:
+  static auto split_among_shards(std::uint64_t const n) -> std::uint64_t {
+    if (n == std::numeric_limits<std::uint64_t>::max()) {
+      return n;
+    }
+    return n / NumShards + (n % NumShards == 0 ? 0 : 1);
+  }
+
+ public:
+  //----------------------------------------------------------------------------
+  auto clear() const {
+    for (auto& shard : m_shards) {
+      auto lock = std::lock_guard{shard->mutex};
+      shard->data.clear();
+    }
+  }
+};
+//==============================================================================
+}  // namespace tatooine
+//==============================================================================
+#endif
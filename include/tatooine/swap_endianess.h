@@ -1,6 +1,9 @@
 #ifndef TATOOINE_SWAP_ENDIANESS_H
 #define TATOOINE_SWAP_ENDIANESS_H
 //==============================================================================
+#include <cstdint>
+#include <cstring>
+#include <utility>
 #include <vector>
 //==============================================================================
 namespace tatooine {
@@ -18,15 +21,62 @@ constexpr Data swap_endianess(Data data) {
   return data;
 }
 //------------------------------------------------------------------------------
+namespace detail::swap_endianess {
+//------------------------------------------------------------------------------
+/// Byte swaps that compilers turn into single bswap instructions and
+/// vectorize in loops.
+constexpr auto byteswap(std::uint16_t const x) -> std::uint16_t {
+  return static_cast<std::uint16_t>((x << 8) | (x >> 8));
+}
+//------------------------------------------------------------------------------
+constexpr auto byteswap(std::uint32_t const x) -> std::uint32_t {
+  return ((x & 0x000000ffu) << 24) | ((x & 0x0000ff00u) << 8) |
+         ((x & 0x00ff0000u) >> 8) | ((x & 0xff000000u) >> 24);
+}
+//------------------------------------------------------------------------------
+constexpr auto byteswap(std::uint64_t const x) -> std::uint64_t {
+  return (std::uint64_t(byteswap(std::uint32_t(x))) << 32) |
+         std::uint64_t(byteswap(std::uint32_t(x >> 32)));
+}
+//------------------------------------------------------------------------------
+template <std::size_t Size>
+struct uint_of_size;
+template <>
+struct uint_of_size<2> {
+  using type = std::uint16_t;
+};
+template <>
+struct uint_of_size<4> {
+  using type = std::uint32_t;
+};
+template <>
+struct uint_of_size<8> {
+  using type = std::uint64_t;
+};
+//==============================================================================
+}  // namespace detail::swap_endianess
+//==============================================================================
+/// Swaps the byte order of n consecutive values.
 template <typename Data>
 constexpr void swap_endianess(Data *data, size_t n) {
   constexpr size_t size = sizeof(Data);
-  using mem_t           = unsigned char *;
-  for (size_t i = 0; i < n; ++i) {
-    auto mem = reinterpret_cast<mem_t>(&data[i]);
-    // swap bytes
-    for (size_t j = 0; j < size / 2; j++) {
-      std::swap(mem[j], mem[size - 1 - j]);
+  if constexpr (size == 2 || size == 4 || size == 8) {
+    using uint_t =
+        typename detail::swap_endianess::uint_of_size<size>::type;
+    for (size_t i = 0; i < n; ++i) {
+      auto u = uint_t{};
+      std::memcpy(&u, &data[i], size);
+      u = detail::swap_endianess::byteswap(u);
+      std::memcpy(&data[i], &u, size);
+    }
+  } else {
+    using mem_t = unsigned char *;
+    for (size_t i = 0; i < n; ++i) {
+      auto mem = reinterpret_cast<mem_t>(&data[i]);
+      // swap bytes
+      for (size_t j = 0; j < size / 2; j++) {
+        std::swap(mem[j], mem[size - 1 - j]);
+      }
     }
   }
 }
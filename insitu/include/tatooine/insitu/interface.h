@@ -3,6 +3,10 @@
 //==============================================================================
 #include <tatooine/field.h>
 #include <tatooine/insitu/base_interface.h>
+
+#include <cstdint>
+#include <map>
+#include <vector>
 //==============================================================================
 namespace tatooine::insitu {
 //==============================================================================
@@ -16,6 +20,13 @@ struct interface : base_interface<interface> {
       uniform_rectilinear_grid<double, 3>::typed_property_impl_t<scalar_arr_t>;
   using tracer_t           = std::pair<size_t, pos_type>;
   using tracer_container_t = std::vector<tracer_t>;
+  /// One entry of a rank's tracer log. Tracers can move between ranks so the
+  /// iteration is needed to put the positions of a tracer back in order.
+  struct tracer_record {
+    std::uint64_t idx;
+    std::uint64_t iteration;
+    pos_type      pos;
+  };
 
   struct velocity_field : vectorfield<velocity_field, double, 3> {
     using this_type   = velocity_field;
@@ -63,6 +74,22 @@ struct interface : base_interface<interface> {
   size_t                          m_num_tracers = 10;
   tracer_container_t              m_tracers;
   std::unique_ptr<velocity_field> m_velocity_field;
+  /// Tracer positions that have not been written to the rank's log yet.
+  std::vector<tracer_record> m_tracer_buffer;
+  /// Number of buffered records that triggers writing the log.
+  size_t m_max_tracer_buffer_size = 1 << 16;
+  /// Every this many iterations all logs are flushed and rank 0 converts them
+  /// to a vtp file.
+  size_t m_tracer_output_interval = 10;
+  /// Number of bytes of each rank's log that have already been read by
+  /// create_tracer_vtp(). Only used on rank 0.
+  std::vector<std::uintmax_t> m_tracer_log_offsets;
+  /// Last record of every tracer that create_tracer_vtp() has written. Only
+  /// used on rank 0.
+  std::map<std::uint64_t, tracer_record> m_last_tracer_records;
+
+  //============================================================================
+  ~interface();
 
   //============================================================================
   // Interface Functions
@@ -105,7 +132,21 @@ struct interface : base_interface<interface> {
   /// \return advected positions
   auto advect_tracers() -> void;
   //----------------------------------------------------------------------------
-  auto create_tracer_vtk() -> void;
+  /// Path of the binary tracer log of rank.
+  static auto tracer_log_path(int rank) -> filesystem::path;
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  /// Appends the current positions of all tracers of this rank to the buffer
+  /// and flushes it if it is full.
+  auto buffer_tracers() -> void;
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  /// Appends the buffered tracer positions to the log of this rank with a
+  /// single write.
+  auto flush_tracers() -> void;
+  //----------------------------------------------------------------------------
+  /// Reads the records that were appended to the tracer logs of all ranks
+  /// since the last call and writes them as one piece of lines to
+  /// tracers_<iteration>.vtp. Earlier pieces are not touched.
+  auto create_tracer_vtp() -> void;
   //----------------------------------------------------------------------------
   auto extract_isosurfaces() -> void;
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
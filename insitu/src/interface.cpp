@@ -1,8 +1,9 @@
 #include <tatooine/insitu/interface.h>
 #include <tatooine/isosurface.h>
-#include <tatooine/vtk_legacy.h>
+#include <tatooine/line.h>
 
 #include <boost/serialization/variant.hpp>
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 //==============================================================================
@@ -139,12 +140,16 @@ auto interface::initialize_grid(
 
   auto const bb = m_worker_grid.bounding_box();
   for (size_t i = 0; i < m_num_tracers; ++i) {
-    auto const& [idx, pos] = m_tracers.emplace_back(
-        m_mpi_communicator->rank() * m_num_tracers + i, bb.random_point());
-    std::fstream fout{m_tracers_tmp_path / (std::to_string(idx) + ".bin"),
-                      std::ios::binary | std::ios::out | std::ios::trunc};
-    fout.write(reinterpret_cast<char const*>(pos.data()),
-               sizeof(double) * 3);
+    m_tracers.emplace_back(m_mpi_communicator->rank() * m_num_tracers + i,
+                           bb.random_point());
+  }
+  buffer_tracers();
+}
+//----------------------------------------------------------------------------
+interface::~interface() {
+  try {
+    flush_tracers();
+  } catch (...) {
   }
 }
 //----------------------------------------------------------------------------
@@ -185,10 +190,10 @@ auto interface::initialize(bool const restart) -> void {
   fs::create_directories(m_output_path);
   fs::create_directories(m_isosurface_output_path);
   fs::create_directories(m_tracers_output_path);
-  if (!fs::exists(m_tracers_tmp_path)) {
-    fs::remove_all(m_tracers_tmp_path);
-  }
   fs::create_directories(m_tracers_tmp_path);
+  if (!restart) {
+    fs::remove(tracer_log_path(m_mpi_communicator->rank()));
+  }
 
   if (restart == 1) {
     // Append to log files
@@ -240,8 +245,12 @@ auto interface::update(int const iteration, double const time) -> void {
   //extract_isosurfaces();
   //advect_tracers();
 
-  if (m_mpi_communicator->rank() == 0) {
-    create_tracer_vtk();
+  if (m_iteration % m_tracer_output_interval == 0) {
+    flush_tracers();
+    m_mpi_communicator->barrier();
+    if (m_mpi_communicator->rank() == 0) {
+      create_tracer_vtp();
+    }
   }
 
   m_last_end_time = std::chrono::system_clock::now();
@@ -339,82 +348,100 @@ auto interface::advect_tracers() -> void {
   boost::for_each(m_tracers, add_if_in_working_domain);
   m_tracers = std::move(in_working_area);
 
-  // write
-  //if (m_iteration % 10 == 0) {
-    log(std::to_string(m_iteration));
-    for (auto const& [idx, pos] : m_tracers) {
-      std::fstream fout{m_tracers_tmp_path / (std::to_string(idx) + ".bin"),
-                        std::ios::binary | std::ios::out | std::ios::app};
-      fout.write(reinterpret_cast<char const*>(pos.data()),
-                 sizeof(double) * 3);
-    //}
+  buffer_tracers();
+}
+//------------------------------------------------------------------------------
+auto interface::tracer_log_path(int const rank) -> filesystem::path {
+  return m_tracers_tmp_path / ("rank_" + std::to_string(rank) + ".bin");
+}
+//------------------------------------------------------------------------------
+auto interface::buffer_tracers() -> void {
+  for (auto const& [idx, pos] : m_tracers) {
+    m_tracer_buffer.push_back({idx, m_iteration, pos});
+  }
+  if (m_tracer_buffer.size() >= m_max_tracer_buffer_size) {
+    flush_tracers();
   }
 }
 //------------------------------------------------------------------------------
-auto interface::create_tracer_vtk() -> void {
+auto interface::flush_tracers() -> void {
+  if (m_tracer_buffer.empty()) {
+    return;
+  }
+  auto file = std::ofstream{tracer_log_path(m_mpi_communicator->rank()),
+                           std::ios::binary | std::ios::app};
+  file.write(reinterpret_cast<char const*>(m_tracer_buffer.data()),
+            static_cast<std::streamsize>(sizeof(tracer_record) *
+                                         m_tracer_buffer.size()));
+  m_tracer_buffer.clear();
+}
+//------------------------------------------------------------------------------
+auto interface::create_tracer_vtp() -> void {
   namespace fs = filesystem;
-  vtk::legacy_file_writer tracer_collector{
-      m_tracers_output_path / "tracers.vtk", vtk::dataset_type::polydata};
-
-  size_t                                   total_num_vertices = 0;
-  size_t                                   num_lines          = 0;
-  size_t                                   lines_size         = 0;
-  std::vector<std::pair<size_t, fs::path>> tracer_info;
-
-  for (auto const& bin_tracer_dir_entry :
-       fs::directory_iterator(m_tracers_tmp_path)) {
-    auto const tmp_filesize = fs::file_size(bin_tracer_dir_entry);
-    auto const num_vertices = tmp_filesize / (sizeof(double) * 3);
-    if (num_vertices > 1) {
-      tracer_info.emplace_back(num_vertices, bin_tracer_dir_entry.path());
-      total_num_vertices += num_vertices;
-      lines_size += num_vertices + 1;
-      ++num_lines;
+  auto const num_ranks = static_cast<std::size_t>(m_mpi_communicator->size());
+  m_tracer_log_offsets.resize(num_ranks, 0);
+  auto records = std::vector<tracer_record>{};
+  for (std::size_t rank = 0; rank < num_ranks; ++rank) {
+    auto const path = tracer_log_path(static_cast<int>(rank));
+    if (!fs::exists(path)) {
+      continue;
+    }
+    auto&      log_offset  = m_tracer_log_offsets[rank];
+    auto const num_records =
+        (fs::file_size(path) - log_offset) / sizeof(tracer_record);
+    if (num_records == 0) {
+      continue;
     }
+    auto const offset = records.size();
+    records.resize(offset + num_records);
+    auto file = std::ifstream{path, std::ios::binary};
+    file.seekg(static_cast<std::streamoff>(log_offset));
+    file.read(reinterpret_cast<char*>(records.data() + offset),
+              static_cast<std::streamsize>(sizeof(tracer_record) * num_records));
+    log_offset += sizeof(tracer_record) * num_records;
   }
 
-  // write
-  tracer_collector.set_title("tatooine insitu tracer");
-  tracer_collector.write_header();
-  tracer_collector.close();
-  std::fstream tracer_vtk_file{
-      m_tracers_output_path / "tracers.vtk",
-      std::ios::binary | std::ios::out | std::ios::app};
+  // Group the new records by tracer in the order of the iterations. Tracers in
+  // the overlap of two working areas have been logged by both ranks.
+  auto const less = [](tracer_record const& lhs, tracer_record const& rhs) {
+    return lhs.idx < rhs.idx ||
+           (lhs.idx == rhs.idx && lhs.iteration < rhs.iteration);
+  };
+  auto const equal = [](tracer_record const& lhs, tracer_record const& rhs) {
+    return lhs.idx == rhs.idx && lhs.iteration == rhs.iteration;
+  };
+  std::sort(begin(records), end(records), less);
+  records.erase(std::unique(begin(records), end(records), equal),
+                end(records));
 
-  // write points
-  std::stringstream points_header_stream;
-  points_header_stream << "\nPOINTS " << total_num_vertices << ' '
-                       << type_to_str<double>() << '\n';
-  std::copy(std::istreambuf_iterator<char>{points_header_stream},
-            std::istreambuf_iterator<char>{},
-            std::ostreambuf_iterator<char>{tracer_vtk_file});
-  for (auto const& [num_vertices, path] : tracer_info) {
-    auto const          num_entries   = num_vertices * 3;
-    auto const          tmp_file_size = num_entries * sizeof(double);
-    std::fstream        tracer_tmp_file{path, std::ios::binary | std::ios::in};
-    std::vector<double> points(num_entries);
-    tracer_tmp_file.read(reinterpret_cast<char*>(points.data()), tmp_file_size);
-    swap_endianess(points);
-    tracer_vtk_file.write(reinterpret_cast<char*>(points.data()),
-                          tmp_file_size);
+  // Every tracer gets one line per piece. It starts at the position the
+  // previous piece ended with so that the pieces join up.
+  auto lines = std::vector<line3>{};
+  for (auto first = begin(records); first != end(records);) {
+    auto const last = std::find_if(first, end(records), [&](auto const& r) {
+      return r.idx != first->idx;
+    });
+    auto const prev =
+        m_last_tracer_records.try_emplace(first->idx, *first).first;
+    auto l = line3{};
+    l.push_back(prev->second.pos);
+    for (auto r = first; r != last; ++r) {
+      // logs are flushed before every conversion so older positions of a
+      // tracer can only show up again if another rank logged the same
+      // iteration
+      if (r->iteration > prev->second.iteration) {
+        l.push_back(r->pos);
+        prev->second = *r;
+      }
+    }
+    if (l.num_vertices() > 1) {
+      lines.push_back(std::move(l));
+    }
+    first = last;
   }
-
-  // write line indices
-  std::stringstream lines_header_stream;
-  lines_header_stream << "\nLINES " << num_lines << ' ' << lines_size << '\n';
-  std::copy(std::istreambuf_iterator<char>{lines_header_stream},
-            std::istreambuf_iterator<char>{},
-            std::ostreambuf_iterator<char>{tracer_vtk_file});
-  size_t cur_initial_index = 0;
-  for (auto const& [num_vertices, path] : tracer_info) {
-    // write number of indices and indices of current line
-    std::vector<int> cur_line(num_vertices + 1);
-    cur_line.front() = num_vertices;
-    std::iota(next(begin(cur_line)), end(cur_line), cur_initial_index);
-    swap_endianess(cur_line);
-    tracer_vtk_file.write(reinterpret_cast<char*>(cur_line.data()),
-                          sizeof(int) * cur_line.size());
-    cur_initial_index += num_vertices;
+  if (!lines.empty()) {
+    write_vtp(lines, m_tracers_output_path /
+                         ("tracers_" + std::to_string(m_iteration) + ".vtp"));
   }
 }
 //------------------------------------------------------------------------------
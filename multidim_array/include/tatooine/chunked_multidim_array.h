@@ -225,6 +225,11 @@ struct chunked_multidim_array : dynamic_multidim_size<GlobalIndexOrder> {
     return is;
   }
   //----------------------------------------------------------------------------
+  auto chunk_indices_from_plain_chunk_index(
+      std::size_t const plain_chunk_index) const {
+    return m_chunk_structure.multi_index(plain_chunk_index);
+  }
+  //----------------------------------------------------------------------------
   auto plain_chunk_index_from_chunk_indices(
       integral auto const... chunk_indices) const {
     assert(sizeof...(chunk_indices) == num_dimensions());
@@ -314,8 +319,9 @@ struct chunked_multidim_array : dynamic_multidim_size<GlobalIndexOrder> {
     auto chunk_it = begin(m_chunks);
     for (auto const& chunk : other.m_chunks) {
       if (chunk) {
-        *(chunk_it++) = std::make_unique<chunk_t>(*chunk);
+        *chunk_it = std::make_unique<chunk_t>(*chunk);
       }
+      ++chunk_it;
     }
   }
   //----------------------------------------------------------------------------
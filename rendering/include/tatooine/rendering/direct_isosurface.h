@@ -455,8 +455,9 @@ auto direct_isosurface(
 {
   return direct_isosurface(
       cam, linear_field.grid(),
-      [&](std::size_t const ix, std::size_t const iy, std::size_t const iz)
-          -> auto const& { return linear_field.data_at(ix, iy, iz); },
+      [&](std::size_t const ix, std::size_t const iy, std::size_t const iz) {
+        return linear_field.data_at(ix, iy, iz);
+      },
       std::vector{isovalue}, std::forward<Shader>(shader));
 }
 //------------------------------------------------------------------------------
@@ -11,5 +11,7 @@
 #include <tatooine/lapack/geqrf.h>
 #include <tatooine/lapack/gesv.h>
 #include <tatooine/lapack/getrf.h>
+#include <tatooine/lapack/sytrf.h>
+#include <tatooine/lapack/sytrs.h>
 //==============================================================================
 #endif
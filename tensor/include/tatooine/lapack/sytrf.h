@@ -0,0 +1,65 @@
+#ifndef TATOOINE_LAPACK_SYTRF_H
+#define TATOOINE_LAPACK_SYTRF_H
+//==============================================================================
+extern "C" {
+//==============================================================================
+auto dsytrf_(char* UPLO, int* N, double* A, int* LDA, int* IPIV, double* WORK,
+             int* LWORK, int* INFO) -> void;
+//------------------------------------------------------------------------------
+auto ssytrf_(char* UPLO, int* N, float* A, int* LDA, int* IPIV, float* WORK,
+             int* LWORK, int* INFO) -> void;
+//==============================================================================
+}  // extern "C"
+//==============================================================================
+#include <tatooine/lapack/base.h>
+
+#include <concepts>
+#include <memory>
+//==============================================================================
+namespace tatooine::lapack {
+//==============================================================================
+/// \defgroup lapack_sytrf SYTRF
+/// \brief Factors a symmetric matrix.
+/// \ingroup lapack
+///
+/// **SYTRF** computes the factorization of a real symmetric matrix \f$\mA\f$
+/// using the Bunch-Kaufman diagonal pivoting method. The form of the
+/// factorization is \f$\mA = \mU \mD \mU^\top\f$ or \f$\mA = \mL \mD
+/// \mL^\top\f$. The factorization can be used by \ref lapack_sytrs "SYTRS" to
+/// solve systems with several right hand sides.
+///
+/// - <a
+/// href='https://www.netlib.org/lapack/lapack-3.1.1/html/dsytrf.f.html'>LAPACK
+/// documentation</a>
+/// \{
+//==============================================================================
+template <std::floating_point Float>
+auto sytrf(uplo u, int N, Float* A, int LDA, int* IPIV, Float* WORK,
+           int LWORK) -> int {
+  auto INFO = int{};
+  if constexpr (std::same_as<Float, double>) {
+    dsytrf_(reinterpret_cast<char*>(&u), &N, A, &LDA, IPIV, WORK, &LWORK,
+            &INFO);
+  } else if constexpr (std::same_as<Float, float>) {
+    ssytrf_(reinterpret_cast<char*>(&u), &N, A, &LDA, IPIV, WORK, &LWORK,
+            &INFO);
+  }
+  return INFO;
+}
+//------------------------------------------------------------------------------
+/// Queries and allocates the optimal workspace.
+template <std::floating_point Float>
+auto sytrf(uplo u, int N, Float* A, int LDA, int* IPIV) -> int {
+  auto LWORK = int{-1};
+  auto WORK  = std::unique_ptr<Float[]>{new Float[1]};
+  sytrf<Float>(u, N, A, LDA, IPIV, WORK.get(), LWORK);
+  LWORK = static_cast<int>(WORK[0]);
+  WORK  = std::unique_ptr<Float[]>{new Float[LWORK]};
+  return sytrf<Float>(u, N, A, LDA, IPIV, WORK.get(), LWORK);
+}
+//==============================================================================
+/// \}
+//==============================================================================
+}  // namespace tatooine::lapack
+//==============================================================================
+#endif
@@ -0,0 +1,52 @@
+#ifndef TATOOINE_LAPACK_SYTRS_H
+#define TATOOINE_LAPACK_SYTRS_H
+//==============================================================================
+extern "C" {
+//==============================================================================
+auto dsytrs_(char* UPLO, int* N, int* NRHS, double* A, int* LDA, int* IPIV,
+             double* B, int* LDB, int* INFO) -> void;
+//------------------------------------------------------------------------------
+auto ssytrs_(char* UPLO, int* N, int* NRHS, float* A, int* LDA, int* IPIV,
+             float* B, int* LDB, int* INFO) -> void;
+//==============================================================================
+}  // extern "C"
+//==============================================================================
+#include <tatooine/lapack/base.h>
+
+#include <concepts>
+//==============================================================================
+namespace tatooine::lapack {
+//==============================================================================
+/// \defgroup lapack_sytrs SYTRS
+/// \brief Solves symmetric systems with a factorization computed by SYTRF.
+/// \ingroup lapack
+///
+/// **SYTRS** solves \f$\mA\mX = \mB\f$ with a symmetric matrix \f$\mA\f$ using
+/// the factorization \f$\mA = \mU \mD \mU^\top\f$ or \f$\mA = \mL \mD
+/// \mL^\top\f$ computed by \ref lapack_sytrf "SYTRF". \f$\mA\f$ and `IPIV` are
+/// not modified so the factorization can be reused.
+///
+/// - <a
+/// href='https://www.netlib.org/lapack/lapack-3.1.1/html/dsytrs.f.html'>LAPACK
+/// documentation</a>
+/// \{
+//==============================================================================
+template <std::floating_point Float>
+auto sytrs(uplo u, int N, int NRHS, Float const* A, int LDA, int const* IPIV,
+           Float* B, int LDB) -> int {
+  auto INFO = int{};
+  if constexpr (std::same_as<Float, double>) {
+    dsytrs_(reinterpret_cast<char*>(&u), &N, &NRHS, const_cast<Float*>(A),
+            &LDA, const_cast<int*>(IPIV), B, &LDB, &INFO);
+  } else if constexpr (std::same_as<Float, float>) {
+    ssytrs_(reinterpret_cast<char*>(&u), &N, &NRHS, const_cast<Float*>(A),
+            &LDA, const_cast<int*>(IPIV), B, &LDB, &INFO);
+  }
+  return INFO;
+}
+//==============================================================================
+/// \}
+//==============================================================================
+}  // namespace tatooine::lapack
+//==============================================================================
+#endif
@@ -5,42 +5,159 @@
 #include <tatooine/tensor_typedefs.h>
 #include <tatooine/vec_typedefs.h>
 #include <tatooine/mat_typedefs.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
 //==============================================================================
 namespace tatooine {
 //==============================================================================
-// template <typename Tensor, typename Real>
-// constexpr auto eigenvectors_sym(base_tensor<Tensor, Real, 2, 2> const& A) {
-//  decltype(auto) b     = A(1, 0);
-//  if (b == 0) {
-//    return std::pair{mat<Real, 2, 2>::eye(), vec<Real, 2>{A(0, 0), A(1, 1)}};
-//  }
-//
-//  decltype(auto) a     = A(0, 0);
-//  decltype(auto) d     = A(1, 1);
-//  auto const     e_sqr = d * d - 2 * a * d + 4 * b * b + a * a;
-//  auto const     e     = std::sqrt(e_sqr);
-//  constexpr auto half  = 1 / Real(2);
-//  auto const     b2inv = 1 / (2 * b);
-//  std::pair      out{mat<Real, 2, 2>{{Real(1), Real(1)},
-//                                {-(e - d + a) * b2inv, (e + d - a) * b2inv}},
-//                vec<Real, 2>{-(e - d - a) * half, (e + d + a) * half}};
-//  if (out.second(0) > out.second(1)) {
-//    std::swap(out.first(1, 0), out.first(1, 1));
-//    std::swap(out.second(0), out.second(1));
-//  }
-//  if (out.first(1, 0) < 0) {
-//    out.first.col(0) *= -1;
-//  }
-//  if (out.first(1, 1) < 0) {
-//    out.first.col(1) *= -1;
-//  }
-//  out.first.col(0) /= std::sqrt(1 + out.first(1, 0) * out.first(1, 0));
-//  out.first.col(1) /= std::sqrt(1 + out.first(1, 1) * out.first(1, 1));
-//  return out;
-//}
+namespace detail::eigenvalues {
+//==============================================================================
+/// Eigenvalues of the symmetric 2x2 matrix [[a00, a01], [a01, a11]] in
+/// ascending order. Branch-free so that loops over it can be vectorized.
+template <floating_point Real>
+constexpr auto sym_2x2(Real const a00, Real const a01, Real const a11,
+                       Real& lambda0, Real& lambda1) -> void {
+  auto const half_trace = (a00 + a11) / 2;
+  auto const half_diff  = (a00 - a11) / 2;
+  auto const r          = std::sqrt(half_diff * half_diff + a01 * a01);
+  lambda0               = half_trace - r;
+  lambda1               = half_trace + r;
+}
+//------------------------------------------------------------------------------
+/// Eigenvalues of the symmetric 3x3 matrix with upper triangular components
+/// a00, a01, a02, a11, a12, a22 in ascending order.
+///
+/// Uses the trigonometric solution of the characteristic polynomial by Smith
+/// (1961). Branch-free so that loops over it can be vectorized.
+template <floating_point Real>
+constexpr auto sym_3x3(Real const a00, Real const a01, Real const a02,
+                       Real const a11, Real const a12, Real const a22,
+                       Real& lambda0, Real& lambda1, Real& lambda2) -> void {
+  constexpr auto pi  = Real(3.14159265358979323846);
+  auto const     q   = (a00 + a11 + a22) / 3;
+  auto const     b00 = a00 - q;
+  auto const     b11 = a11 - q;
+  auto const     b22 = a22 - q;
+  auto const     p1  = a01 * a01 + a02 * a02 + a12 * a12;
+  auto const     p   = std::sqrt((b00 * b00 + b11 * b11 + b22 * b22 + 2 * p1) /
+                                 6);
+  // A = q * I has p == 0. B then is the zero matrix.
+  auto const inv_p = p > 0 ? 1 / p : Real(0);
+  auto const c00   = b00 * inv_p;
+  auto const c01   = a01 * inv_p;
+  auto const c02   = a02 * inv_p;
+  auto const c11   = b11 * inv_p;
+  auto const c12   = a12 * inv_p;
+  auto const c22   = b22 * inv_p;
+  auto const det_half =
+      (c00 * (c11 * c22 - c12 * c12) - c01 * (c01 * c22 - c12 * c02) +
+       c02 * (c01 * c12 - c11 * c02)) /
+      2;
+  auto const r   = std::min(Real(1), std::max(Real(-1), det_half));
+  auto const phi = std::acos(r) / 3;
+  lambda2        = q + 2 * p * std::cos(phi);
+  lambda0        = q + 2 * p * std::cos(phi + 2 * pi / 3);
+  lambda1        = 3 * q - lambda0 - lambda2;
+}
+//------------------------------------------------------------------------------
+/// Diagonalizes the symmetric matrix A with cyclic Jacobi rotations.
+/// \return eigenvectors as columns and eigenvalues, both sorted by ascending
+/// eigenvalues. Every eigenvector is oriented so that its last non-zero
+/// component is positive.
+template <floating_point Real, std::size_t N>
+constexpr auto jacobi_sym(mat<Real, N, N> A) {
+  auto V = mat<Real, N, N>::eye();
+  for (std::size_t sweep = 0; sweep < 32; ++sweep) {
+    auto converged = true;
+    for (std::size_t p = 0; p < N - 1; ++p) {
+      for (std::size_t q = p + 1; q < N; ++q) {
+        auto const apq = A(p, q);
+        if (std::abs(apq) <= std::numeric_limits<Real>::epsilon() *
+                                 std::sqrt(std::abs(A(p, p) * A(q, q)))) {
+          A(p, q) = A(q, p) = 0;
+          continue;
+        }
+        converged        = false;
+        auto const theta = (A(q, q) - A(p, p)) / (2 * apq);
+        auto const t     = (theta < 0 ? Real(-1) : Real(1)) /
+                       (std::abs(theta) + std::sqrt(theta * theta + 1));
+        auto const c = 1 / std::sqrt(t * t + 1);
+        auto const s = t * c;
+        for (std::size_t k = 0; k < N; ++k) {
+          auto const akp = A(k, p);
+          auto const akq = A(k, q);
+          A(k, p)        = c * akp - s * akq;
+          A(k, q)        = s * akp + c * akq;
+        }
+        for (std::size_t k = 0; k < N; ++k) {
+          auto const apk = A(p, k);
+          auto const aqk = A(q, k);
+          A(p, k)        = c * apk - s * aqk;
+          A(q, k)        = s * apk + c * aqk;
+        }
+        for (std::size_t k = 0; k < N; ++k) {
+          auto const vkp = V(k, p);
+          auto const vkq = V(k, q);
+          V(k, p)        = c * vkp - s * vkq;
+          V(k, q)        = s * vkp + c * vkq;
+        }
+      }
+    }
+    if (converged) {
+      break;
+    }
+  }
+  auto lambda = vec<Real, N>{};
+  for (std::size_t i = 0; i < N; ++i) {
+    lambda(i) = A(i, i);
+  }
+  // selection sort of eigenvalues and eigenvectors
+  for (std::size_t i = 0; i < N - 1; ++i) {
+    auto min = i;
+    for (std::size_t j = i + 1; j < N; ++j) {
+      if (lambda(j) < lambda(min)) {
+        min = j;
+      }
+    }
+    if (min != i) {
+      std::swap(lambda(i), lambda(min));
+      for (std::size_t k = 0; k < N; ++k) {
+        std::swap(V(k, i), V(k, min));
+      }
+    }
+  }
+  for (std::size_t j = 0; j < N; ++j) {
+    for (std::size_t k = N; k > 0; --k) {
+      if (V(k - 1, j) != 0) {
+        if (V(k - 1, j) < 0) {
+          V.col(j) *= -1;
+        }
+        break;
+      }
+    }
+  }
+  return std::pair{V, lambda};
+}
+//==============================================================================
+}  // namespace detail::eigenvalues
+//==============================================================================
+/// Eigenvectors and eigenvalues of a symmetric 2x2 or 3x3 matrix computed
+/// with Jacobi rotations. Eigenvectors are stored as columns, eigenvalues are
+/// sorted in ascending order.
+template <static_quadratic_mat Mat>
+requires(tensor_dimension<Mat, 0> == 2 || tensor_dimension<Mat, 0> == 3)
+constexpr auto eigenvectors_sym(Mat&& A) {
+  auto constexpr N = tensor_dimension<Mat, 0>;
+  return detail::eigenvalues::jacobi_sym(
+      mat<tatooine::value_type<Mat>, N, N>{std::forward<Mat>(A)});
+}
 //------------------------------------------------------------------------------
 #if TATOOINE_BLAS_AND_LAPACK_AVAILABLE
 template <static_quadratic_mat Mat>
+requires(tensor_dimension<Mat, 0> > 3)
 auto eigenvectors_sym(Mat&& A) {
   static constexpr auto N = tensor_dimension<Mat, 0>;
 
@@ -53,24 +170,52 @@ auto eigenvectors_sym(Mat&& A) {
 //==============================================================================
 template <fixed_size_quadratic_mat<2> Mat>
 constexpr auto eigenvalues_sym(Mat&& A) {
-  decltype(auto) b = A(1, 0);
-  if (std::abs(b) <= 1e-11) {
-    return vec<tatooine::value_type<Mat>, 2>{A(0, 0), A(1, 1)};
+  auto lambda = vec<tatooine::value_type<Mat>, 2>{};
+  detail::eigenvalues::sym_2x2(A(0, 0), A(1, 0), A(1, 1), lambda(0),
+                               lambda(1));
+  return lambda;
+}
+//------------------------------------------------------------------------------
+template <fixed_size_quadratic_mat<3> Mat>
+constexpr auto eigenvalues_sym(Mat&& A) {
+  auto lambda = vec<tatooine::value_type<Mat>, 3>{};
+  detail::eigenvalues::sym_3x3(A(0, 0), A(0, 1), A(0, 2), A(1, 1), A(1, 2),
+                               A(2, 2), lambda(0), lambda(1), lambda(2));
+  return lambda;
+}
+//------------------------------------------------------------------------------
+/// Computes the eigenvalues of n symmetric 2x2 matrices that are stored as
+/// structure of arrays. a00, a01 and a11 point to the upper triangular
+/// components, the ascending eigenvalues are written to lambda0 and lambda1.
+template <floating_point Real>
+auto eigenvalues_sym(std::size_t const n, Real const* a00, Real const* a01,
+                     Real const* a11, Real* lambda0, Real* lambda1) -> void {
+#pragma omp simd
+  for (std::size_t i = 0; i < n; ++i) {
+    detail::eigenvalues::sym_2x2(a00[i], a01[i], a11[i], lambda0[i],
+                                 lambda1[i]);
   }
-  decltype(auto) a     = A(0, 0);
-  decltype(auto) d     = A(1, 1);
-  auto const     e_sqr = d * d - 2 * a * d + 4 * b * b + a * a;
-  auto const     e     = std::sqrt(e_sqr);
-  constexpr auto half  = 1 / tatooine::value_type<Mat>(2);
-  auto lambda = vec<tatooine::value_type<Mat>, 2>{-e + d + a, e + d + a} * half;
-  if (lambda(0) > lambda(1)) {
-    std::swap(lambda(0), lambda(1));
+}
+//------------------------------------------------------------------------------
+/// Computes the eigenvalues of n symmetric 3x3 matrices that are stored as
+/// structure of arrays. a00, ..., a22 point to the upper triangular
+/// components, the ascending eigenvalues are written to lambda0, lambda1 and
+/// lambda2.
+template <floating_point Real>
+auto eigenvalues_sym(std::size_t const n, Real const* a00, Real const* a01,
+                     Real const* a02, Real const* a11, Real const* a12,
+                     Real const* a22, Real* lambda0, Real* lambda1,
+                     Real* lambda2) -> void {
+#pragma omp simd
+  for (std::size_t i = 0; i < n; ++i) {
+    detail::eigenvalues::sym_3x3(a00[i], a01[i], a02[i], a11[i], a12[i],
+                                 a22[i], lambda0[i], lambda1[i], lambda2[i]);
   }
-  return lambda;
 }
 //------------------------------------------------------------------------------
 #if TATOOINE_BLAS_AND_LAPACK_AVAILABLE
 template <static_quadratic_mat Mat>
+requires(tensor_dimension<Mat, 0> > 3)
 constexpr auto eigenvalues_sym(Mat&& A) {
   auto constexpr N = tensor_dimensions<Mat>[0];
   auto W           = vec<tatooine::value_type<Mat>, N>{};
@@ -0,0 +1,121 @@
+#include <tatooine/bounding_volume_hierarchy.h>
+#include <tatooine/random.h>
+#include <tatooine/unstructured_tetrahedral_grid.h>
+#include <tatooine/unstructured_triangular_grid.h>
+
+#include <algorithm>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+//==============================================================================
+namespace tatooine::test {
+//==============================================================================
+/// Simplex soup with randomly placed and sized simplices so that the
+/// hierarchy has to deal with strongly varying simplex sizes.
+template <typename Mesh>
+auto random_simplex_soup(std::size_t const num_simplices) {
+  auto mesh = Mesh{};
+  auto rand = random::uniform{0.0, 1.0, std::mt19937_64{1234}};
+  auto pos  = [&](auto const& center, double const scale) {
+    auto x = typename Mesh::pos_type{};
+    for (std::size_t i = 0; i < Mesh::num_dimensions(); ++i) {
+      x(i) = center(i) + (rand() - 0.5) * scale;
+    }
+    return x;
+  };
+  auto const domain_center = Mesh::pos_type::ones() * 0.5;
+  for (std::size_t i = 0; i < num_simplices; ++i) {
+    auto const x0    = pos(domain_center, 1);
+    auto const scale = i % 100 == 0 ? 0.5 : 0.01;
+    auto       vs    = std::array<typename Mesh::vertex_handle,
+                                  Mesh::num_vertices_per_simplex()>{};
+    for (auto& v : vs) {
+      v = mesh.insert_vertex(pos(x0, scale));
+    }
+    std::apply([&](auto const... vs) { mesh.insert_simplex(vs...); }, vs);
+  }
+  return mesh;
+}
+//------------------------------------------------------------------------------
+template <typename Mesh>
+auto brute_force_nearby_simplices(Mesh const&                     mesh,
+                                  typename Mesh::pos_type const& x) {
+  auto simplices = std::vector<typename Mesh::simplex_handle>{};
+  for (auto const s : mesh.simplices()) {
+    auto const vs     = mesh[s];
+    auto       inside = true;
+    for (std::size_t i = 0; i < Mesh::num_dimensions(); ++i) {
+      auto const [min, max] = std::apply(
+          [&](auto const... vs) {
+            return std::minmax({mesh[vs](i)...});
+          },
+          vs);
+      inside = inside && min <= x(i) && x(i) <= max;
+    }
+    if (inside) {
+      simplices.push_back(s);
+    }
+  }
+  return simplices;
+}
+//==============================================================================
+TEST_CASE("bounding_volume_hierarchy_nearby_simplices",
+          "[bounding_volume_hierarchy][nearby_simplices]") {
+  auto rand = random::uniform{0.0, 1.0, std::mt19937_64{4321}};
+  SECTION("triangles") {
+    auto const mesh = random_simplex_soup<unstructured_triangular_grid2>(5000);
+    auto const bvh  = bounding_volume_hierarchy{mesh};
+    REQUIRE(bvh.simplex_handles().size() == 5000);
+    auto buffer = std::vector<unstructured_triangular_grid2::simplex_handle>{};
+    for (std::size_t i = 0; i < 200; ++i) {
+      auto const x = vec2{rand(), rand()};
+      bvh.nearby_simplices(x, buffer);
+      std::ranges::sort(buffer);
+      REQUIRE(std::ranges::includes(buffer,
+                                    brute_force_nearby_simplices(mesh, x)));
+      REQUIRE(buffer.size() < 100);
+    }
+  }
+  SECTION("tetrahedra") {
+    auto const mesh = random_simplex_soup<unstructured_tetrahedral_grid3>(5000);
+    auto const bvh  = bounding_volume_hierarchy{mesh};
+    for (std::size_t i = 0; i < 200; ++i) {
+      auto const x         = vec3{rand(), rand(), rand()};
+      auto       simplices = bvh.nearby_simplices(x);
+      std::ranges::sort(simplices);
+      REQUIRE(std::ranges::includes(simplices,
+                                    brute_force_nearby_simplices(mesh, x)));
+      REQUIRE(simplices.size() < 100);
+    }
+  }
+}
+//==============================================================================
+TEST_CASE("bounding_volume_hierarchy_ray_intersection",
+          "[bounding_volume_hierarchy][ray]") {
+  auto const mesh = random_simplex_soup<unstructured_triangular_grid3>(5000);
+  auto const r    = ray{vec3{0.5, 0.5, -1.0}, vec3{0.01, -0.02, 1.0}};
+  auto       hit  = std::optional<double>{};
+  for (auto const s : mesh.simplices()) {
+    auto const [v0, v1, v2] = mesh[s];
+    auto const e1           = mesh[v1] - mesh[v0];
+    auto const e2           = mesh[v2] - mesh[v0];
+    auto const p            = cross(r.direction(), e2);
+    auto const inv_det      = 1 / dot(e1, p);
+    auto const o            = r.origin() - mesh[v0];
+    auto const u            = dot(o, p) * inv_det;
+    auto const q            = cross(o, e1);
+    auto const v            = dot(r.direction(), q) * inv_det;
+    auto const t            = dot(e2, q) * inv_det;
+    if (u >= 0 && v >= 0 && u + v <= 1 && t > 0 && (!hit || t < *hit)) {
+      hit = t;
+    }
+  }
+  REQUIRE(hit.has_value());
+  auto const intersection = mesh.check_intersection(r);
+  REQUIRE(intersection.has_value());
+  REQUIRE(intersection->t == Catch::Approx(*hit));
+  REQUIRE(mesh.hierarchy().collect_possible_intersections(r).size() <
+          mesh.simplices().size() / 10);
+}
+//==============================================================================
+}  // namespace tatooine::test
+//==============================================================================
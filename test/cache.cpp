@@ -0,0 +1,79 @@
+#include <tatooine/cache.h>
+#include <tatooine/sharded_cache.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+//==============================================================================
+namespace tatooine::test {
+//==============================================================================
+TEST_CASE("cache_lru", "[cache][lru]") {
+  auto c = cache<int, std::string>{3};
+  c.insert(1, "a");
+  c.insert(2, "b");
+  c.insert(3, "c");
+  // refreshes 1 so that 2 is the least recently used entry
+  REQUIRE(c.at(1).second == "a");
+  c.insert(4, "d");
+  REQUIRE(c.size() == 3);
+  REQUIRE(c.is_cached(1));
+  REQUIRE_FALSE(c.is_cached(2));
+  REQUIRE(c.is_cached(3));
+  REQUIRE(c.is_cached(4));
+
+  SECTION("copy keeps usage order") {
+    auto copy = c;
+    copy.insert(5, "e");
+    REQUIRE_FALSE(copy.is_cached(3));
+    REQUIRE(copy.is_cached(1));
+    REQUIRE(c.is_cached(3));
+  }
+  SECTION("erase") {
+    REQUIRE(c.erase(3));
+    REQUIRE_FALSE(c.erase(3));
+    REQUIRE(c.size() == 2);
+  }
+}
+//==============================================================================
+TEST_CASE("cache_memory_usage", "[cache][memory_usage]") {
+  auto c = cache<int, std::string>{};
+  c.set_memory_usage_function(
+      [](int const, std::string const& s) -> std::uint64_t { return size(s); });
+  c.set_max_memory_usage(10);
+  c.insert(1, "aaaa");
+  c.insert(2, "bbbb");
+  REQUIRE(c.memory_usage() == 8);
+  c.insert(3, "cccc");
+  REQUIRE(c.memory_usage() == 8);
+  REQUIRE_FALSE(c.is_cached(1));
+
+  SECTION("cost weighting") {
+    c.insert(4, "d", 10);
+    REQUIRE(c.size() == 1);
+    REQUIRE(c.memory_usage() == 10);
+  }
+  SECTION("refresh") {
+    c.at(2).second = "bbbbbbbb";
+    c.refresh_memory_usage(2);
+    REQUIRE(c.size() == 1);
+    REQUIRE(c.is_cached(2));
+    REQUIRE(c.memory_usage() == 8);
+  }
+}
+//==============================================================================
+TEST_CASE("sharded_cache", "[cache][sharded_cache]") {
+  auto c = sharded_cache<int, std::string>{};
+  auto [a, inserted] = c.get_or_create(1);
+  REQUIRE(inserted);
+  *a = "a";
+  auto [a2, inserted2] = c.get_or_create(1);
+  REQUIRE_FALSE(inserted2);
+  REQUIRE(a == a2);
+  REQUIRE(c.find(2) == nullptr);
+  c.clear();
+  REQUIRE(c.size() == 0);
+  // values handed out survive eviction
+  REQUIRE(*a == "a");
+}
+//==============================================================================
+}  // namespace tatooine::test
+//==============================================================================
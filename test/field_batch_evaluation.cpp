@@ -0,0 +1,121 @@
+#include <tatooine/analytical/numerical/abcflow.h>
+#include <tatooine/analytical/numerical/doublegyre.h>
+#include <tatooine/analytical/numerical/tornado.h>
+#include <tatooine/discretize_field.h>
+#include <tatooine/random.h>
+#include <tatooine/rectilinear_grid.h>
+
+#include <catch2/catch_test_macros.hpp>
+//==============================================================================
+namespace tatooine::test {
+//==============================================================================
+/// Compares batched evaluation through the polymorphic interface with single
+/// point evaluation. Out-of-domain samples must be NaN in both cases.
+template <typename Real, std::size_t N, typename Tensor>
+auto check_batch_evaluation(polymorphic::field<Real, N, Tensor> const& f,
+                            std::vector<vec<Real, N>> const&           xs,
+                            std::vector<Real> const&                   ts) {
+  auto vs = std::vector<Tensor>(xs.size());
+  f.evaluate(xs, ts, vs);
+  using std::isnan;
+  for (std::size_t i = 0; i < xs.size(); ++i) {
+    auto const expected = f(xs[i], ts.size() == 1 ? ts.front() : ts[i]);
+    if (isnan(expected)) {
+      REQUIRE(isnan(vs[i]));
+    } else if constexpr (is_arithmetic<Tensor>) {
+      REQUIRE(std::abs(vs[i] - expected) < 1e-10);
+    } else {
+      REQUIRE(approx_equal(vs[i], expected, 1e-10));
+    }
+  }
+}
+//==============================================================================
+TEST_CASE("field_batch_evaluation_analytical",
+          "[field][batch][doublegyre][abcflow][tornado]") {
+  auto rand_x = random::uniform{-0.5, 2.5, std::mt19937_64{1234}};
+  auto rand_t = random::uniform{0.0, 10.0, std::mt19937_64{4321}};
+  auto xs2    = std::vector<vec2>(1000);
+  auto xs3    = std::vector<vec3>(1000);
+  auto ts     = std::vector<double>(1000);
+  for (std::size_t i = 0; i < 1000; ++i) {
+    xs2[i] = vec2{rand_x(), rand_x()};
+    xs3[i] = vec3{rand_x(), rand_x(), rand_x() / 2.5};
+    ts[i]  = rand_t();
+  }
+  SECTION("doublegyre") {
+    auto const v = analytical::numerical::doublegyre{};
+    check_batch_evaluation(v, xs2, {2.5});
+    check_batch_evaluation(v, xs2, ts);
+  }
+  SECTION("abcflow") {
+    auto const v = analytical::numerical::abcflow{};
+    check_batch_evaluation(v, xs3, {0.0});
+    check_batch_evaluation(v, xs3, ts);
+  }
+  SECTION("tornado") {
+    auto const v = analytical::numerical::tornado{};
+    check_batch_evaluation(v, xs3, {2.5});
+    check_batch_evaluation(v, xs3, ts);
+  }
+}
+//==============================================================================
+TEST_CASE("field_batch_evaluation_grid_sampler",
+          "[field][batch][rectilinear_grid][sampler]") {
+  auto g = rectilinear_grid{linspace{0.0, 1.0, 11}, linspace{0.0, 2.0, 21}};
+  auto& prop = g.sample_to_vertex_property(
+      [](auto const& x) { return x.x() * x.x() + x.y(); }, "prop");
+  auto rand = random::uniform{-0.1, 2.1, std::mt19937_64{1234}};
+  auto xs   = std::vector<vec2>(1000);
+  for (auto& x : xs) {
+    x = vec2{rand() / 2, rand()};
+  }
+  SECTION("linear") {
+    check_batch_evaluation(prop.linear_sampler(), xs, {0.0});
+  }
+  SECTION("cubic") {
+    check_batch_evaluation(prop.cubic_sampler(), xs, {0.0});
+  }
+}
+//==============================================================================
+TEST_CASE("field_batch_evaluation_sample_to_vector",
+          "[field][batch][discretize]") {
+  auto const v = analytical::numerical::doublegyre{};
+  auto const g =
+      rectilinear_grid{linspace{0.0, 2.0, 21}, linspace{0.0, 1.0, 11}};
+  auto const data = sample_to_vector(v, g, 1.0);
+  REQUIRE(data.size() == g.vertices().size());
+  auto i = std::size_t{};
+  for (auto const vh : g.vertices()) {
+    REQUIRE(approx_equal(data[i++], v(g.vertices()[vh], 1.0), 1e-10));
+  }
+}
+//==============================================================================
+TEST_CASE("field_batch_evaluation_sample_to_vertex_property",
+          "[field][batch][discretize][rectilinear_grid]") {
+  auto const  dg = analytical::numerical::doublegyre{};
+  auto const& v  = static_cast<polymorphic::vectorfield<double, 2> const&>(dg);
+  // more vertices than one block of batched evaluation
+  auto g = rectilinear_grid{linspace{-0.5, 2.5, 101}, linspace{-0.5, 1.5, 67}};
+  auto const check = [&](auto const& prop, double const t) {
+    g.vertices().iterate_indices([&](auto const... is) {
+      auto const expected = v(g.vertex_at(is...), t);
+      if (isnan(expected)) {
+        REQUIRE(isnan(prop(is...)));
+      } else {
+        REQUIRE(approx_equal(prop(is...), expected, 1e-10));
+      }
+    });
+  };
+  SECTION("sequential") {
+    check(g.sample_to_vertex_property(v, "v"), 0.0);
+    check(discretize(v, g, "v_t", 2.5), 2.5);
+  }
+  SECTION("parallel") {
+    check(g.sample_to_vertex_property(v, "v", execution_policy::parallel),
+          0.0);
+    check(discretize(v, g, "v_t", 2.5, execution_policy::parallel), 2.5);
+  }
+}
+//==============================================================================
+}  // namespace tatooine::test
+//==============================================================================
@@ -16,6 +16,54 @@ TEST_CASE("flowmap_agranovsky", "[flowmap][agranovsky]") {
   std::size_t const res_x = 40, res_y = 20;
   auto              fm_agra = agranovsky_flowmap_discretization2{
       fm, t0, tau, delta_t, vec2{0, 0}, vec2{2, 1}, res_x, res_y};
+
+  auto xs = std::vector<vec2>{};
+  for (std::size_t i = 0; i < 100; ++i) {
+    xs.push_back(vec2::randu(0.2, 1.8));
+    xs.back().y() /= 2;
+  }
+  auto in_memory_forward  = std::vector<vec2>{};
+  auto in_memory_backward = std::vector<vec2>{};
+  for (auto const& x : xs) {
+    in_memory_forward.push_back(fm_agra.sample(x, forward_tag{}));
+    in_memory_backward.push_back(fm_agra.sample(x, backward_tag{}));
+  }
+  auto const same = [](vec2 const& lhs, vec2 const& rhs) {
+    for (std::size_t j = 0; j < 2; ++j) {
+      if (!(lhs(j) == rhs(j) || (std::isnan(lhs(j)) && std::isnan(rhs(j))))) {
+        return false;
+      }
+    }
+    return true;
+  };
+  // batched and single sampling must give the in-memory results
+  auto const check_sampling = [&] {
+    auto forward  = xs;
+    auto backward = xs;
+    fm_agra.sample(forward, forward_tag{});
+    fm_agra.sample(backward, backward_tag{});
+    for (std::size_t i = 0; i < size(xs); ++i) {
+      REQUIRE(same(forward[i], in_memory_forward[i]));
+      REQUIRE(same(backward[i], in_memory_backward[i]));
+      REQUIRE(same(fm_agra.sample(xs[i], forward_tag{}), in_memory_forward[i]));
+      REQUIRE(
+          same(fm_agra.sample(xs[i], backward_tag{}), in_memory_backward[i]));
+    }
+  };
+
+  SECTION("batched sampling") { check_sampling(); }
+  SECTION("batched sampling with steps written to disk") {
+    fm_agra.write_to_disk();
+    for (auto const& path : fm_agra.filepaths_to_steps()) {
+      REQUIRE(filesystem::exists(path));
+    }
+    check_sampling();
+    fm_agra.write_to_disk(false);
+    check_sampling();
+    for (auto const& path : fm_agra.filepaths_to_steps()) {
+      filesystem::remove(path);
+    }
+  }
 }
 //==============================================================================
 }  // namespace tatooine::test
@@ -27,5 +27,45 @@ TEST_CASE("ftle_doublegyre", "[ftle][doublegyre][dg]") {
   f(vec{1.0, 0.5}, 0);
 }
 //==============================================================================
+TEST_CASE("ftle_grid_slices", "[ftle][doublegyre][dg][grid]") {
+  auto const v    = doublegyre{};
+  auto       phi  = flowmap(v);
+  auto const t0   = real_number{0};
+  auto const tau  = real_number{5};
+  auto       grid = rectilinear_grid{linspace{0.0, 2.0, 41},
+                               linspace{0.0, 1.0, 21}};
+
+  auto const& ftle_prop = ftle(grid, phi, t0, tau, execution_policy::parallel);
+
+  // reference: flowmap and its gradient sampled on the whole grid
+  auto const& phi_prop = grid.sample_to_vertex_property(
+      [&](auto const& x) { return phi(x, t0, tau); }, "phi");
+  auto const nabla_phi = diff(phi_prop);
+  grid.vertices().iterate_indices([&](auto const... is) {
+    auto const& g   = nabla_phi(is...);
+    auto const  ref = gcem::log(gcem::sqrt(
+                         eigenvalues_sym(transposed(g) * g)(1))) /
+                     std::abs(tau);
+    if (std::isnan(ref)) {
+      REQUIRE(std::isnan(ftle_prop(is...)));
+    } else {
+      REQUIRE(std::abs(ftle_prop(is...) - ref) < 1e-8);
+    }
+  });
+
+  SECTION("streamed slices") {
+    auto num_slices = std::size_t{};
+    ftle_slices(grid, phi, t0, tau, [&](std::size_t const k, auto const& s) {
+      REQUIRE(k == num_slices++);
+      REQUIRE(s.num_components() == grid.size(0));
+      for (std::size_t i = 0; i < grid.size(0); ++i) {
+        REQUIRE((s(i) == ftle_prop(i, k) ||
+                 (std::isnan(s(i)) && std::isnan(ftle_prop(i, k)))));
+      }
+    });
+    REQUIRE(num_slices == grid.size(1));
+  }
+}
+//==============================================================================
 }  // namespace tatooine::test
 //==============================================================================
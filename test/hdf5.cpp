@@ -25,6 +25,43 @@ TEST_CASE("hdf5_dataset_creation", "[hdf5][dataset][creation]") {
   filesystem::remove(filepath);
 }
 //==============================================================================
+TEST_CASE("hdf5_dataset_copy_and_move", "[hdf5][dataset][copy][move]") {
+  auto filepath = filesystem::path{"hdf5_unittest_dataset_copy_and_move.h5"};
+  if (filesystem::exists(filepath)) {
+    filesystem::remove(filepath);
+  }
+  {
+    auto       f  = hdf5::file{filepath};
+    auto       d  = f.create_dataset<int>("d", 4);
+    auto const id = d.id();
+    REQUIRE(H5Iget_ref(id) == 1);
+    {
+      auto const copy = d;
+      REQUIRE(copy.id() == id);
+      REQUIRE(H5Iget_ref(id) == 2);
+    }
+    REQUIRE(H5Iget_ref(id) == 1);
+
+    auto moved = std::move(d);
+    REQUIRE(moved.id() == id);
+    REQUIRE(d.id() == H5I_INVALID_HID);
+    REQUIRE(H5Iget_ref(id) == 1);
+
+    auto       other    = f.create_dataset<int>("other", 4);
+    auto const other_id = other.id();
+    other               = std::move(moved);
+    REQUIRE(H5Iis_valid(other_id) <= 0);
+    REQUIRE(other.id() == id);
+    REQUIRE(moved.id() == H5I_INVALID_HID);
+    REQUIRE(H5Iget_ref(id) == 1);
+
+    auto const write = std::vector<int>{1, 2, 3, 4};
+    other.write(write);
+    REQUIRE(other.read_as_vector() == write);
+  }
+  filesystem::remove(filepath);
+}
+//==============================================================================
 TEST_CASE("hdf5_read_chunk", "[hdf5][read][chunk]") {
   using value_type = int;
   auto filepath    = filesystem::path{"hdf5_unittest_chunk.h5"};
@@ -91,6 +128,213 @@ TEST_CASE("hdf5_read_chunk", "[hdf5][read][chunk]") {
   }
 }
 //==============================================================================
+TEST_CASE("hdf5_lazy_reader_eviction", "[hdf5][lazy_reader][eviction]") {
+  using value_type = int;
+  auto filepath    = filesystem::path{"hdf5_unittest_lazy_reader_eviction.h5"};
+  auto array_name  = std::string{"Array"};
+  auto full_size   = std::vector<size_t>{32, 32, 32};
+  auto data_src    = dynamic_multidim_array<value_type>{
+      full_size[0], full_size[1], full_size[2]};
+  boost::iota(data_src.internal_container(), 1);
+  if (filesystem::exists(filepath)) {
+    filesystem::remove(filepath);
+  }
+  {
+    auto out     = hdf5::file{filepath};
+    auto arr_out = out.create_dataset<value_type>(array_name, full_size[0],
+                                                  full_size[1], full_size[2]);
+    arr_out.write(data_src);
+  }
+  auto in       = hdf5::file{filepath};
+  auto arr_in   = in.dataset<value_type>(array_name);
+  auto arr_lazy = arr_in.read_lazy({8, 8, 8});
+  auto const chunk_memory_usage = 8 * 8 * 8 * sizeof(value_type);
+
+  SECTION("memory budget") {
+    arr_lazy.set_max_memory_usage(4 * chunk_memory_usage);
+    for_loop(
+        [&](auto const... is) {
+          REQUIRE(arr_lazy(is...) == data_src(is...));
+          REQUIRE(arr_lazy.memory_usage() <= 4 * chunk_memory_usage);
+        },
+        full_size[0], full_size[1], full_size[2]);
+    REQUIRE(arr_lazy.num_chunks_loaded() <= 4);
+    REQUIRE(arr_lazy.num_misses() >= arr_lazy.num_chunks());
+    REQUIRE(arr_lazy.num_misses() ==
+            arr_lazy.num_evictions() + arr_lazy.num_chunks_loaded());
+  }
+  SECTION("chunk budget in parallel") {
+    arr_lazy.set_max_num_chunks_loaded(8);
+    auto m = std::mutex{};
+    for (size_t i = 0; i < 2; ++i) {
+      for_loop(
+          [&](auto const... is) {
+            auto const v = arr_lazy(is...);
+            auto       l = std::lock_guard{m};
+            REQUIRE(v == data_src(is...));
+          },
+          execution_policy::parallel, full_size[0], full_size[1],
+          full_size[2]);
+    }
+    REQUIRE(arr_lazy.num_evictions() > 0);
+    REQUIRE(arr_lazy.num_misses() ==
+            arr_lazy.num_evictions() + arr_lazy.num_chunks_loaded());
+  }
+  SECTION("pinned references") {
+    arr_lazy.set_max_num_chunks_loaded(2);
+    {
+      auto const  pin   = arr_lazy.pin();
+      auto const& first = arr_lazy.at(0, 0, 0);
+      for_loop([&](auto const... is) { arr_lazy.at(is...); }, full_size[0],
+               full_size[1], full_size[2]);
+      REQUIRE(arr_lazy.num_evictions() > 0);
+      REQUIRE(arr_lazy.num_retired_chunks() > 0);
+      REQUIRE(first == data_src(0, 0, 0));
+    }
+    REQUIRE(arr_lazy.num_retired_chunks() == 0);
+    arr_lazy.at(0, 0, 0);
+    arr_lazy.at(31, 31, 31);
+    REQUIRE(arr_lazy.num_retired_chunks() == 0);
+  }
+  SECTION("prefetching") {
+    arr_lazy.set_max_num_chunks_loaded(16);
+    arr_lazy.start_prefetching(2, 1);
+    for_loop(
+        [&](auto const... is) { REQUIRE(arr_lazy(is...) == data_src(is...)); },
+        full_size[0], full_size[1], full_size[2]);
+    arr_lazy.stop_prefetching();
+    REQUIRE_FALSE(arr_lazy.is_prefetching());
+    REQUIRE(arr_lazy.num_prefetch_hits() <= arr_lazy.num_prefetched());
+    REQUIRE(arr_lazy.num_misses() + arr_lazy.num_prefetched() ==
+            arr_lazy.num_evictions() + arr_lazy.num_chunks_loaded());
+  }
+  SECTION("prefetching along the access direction") {
+    arr_lazy.set_max_num_chunks_loaded(8);
+    arr_lazy.start_prefetching(1, 2);
+    for (std::size_t x = 0; x < full_size[0]; ++x) {
+      REQUIRE(arr_lazy(x, 0, 0) == data_src(x, 0, 0));
+    }
+    arr_lazy.stop_prefetching();
+    // only the first access has no direction and queues the direct neighbors
+    // of the first chunk
+    auto num_off_row = std::size_t{};
+    for (auto const c : arr_lazy.chunks_loaded()) {
+      auto const cis = arr_lazy.chunk_indices_from_plain_chunk_index(c);
+      num_off_row += cis[1] != 0 || cis[2] != 0 ? 1 : 0;
+    }
+    REQUIRE(num_off_row <= 2);
+    REQUIRE(arr_lazy.num_prefetched() <= 2 + arr_lazy.chunk_size(0) - 1);
+  }
+  filesystem::remove(filepath);
+}
+//==============================================================================
+TEST_CASE("hdf5_lazy_vertex_property_sampler_eviction",
+          "[hdf5][lazy_reader][eviction][rectilinear_grid][sampler]") {
+  using value_type = double;
+  auto filepath =
+      filesystem::path{"hdf5_unittest_lazy_vertex_property_sampler.h5"};
+  if (filesystem::exists(filepath)) {
+    filesystem::remove(filepath);
+  }
+  auto grid = rectilinear_grid{linspace{0.0, 1.0, 17}, linspace{0.0, 1.0, 17},
+                               linspace{0.0, 1.0, 17}};
+  auto const& mem = grid.sample_to_vertex_property(
+      [](auto const& x) { return x.x() * x.x() + 2 * x.y() - x.z() * x.y(); },
+      "mem");
+  {
+    auto data = dynamic_multidim_array<value_type>{grid.size(0), grid.size(1),
+                                                   grid.size(2)};
+    grid.vertices().iterate_indices(
+        [&](auto const... is) { data(is...) = mem(is...); });
+    auto out = hdf5::file{filepath};
+    auto arr = out.create_dataset<value_type>("lazy", grid.size(0),
+                                              grid.size(1), grid.size(2));
+    arr.write(data);
+  }
+  grid.set_chunk_size_for_lazy_properties(4);
+  auto& lazy = grid.insert_hdf5_lazy_vertex_property<value_type>(filepath,
+                                                                  "lazy");
+  auto rand = random::uniform{0.0, 1.0, std::mt19937_64{1234}};
+  // every cell of a linear sampler touches up to 8 chunks
+  for (std::size_t budget : {1, 2}) {
+    lazy.set_max_num_chunks_loaded(budget);
+    auto const lazy_sampler = lazy.linear_sampler();
+    auto const mem_sampler  = mem.linear_sampler();
+    auto const lazy_diff    = diff(lazy_sampler);
+    auto const mem_diff     = diff(mem_sampler);
+    auto const check        = [&](auto const& x) {
+      REQUIRE(lazy_sampler(x) == mem_sampler(x));
+      REQUIRE(approx_equal(lazy_diff.sample(x(0), x(1), x(2)),
+                           mem_diff.sample(x(0), x(1), x(2)), 1e-12));
+    };
+    for (std::size_t i = 0; i < 1000; ++i) {
+      check(vec3{rand(), rand(), rand()});
+    }
+    // cells that straddle chunk boundaries in all directions
+    for (auto const c : {0.2, 0.45, 0.7}) {
+      check(vec3{c, c, c});
+    }
+    REQUIRE(lazy.num_evictions() > 0);
+    REQUIRE(lazy.num_chunks_loaded() <= budget);
+  }
+  filesystem::remove(filepath);
+}
+//==============================================================================
+TEST_CASE("hdf5_compression", "[hdf5][compression][chunk_cache]") {
+  using value_type = double;
+  auto filepath    = filesystem::path{"hdf5_unittest_compression.h5"};
+  auto full_size   = std::vector<size_t>{32, 32, 32};
+  auto data_src    = dynamic_multidim_array<value_type>{
+      full_size[0], full_size[1], full_size[2]};
+  boost::iota(data_src.internal_container(), 1);
+  if (filesystem::exists(filepath)) {
+    filesystem::remove(filepath);
+  }
+  auto const num_bytes = data_src.num_components() * sizeof(value_type);
+  {
+    auto out = hdf5::file{filepath};
+    auto creation = hdf5::property_list::dataset_creation();
+    creation.set_chunk(16, 16, 16);
+    creation.set_shuffle();
+    creation.set_deflate(4);
+    auto compressed = out.create_dataset<value_type>(
+        "compressed", creation, full_size[0], full_size[1], full_size[2]);
+    compressed.write(data_src);
+    REQUIRE(compressed.storage_size() < num_bytes);
+
+    // filters without explicit chunks
+    auto deflate_only = hdf5::property_list::dataset_creation();
+    deflate_only.set_deflate();
+    auto auto_chunked = out.create_dataset<value_type>(
+        "auto_chunked", deflate_only, hdf5::property_list::dataset_access(),
+        full_size[0], full_size[1], full_size[2]);
+    auto_chunked.write(data_src);
+    REQUIRE(auto_chunked.storage_size() < num_bytes);
+  }
+  auto access = hdf5::property_list::dataset_access();
+  access.set_chunk_cache(521, 4 * 16 * 16 * 16 * sizeof(value_type));
+  SECTION("read with chunk cache") {
+    auto in = hdf5::file{filepath};
+    for (auto const& name : {"compressed", "auto_chunked"}) {
+      auto const data = in.dataset<value_type>(name, access).read();
+      for_loop(
+          [&](auto const... is) { REQUIRE(data(is...) == data_src(is...)); },
+          full_size[0], full_size[1], full_size[2]);
+    }
+  }
+  SECTION("lazy vertex property") {
+    auto grid = rectilinear_grid{linspace{0.0, 1.0, full_size[0]},
+                                 linspace{0.0, 1.0, full_size[1]},
+                                 linspace{0.0, 1.0, full_size[2]}};
+    auto const& prop = grid.insert_hdf5_lazy_vertex_property<value_type>(
+        filepath, "compressed", access);
+    for_loop(
+        [&](auto const... is) { REQUIRE(prop(is...) == data_src(is...)); },
+        full_size[0], full_size[1], full_size[2]);
+  }
+  filesystem::remove(filepath);
+}
+//==============================================================================
 TEST_CASE("hdf5_attribute", "[hdf5][attribute]") {
   auto const filepath = filesystem::path{"hdf5_unittest_attribute.h5"};
 
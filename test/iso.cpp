@@ -16,5 +16,30 @@ TEST_CASE("isosurface_abcflow_length", "[iso][isosurface][numerical][abcflow]")
       1);
 }
 //==============================================================================
+TEST_CASE("isosurface_sphere_min_max_octree",
+          "[iso][isosurface][min_max_octree]") {
+  auto  g = rectilinear_grid{linspace{-1.0, 1.0, 41}, linspace{-1.0, 1.0, 37},
+                            linspace{-1.0, 1.0, 33}};
+  auto& s = g.sample_to_vertex_property(
+      [](auto const& x) { return euclidean_length(x); }, "s");
+  auto const tree = min_max_octree<double>{
+      [&](auto const ix, auto const iy, auto const iz) {
+        return s(ix, iy, iz);
+      },
+      {g.size(0), g.size(1), g.size(2)},
+      4};
+  for (auto const radius : {0.1, 0.5, 0.9}) {
+    auto const mesh = isosurface(s, radius);
+    // closed sphere with shared vertices
+    REQUIRE(mesh.vertices().size() == mesh.simplices().size() / 2 + 2);
+    for (auto const v : mesh.vertices()) {
+      REQUIRE(std::abs(euclidean_length(mesh[v]) - radius) < 0.02);
+    }
+    auto const mesh_with_tree = isosurface(s, radius, tree);
+    REQUIRE(mesh_with_tree.vertices().size() == mesh.vertices().size());
+    REQUIRE(mesh_with_tree.simplex_index_data() == mesh.simplex_index_data());
+  }
+}
+//==============================================================================
 }  // namespace tatooine::test
 //==============================================================================
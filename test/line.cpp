@@ -94,5 +94,36 @@ TEST_CASE("line_io", "[line][io]") {
   }
 }
 //==============================================================================
+TEST_CASE("line_merge", "[line][merge]") {
+  auto segments = std::vector<line2>{};
+  // open polyline (0,0) - (1,0) - ... - (5,0) cut into segments that are
+  // shuffled and partly reversed
+  segments.push_back(line2{vec{3.0, 0.0}, vec{2.0, 0.0}});
+  segments.push_back(line2{vec{0.0, 0.0}, vec{1.0, 0.0}});
+  segments.push_back(line2{vec{4.0, 0.0}, vec{4.5, 0.0}, vec{5.0, 0.0}});
+  segments.push_back(line2{vec{2.0, 0.0}, vec{1.0, 0.0}});
+  segments.push_back(line2{vec{3.0, 0.0}, vec{4.0, 0.0}});
+  // closed square
+  segments.push_back(line2{vec{10.0, 10.0}, vec{11.0, 10.0}});
+  segments.push_back(line2{vec{11.0, 11.0}, vec{11.0, 10.0}});
+  segments.push_back(line2{vec{11.0, 11.0}, vec{10.0, 11.0}});
+  segments.push_back(line2{vec{10.0, 11.0}, vec{10.0, 10.0}});
+
+  auto const merged = merge(segments);
+  REQUIRE(merged.size() == 2);
+  auto const& open   = merged[0].is_closed() ? merged[1] : merged[0];
+  auto const& closed = merged[0].is_closed() ? merged[0] : merged[1];
+  REQUIRE_FALSE(open.is_closed());
+  REQUIRE(open.vertices().size() == 7);
+  auto const forward = open.front_vertex()(0) == 0;
+  for (std::size_t i = 0; i < 7; ++i) {
+    auto const expected = std::array{0.0, 1.0, 2.0, 3.0, 4.0, 4.5, 5.0};
+    CAPTURE(i, open.vertex_at(i));
+    REQUIRE(open.vertex_at(i)(0) == expected[forward ? i : 6 - i]);
+  }
+  REQUIRE(closed.is_closed());
+  REQUIRE(closed.vertices().size() == 4);
+}
+//==============================================================================
 }  // namespace tatooine::test
 //==============================================================================
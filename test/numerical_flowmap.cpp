@@ -42,6 +42,30 @@ TEST_CASE("numerical_flowmap_internal_pointer",
   [[maybe_unused]] auto const xn1n5 = fm(vec{0.1, 0.1}, 0, -5);
 }
 //==============================================================================
+TEST_CASE("numerical_flowmap_parallel_caching",
+          "[ode][integrator][integration][flowmap][dg][doublegyre][caching]"
+          "[parallel]") {
+  analytical::numerical::doublegyre v;
+  auto                              fm = flowmap(v);
+  fm.use_caching();
+  auto const seeds =
+      std::vector{vec2{0.1, 0.1}, vec2{0.5, 0.3}, vec2{1.2, 0.7}, vec2{1.8, 0.2}};
+  auto const taus = std::vector{real_number{2}, real_number{-2},
+                                real_number{5}, real_number{-5}};
+  auto       m    = std::mutex{};
+  for_loop(
+      [&](auto const i) {
+        auto const& x0   = seeds[i % seeds.size()];
+        auto const  tau  = taus[(i / seeds.size()) % taus.size()];
+        auto const  x1   = fm(x0, 0, tau);
+        auto const  x1_u = fm.evaluate_uncached(x0, 0, tau);
+        auto        lock = std::lock_guard{m};
+        REQUIRE(approx_equal(x1, x1_u, 1e-4));
+      },
+      execution_policy::parallel, std::size_t(256));
+  REQUIRE(fm.num_cached_curves() == seeds.size());
+}
+//==============================================================================
 }
 //==============================================================================
 
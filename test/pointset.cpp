@@ -3,7 +3,11 @@
 #include <tatooine/rectilinear_grid.h>
 #include <tatooine/test/EqualRange.h>
 
+#include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <thread>
 //==============================================================================
 namespace tatooine::test {
 //==============================================================================
@@ -143,6 +147,126 @@ TEST_CASE_METHOD(pointset3, "pointset_delete_vertex",
 //  REQUIRE((nearest_0_5_2[0] == v1 || nearest_0_5_2[1] == v1));
 //}
 //==============================================================================
+/// Compares kd-tree queries with a brute-force search over all valid vertices.
+auto check_kd_tree_queries(pointset2 const& ps, std::vector<vec2> const& queries) {
+  auto const brute_force = [&](vec2 const& x) {
+    auto ds = std::vector<std::pair<double, int>>{};
+    for (auto const v : ps.vertices()) {
+      ds.emplace_back(squared_euclidean_distance(x, ps[v]),
+                      static_cast<int>(v.index()));
+    }
+    std::ranges::sort(ds);
+    return ds;
+  };
+  auto const [batch_indices, batch_distances] =
+      ps.nearest_neighbors_raw(queries, 5);
+  auto const [batch_radius_indices, batch_radius_distances] =
+      ps.nearest_neighbors_radius_raw(queries, 0.01);
+  for (std::size_t i = 0; i < size(queries); ++i) {
+    auto const expected = brute_force(queries[i]);
+    auto const [indices, distances] = ps.nearest_neighbors_raw(queries[i], 5);
+    REQUIRE(size(indices) == 5);
+    REQUIRE(batch_indices[i] == indices);
+    for (std::size_t j = 0; j < 5; ++j) {
+      REQUIRE(indices[j] == expected[j].second);
+    }
+    auto num_in_radius = std::size_t{};
+    while (expected[num_in_radius].first < 0.01) {
+      ++num_in_radius;
+    }
+    auto const [radius_indices, radius_distances] =
+        ps.nearest_neighbors_radius_raw(queries[i], 0.01);
+    REQUIRE(size(radius_indices) == num_in_radius);
+    REQUIRE(batch_radius_indices[i] == radius_indices);
+    for (std::size_t j = 0; j < num_in_radius; ++j) {
+      REQUIRE(radius_indices[j] == expected[j].second);
+    }
+  }
+}
+//------------------------------------------------------------------------------
+TEST_CASE_METHOD(pointset2, "pointset_kd_tree_delta",
+                 "[pointset][kdtree][delta]") {
+  random::uniform rand{-1.0, 1.0, std::mt19937_64{1234}};
+  for (std::size_t i = 0; i < 1000; ++i) {
+    insert_vertex(rand(), rand());
+  }
+  // builds the tree
+  nearest_neighbors_raw(vec2::zeros(), 1);
+  // the delta exceeds its limit and gets merged in the background
+  for (std::size_t i = 0; i < 2000; ++i) {
+    insert_vertex(rand(), rand());
+  }
+  remove(vertex_handle{10});
+  remove(vertex_handle{2500});
+
+  auto queries = std::vector<vec2>{};
+  for (std::size_t i = 0; i < 50; ++i) {
+    queries.push_back(vec2{rand(), rand()});
+  }
+  SECTION("with delta") { check_kd_tree_queries(*this, queries); }
+  SECTION("frozen") {
+    freeze_kd_tree();
+    check_kd_tree_queries(*this, queries);
+  }
+}
+//------------------------------------------------------------------------------
+TEST_CASE_METHOD(pointset2, "pointset_kd_tree_concurrent_queries",
+                 "[pointset][kdtree][delta][parallel]") {
+  random::uniform rand{-1.0, 1.0, std::mt19937_64{1234}};
+  for (std::size_t i = 0; i < 1000; ++i) {
+    insert_vertex(rand(), rand());
+  }
+  nearest_neighbors_raw(vec2::zeros(), 1);
+  auto queries = std::vector<vec2>{};
+  for (std::size_t i = 0; i < 50; ++i) {
+    queries.push_back(vec2{rand(), rand()});
+  }
+  auto inserted = std::vector<vec2>(4000);
+  for (auto& x : inserted) {
+    x = vec2{rand(), rand()};
+  }
+
+  // queries run while vertices are inserted and removed and background merges
+  // replace the tree
+  auto done         = std::atomic_bool{false};
+  auto num_failures = std::atomic_size_t{};
+  auto readers      = std::vector<std::thread>{};
+  for (std::size_t t = 0; t < 3; ++t) {
+    readers.emplace_back([&] {
+      while (!done) {
+        auto const [batch_indices, batch_distances] =
+            nearest_neighbors_raw(queries, 5);
+        for (std::size_t i = 0; i < size(queries); ++i) {
+          if (size(batch_indices[i]) != 5 ||
+              !std::ranges::is_sorted(batch_distances[i])) {
+            ++num_failures;
+          }
+          auto const [indices, distances] =
+              nearest_neighbors_radius_raw(queries[i], 0.01);
+          if (std::ranges::any_of(distances,
+                                  [](auto const d) { return d >= 0.01; })) {
+            ++num_failures;
+          }
+        }
+      }
+    });
+  }
+  for (std::size_t i = 0; i < size(inserted); ++i) {
+    insert_vertex(inserted[i]);
+    if (i % 8 == 0) {
+      remove(vertex_handle{i});
+    }
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  REQUIRE(num_failures == 0);
+  check_kd_tree_queries(*this, queries);
+  freeze_kd_tree();
+  check_kd_tree_queries(*this, queries);
+}
+//==============================================================================
 TEST_CASE_METHOD(pointset2, "pointset_inverse_distance_weighting_sampler",
                  "[pointset][inverse_distance_weighting_sampler]") {
   random::uniform rand{-1.0, 1.0, std::mt19937_64{1234}};
@@ -157,6 +281,51 @@ TEST_CASE_METHOD(pointset2, "pointset_inverse_distance_weighting_sampler",
   gr.sample_to_vertex_property(sampler, "interpolated_data");
 }
 //==============================================================================
+TEST_CASE_METHOD(pointset2,
+                 "pointset_partition_of_unity_radial_basis_functions",
+                 "[pointset][radial_basis_functions][partition_of_unity]") {
+  random::uniform rand{-1.0, 1.0, std::mt19937_64{1234}};
+  auto&           linear = scalar_vertex_property("linear");
+  auto&           vector = vec2_vertex_property("vector");
+  for (std::size_t i = 0; i < 5000; ++i) {
+    auto const v = insert_vertex(rand(), rand());
+    linear[v]    = 2 * at(v).x() - 3 * at(v).y() + 1;
+    vector[v]    = vec2{std::sin(at(v).x()), std::cos(at(v).y())};
+  }
+  auto const rbf = partition_of_unity_radial_basis_functions(32);
+  REQUIRE(rbf.patches().size() > 1);
+  // both samplers share the factorizations of rbf
+  auto const linear_sampler = rbf.sampler(linear);
+  auto const vector_sampler = rbf.sampler(vector);
+  SECTION("interpolates vertices") {
+    for (std::size_t i = 0; i < 100; ++i) {
+      auto const v = vertex_handle{i * 50};
+      REQUIRE(linear_sampler(at(v)) ==
+              Catch::Approx(linear[v]).margin(1e-6));
+      REQUIRE(vector_sampler(at(v))(0) ==
+              Catch::Approx(vector[v](0)).margin(1e-6));
+      REQUIRE(vector_sampler(at(v))(1) ==
+              Catch::Approx(vector[v](1)).margin(1e-6));
+    }
+  }
+  SECTION("reproduces linear functions") {
+    for (std::size_t i = 0; i < 100; ++i) {
+      auto const x = vec2{rand() * 0.9, rand() * 0.9};
+      REQUIRE(linear_sampler(x) ==
+              Catch::Approx(2 * x.x() - 3 * x.y() + 1).margin(1e-6));
+    }
+  }
+  SECTION("approximates smooth functions") {
+    for (std::size_t i = 0; i < 100; ++i) {
+      auto const x = vec2{rand() * 0.9, rand() * 0.9};
+      REQUIRE(vector_sampler(x)(0) ==
+              Catch::Approx(std::sin(x.x())).margin(1e-3));
+      REQUIRE(vector_sampler(x)(1) ==
+              Catch::Approx(std::cos(x.y())).margin(1e-3));
+    }
+  }
+}
+//==============================================================================
 TEST_CASE_METHOD(pointset2, "pointset_vertex_range",
                  "[pointset][range][vertex_container][iterators]") {
   using vh = vertex_handle;
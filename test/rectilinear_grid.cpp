@@ -296,6 +296,37 @@ TEST_CASE("rectilinear_grid_finite_differences_stencil_coefficients",
       ApproxRange(std::vector{25.0 / 63.0, -196.0 / 63.0, 171.0 / 63.0}));
 }
 //==============================================================================
+TEST_CASE("rectilinear_grid_vertex_property_sampler_cubic_short_dimension",
+          "[rectilinear_grid][sampler][cubic]") {
+  // second dimension has less vertices than the default stencil size
+  auto g = rectilinear_grid{linspace{-1.0, 1.0, 64}, linspace{-1.0, 1.0, 3}};
+  auto const& prop = g.sample_to_vertex_property(
+      [](auto const& x) { return x(0) * x(0) + x(1); }, "prop");
+  auto sampler = prop.cubic_sampler();
+  REQUIRE(sampler(0.3, 0.2) == Approx(0.29).margin(1e-3));
+  REQUIRE(sampler(-0.7, -0.9) == Approx(-0.41).margin(1e-3));
+}
+//==============================================================================
+TEST_CASE("rectilinear_grid_vertex_property_sampler_cubic_changed_grid",
+          "[rectilinear_grid][sampler][cubic]") {
+  auto g = rectilinear_grid{linspace{0.0, 1.0, 4}, linspace{0.0, 1.0, 11}};
+  auto& prop = g.sample_to_vertex_property(
+      [](auto const& x) { return x(0) * x(0) * x(0) + x(1); }, "prop");
+  auto sampler = prop.cubic_sampler();
+  REQUIRE(sampler(0.5, 0.5) == Approx(0.625).margin(1e-2));
+  // invalidates the finite differences tables the sampler fetched
+  g.push_back<0>();
+  g.push_back<0>();
+  for_loop(
+      [&](auto const i, auto const j) {
+        auto const x = g.vertex_at(i, j);
+        prop(i, j)   = x(0) * x(0) * x(0) + x(1);
+      },
+      g.size<0>(), g.size<1>());
+  REQUIRE(sampler(1.5, 0.5) == Approx(prop.cubic_sampler()(1.5, 0.5)));
+  REQUIRE(sampler(1.5, 0.5) == Approx(3.875).margin(1e-2));
+}
+//==============================================================================
 // TEST_CASE("rectilinear_grid_vertex_property_sampler_vec",
 //          "[rectilinear_grid][sampler][linear][vec]") {
 //  auto  g = rectilinear_grid{linspace{0.0, 10.0, 11}, linspace{0.0, 10.0,
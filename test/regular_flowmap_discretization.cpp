@@ -0,0 +1,86 @@
+#include <tatooine/analytical/numerical/doublegyre.h>
+#include <tatooine/numerical_flowmap.h>
+#include <tatooine/regular_flowmap_discretization.h>
+
+#include <catch2/catch_test_macros.hpp>
+//==============================================================================
+namespace tatooine::test {
+//==============================================================================
+#if TATOOINE_CGAL_AVAILABLE
+TEST_CASE("regular_flowmap_discretization_read_write",
+          "[regular_flowmap_discretization][io]") {
+  auto v  = analytical::numerical::doublegyre{};
+  auto fm = flowmap(v);
+  auto written = regular_flowmap_discretization2{
+      fm, real_number{0}, real_number{5}, vec2{0, 0}, vec2{2, 1}, 21, 11};
+  auto const path =
+      filesystem::path{"regular_flowmap_discretization_read_write.bin"};
+  written.write(path);
+  auto loaded = regular_flowmap_discretization2{path};
+  filesystem::remove(path);
+
+  // particles leaving the domain of the double gyre are NaN
+  auto const same = [](vec2 const& lhs, vec2 const& rhs) {
+    for (std::size_t j = 0; j < 2; ++j) {
+      if (!(lhs(j) == rhs(j) || (std::isnan(lhs(j)) && std::isnan(rhs(j))))) {
+        return false;
+      }
+    }
+    return true;
+  };
+  auto check_direction = [&](forward_or_backward_tag auto const direction) {
+    auto const& written_grid    = written.grid(direction);
+    auto const& read_grid       = loaded.grid(direction);
+    auto const& written_flowmap = written.flowmap(direction);
+    auto const& read_flowmap    = loaded.flowmap(direction);
+    REQUIRE(read_grid.vertices().size() == written_grid.vertices().size());
+    for (auto const vh : written_grid.vertices()) {
+      REQUIRE(same(read_grid.vertex_at(vh), written_grid.vertex_at(vh)));
+      REQUIRE(same(read_flowmap[vh], written_flowmap[vh]));
+    }
+  };
+  check_direction(forward);
+  check_direction(backward);
+  for (std::size_t i = 0; i < 10; ++i) {
+    auto x = vec2::randu(0.2, 1.8);
+    x.y() /= 2;
+    REQUIRE(same(loaded.sample(x, forward), written.sample(x, forward)));
+    REQUIRE(
+        same(loaded.sample(x, backward), written.sample(x, backward)));
+  }
+}
+//==============================================================================
+TEST_CASE("regular_flowmap_discretization_read_rejects_invalid_files",
+          "[regular_flowmap_discretization][io]") {
+  auto const path = filesystem::path{
+      "regular_flowmap_discretization_read_rejects_invalid_files.bin"};
+  auto write_header = [&](std::uint64_t const magic_number,
+                          std::uint64_t const num_vertices) {
+    auto file        = std::ofstream{path, std::ios::binary};
+    auto write_value = [&]<typename T>(T const& val) {
+      file.write(reinterpret_cast<char const*>(&val), sizeof(T));
+    };
+    write_value(magic_number);
+    write_value(std::uint64_t{2});
+    write_value(std::uint64_t{sizeof(real_number)});
+    write_value(real_number{0});
+    write_value(real_number{1});
+    write_value(real_number{1});
+    write_value(num_vertices);
+  };
+  auto d = regular_flowmap_discretization2{};
+  SECTION("wrong magic number") {
+    write_header(0, 0);
+    REQUIRE_THROWS_AS(d.read(path), std::runtime_error);
+  }
+  SECTION("more vertices than the file holds") {
+    write_header(regular_flowmap_discretization2::file_magic_number,
+                 std::uint64_t{1} << 60);
+    REQUIRE_THROWS_AS(d.read(path), std::runtime_error);
+  }
+  filesystem::remove(path);
+}
+#endif
+//==============================================================================
+}  // namespace tatooine::test
+//==============================================================================
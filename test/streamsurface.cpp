@@ -57,7 +57,20 @@ TEST_CASE(
   seedcurve.push_back(0.9, 0.2, 0.0);
   seedcurve.parameterization().back() = 1;
   auto ssf                            = streamsurface{flowmap(vst), seedcurve};
-  ssf.discretize<hultquist_discretization>(10UL, 0.1, -2.0, 2.0);
+  auto discretization =
+      ssf.discretize<hultquist_discretization>(10UL, 0.1, -2.0, 2.0);
+  REQUIRE(discretization.vertices().size() > 10 * 41);
+  REQUIRE(discretization.triangles().size() > 0);
+  // the boundary particles are never inserted or removed by refinement so
+  // advecting them front by front must end up where a direct integration from
+  // the seedcurve ends up
+  for (auto const v : discretization.vertices()) {
+    auto const& uv = discretization.uv(v);
+    if (uv(0) == 0 || uv(0) == 1) {
+      CAPTURE(uv, discretization[v], ssf(uv));
+      REQUIRE(approx_equal(discretization[v], ssf(uv), 1e-4));
+    }
+  }
 }
 //==============================================================================
 }  // namespace tatooine::test
@@ -262,6 +262,125 @@ TEST_CASE("tensor_eigenvalue", "[tensor][eigenvalue]") {
 }
 #endif
 //==============================================================================
+TEST_CASE("tensor_eigenvalue_sym", "[tensor][eigenvalue][symmetric]") {
+  auto const eps              = 1e-10;
+  auto const check_eigenpairs = [eps](auto const& A) {
+    auto constexpr N              = tensor_dimension<decltype(A), 0>;
+    auto const [eigvecs, eigvals] = eigenvectors_sym(A);
+    auto const eigvals2           = eigenvalues_sym(A);
+    auto const scale =
+        std::max(std::abs(eigvals(0)), std::abs(eigvals(N - 1))) + 1;
+    for (std::size_t i = 0; i < N; ++i) {
+      CAPTURE(A, eigvals, eigvals2, eigvecs);
+      REQUIRE(std::abs(eigvals(i) - eigvals2(i)) < 1e-8 * scale);
+      REQUIRE(std::abs(euclidean_length(eigvecs.col(i)) - 1) < eps);
+      REQUIRE(euclidean_length(A * eigvecs.col(i) -
+                               eigvals(i) * eigvecs.col(i)) < eps * scale);
+      if (i > 0) {
+        REQUIRE(eigvals(i - 1) <= eigvals(i));
+        REQUIRE(std::abs(dot(eigvecs.col(i - 1), eigvecs.col(i))) < eps);
+      }
+    }
+  };
+  SECTION("2x2") {
+    check_eigenpairs(mat2{{2, 0}, {0, 1}});
+    check_eigenpairs(mat2{{1.0, 1e-12}, {1e-12, 1.0}});
+    for (std::size_t i = 0; i < 100; ++i) {
+      auto const B = mat2::randu(-1, 1);
+      check_eigenpairs(mat2{B + transposed(B)});
+    }
+  }
+  SECTION("3x3") {
+    check_eigenpairs(mat3::eye());
+    check_eigenpairs(mat3{{3, 0, 0}, {0, 1, 0}, {0, 0, 2}});
+    check_eigenpairs(mat3{{2, 1, 0}, {1, 2, 0}, {0, 0, 3}});
+    for (std::size_t i = 0; i < 100; ++i) {
+      auto const B = mat3::randu(-1, 1);
+      check_eigenpairs(mat3{B + transposed(B)});
+    }
+  }
+  // The batched matrices are built as Q * diag(lambda) * Q^T with a random
+  // rotation Q so that their eigenvalues are known without solving anything.
+  auto constexpr n      = std::size_t(33);
+  auto const     sorted = [](auto lambda) {
+    std::sort(lambda.data(), lambda.data() + lambda.dimension(0));
+    return lambda;
+  };
+  auto const rotation2 = [](double const a) {
+    auto const c = std::cos(a), s = std::sin(a);
+    return mat2{{c, -s}, {s, c}};
+  };
+  auto const rotation3 = [](vec3 const& a) {
+    auto const c = vec3{std::cos(a(0)), std::cos(a(1)), std::cos(a(2))};
+    auto const s = vec3{std::sin(a(0)), std::sin(a(1)), std::sin(a(2))};
+    auto const Rx =
+        mat3{{1.0, 0.0, 0.0}, {0.0, c(0), -s(0)}, {0.0, s(0), c(0)}};
+    auto const Ry =
+        mat3{{c(1), 0.0, s(1)}, {0.0, 1.0, 0.0}, {-s(1), 0.0, c(1)}};
+    auto const Rz =
+        mat3{{c(2), -s(2), 0.0}, {s(2), c(2), 0.0}, {0.0, 0.0, 1.0}};
+    return mat3{Rz * Ry * Rx};
+  };
+  SECTION("batched 2x2") {
+    auto expected = std::vector<vec2>(n);
+    auto a        = std::array<std::vector<double>, 3>{};
+    auto lambda   = std::array<std::vector<double>, 2>{};
+    for (auto& c : a) {
+      c.resize(n);
+    }
+    for (auto& l : lambda) {
+      l.resize(n);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      expected[i]  = sorted(vec2::randu(-2, 2));
+      auto const Q = rotation2(random::uniform{0.0, 2 * M_PI}());
+      auto const A = mat2{Q * diag(expected[i]) * transposed(Q)};
+      a[0][i]      = A(0, 0);
+      a[1][i]      = A(0, 1);
+      a[2][i]      = A(1, 1);
+    }
+    eigenvalues_sym(n, a[0].data(), a[1].data(), a[2].data(),
+                    lambda[0].data(), lambda[1].data());
+    for (std::size_t i = 0; i < n; ++i) {
+      for (std::size_t j = 0; j < 2; ++j) {
+        CAPTURE(i, j, expected[i]);
+        REQUIRE(std::abs(lambda[j][i] - expected[i](j)) < eps * 10);
+      }
+    }
+  }
+  SECTION("batched 3x3") {
+    auto expected = std::vector<vec3>(n);
+    auto a        = std::array<std::vector<double>, 6>{};
+    auto lambda   = std::array<std::vector<double>, 3>{};
+    for (auto& c : a) {
+      c.resize(n);
+    }
+    for (auto& l : lambda) {
+      l.resize(n);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      expected[i]  = sorted(vec3::randu(-2, 2));
+      auto const Q = rotation3(vec3::randu(0, 2 * M_PI));
+      auto const A = mat3{Q * diag(expected[i]) * transposed(Q)};
+      a[0][i]      = A(0, 0);
+      a[1][i]      = A(0, 1);
+      a[2][i]      = A(0, 2);
+      a[3][i]      = A(1, 1);
+      a[4][i]      = A(1, 2);
+      a[5][i]      = A(2, 2);
+    }
+    eigenvalues_sym(n, a[0].data(), a[1].data(), a[2].data(), a[3].data(),
+                    a[4].data(), a[5].data(), lambda[0].data(),
+                    lambda[1].data(), lambda[2].data());
+    for (std::size_t i = 0; i < n; ++i) {
+      for (std::size_t j = 0; j < 3; ++j) {
+        CAPTURE(i, j, expected[i]);
+        REQUIRE(std::abs(lambda[j][i] - expected[i](j)) < 1e-8);
+      }
+    }
+  }
+}
+//==============================================================================
 TEST_CASE("tensor_compare", "[tensor][compare]") {
   vec v1{0.1, 0.1};
   vec v2{0.2, 0.2};
@@ -67,6 +67,43 @@ TEST_CASE_METHOD(
   REQUIRE(find(simplices(), c0) == end(simplices()));
 }
 //==============================================================================
+TEST_CASE_METHOD(
+    unstructured_triangular_grid3,
+    "unstructured_triangular_grid_remove_duplicate_vertices",
+    "[unstructured_triangular_grid][triangular_grid][remove][vertex]") {
+  // two triangles of a soup that share an edge
+  auto v0 = insert_vertex(0, 0, 0);
+  auto v1 = insert_vertex(1, 0, 0);
+  auto v2 = insert_vertex(1, 1, 0);
+  auto v3 = insert_vertex(0, 0, 1e-8);
+  auto v4 = insert_vertex(1, 1, 0);
+  auto v5 = insert_vertex(0, 1, 0);
+  auto c0 = insert_simplex(v0, v1, v2);
+  auto c1 = insert_simplex(v3, v4, v5);
+
+  SECTION("exact") {
+    remove_duplicate_vertices(execution_policy::sequential);
+    REQUIRE(vertices().size() == 5);
+    auto const [w0, w1, w2] = at(c1);
+    REQUIRE(w0 == v3);
+    REQUIRE(w1 == v2);
+    REQUIRE(w2 == v5);
+  }
+  SECTION("eps") {
+    remove_duplicate_vertices(1e-12);
+    REQUIRE(vertices().size() == 4);
+    auto const [w0, w1, w2] = at(c1);
+    REQUIRE(w0 == v0);
+    REQUIRE(w1 == v2);
+    REQUIRE(w2 == v5);
+    auto const [u0, u1, u2] = at(c0);
+    REQUIRE(u0 == v0);
+    REQUIRE(u1 == v1);
+    REQUIRE(u2 == v2);
+  }
+  REQUIRE(simplices().size() == 2);
+}
+//==============================================================================
 TEST_CASE_METHOD(unstructured_triangular_grid2,
                  "unstructured_triangular_grid_simplex_contains_vertex",
                  "[unstructured_triangular_grid][triangular_grid][contains]["
@@ -264,5 +301,59 @@ TEST_CASE_METHOD(unstructured_triangular_grid2,
   REQUIRE(sampler(vec2{1.0, 1.0}) == Approx(4));
 }
 //==============================================================================
+TEST_CASE_METHOD(unstructured_triangular_grid2,
+                 "unstructured_triangular_grid_point_locator",
+                 "[unstructured_triangular_grid][point_locator]") {
+  auto const n = std::size_t(16);
+  for (std::size_t iy = 0; iy <= n; ++iy) {
+    for (std::size_t ix = 0; ix <= n; ++ix) {
+      insert_vertex(static_cast<real_type>(ix) / n,
+                    static_cast<real_type>(iy) / n);
+    }
+  }
+  auto const v = [n](std::size_t const ix, std::size_t const iy) {
+    return vertex_handle{ix + iy * (n + 1)};
+  };
+  for (std::size_t iy = 0; iy < n; ++iy) {
+    for (std::size_t ix = 0; ix < n; ++ix) {
+      insert_simplex(v(ix, iy), v(ix + 1, iy), v(ix + 1, iy + 1));
+      insert_simplex(v(ix, iy), v(ix + 1, iy + 1), v(ix, iy + 1));
+    }
+  }
+  auto& prop = sample_to_vertex_property(
+      [](pos_type const& x) { return x(0) + 2 * x(1); }, "prop");
+
+  auto const& locator = point_locator();
+  SECTION("neighbors") {
+    // first simplex of the lower left cell
+    auto const s = simplex_handle{0};
+    REQUIRE(locator.neighbor(s, 0) == simplex_handle{3});
+    REQUIRE(locator.neighbor(s, 1) == simplex_handle{1});
+    REQUIRE_FALSE(locator.neighbor(s, 2).has_value());
+  }
+  SECTION("walk") {
+    auto const x = vec2{0.9, 0.8};
+    auto const l = locator.locate(x, simplex_handle{0});
+    REQUIRE(l.has_value());
+    REQUIRE(l->simplex == locator.locate(x)->simplex);
+    auto const [v0, v1, v2] = at(l->simplex);
+    auto const& b           = l->barycentric_coordinates;
+    REQUIRE(b(0) * at(v0)(0) + b(1) * at(v1)(0) + b(2) * at(v2)(0) ==
+            Approx(0.9));
+    REQUIRE(b(0) * at(v0)(1) + b(1) * at(v1)(1) + b(2) * at(v2)(1) ==
+            Approx(0.8));
+    REQUIRE_FALSE(locator.locate(vec2{1.5, 0.5}, simplex_handle{0}));
+  }
+  SECTION("sampler") {
+    auto sampler = this->sampler(prop);
+    for (std::size_t i = 0; i <= 100; ++i) {
+      auto const t = static_cast<real_type>(i) / 100;
+      auto const x = vec2{t, 0.5 + 0.4 * std::sin(t * 6)};
+      REQUIRE(sampler(x) == Approx(x(0) + 2 * x(1)));
+    }
+    REQUIRE(std::isnan(sampler(vec2{-0.5, 0.5})));
+  }
+}
+//==============================================================================
 }  // namespace tatooine::test
 //==============================================================================
@@ -0,0 +1,115 @@
+#include <tatooine/vtk_legacy.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <fstream>
+//==============================================================================
+namespace tatooine::test {
+//==============================================================================
+struct vtk_legacy_collector : vtk::legacy_file_listener {
+  vtk::format                        format = vtk::format::unknown;
+  vtk::dataset_type                  type   = vtk::dataset_type::unknown;
+  std::string                        title;
+  std::vector<std::array<double, 3>> points;
+  std::vector<int>                   cells;
+  std::vector<vtk::cell_type>        cell_types;
+  std::vector<double>                scalars;
+  vtk::reader_data                   scalars_data = vtk::reader_data::unknown;
+  //----------------------------------------------------------------------------
+  auto on_format(vtk::format f) -> void override { format = f; }
+  auto on_title(std::string const& t) -> void override { title = t; }
+  auto on_dataset_type(vtk::dataset_type t) -> void override { type = t; }
+  auto on_points(std::vector<std::array<double, 3>> const& ps)
+      -> void override {
+    points = ps;
+  }
+  auto on_cells(std::vector<int> const& cs) -> void override { cells = cs; }
+  auto on_cell_types(std::vector<vtk::cell_type> const& cts) -> void override {
+    cell_types = cts;
+  }
+  auto on_scalars(std::string const& /*data_name*/,
+                  std::string const& /*lookup_table_name*/,
+                  std::size_t const /*num_comps*/,
+                  std::vector<double> const& data, vtk::reader_data d)
+      -> void override {
+    scalars      = data;
+    scalars_data = d;
+  }
+};
+//==============================================================================
+TEST_CASE("vtk_legacy_binary", "[vtk][legacy][binary]") {
+  auto const points = std::vector<std::array<double, 3>>{
+      {0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {1.0, 1.0, 0.5}};
+  auto const cells = std::vector<std::vector<std::size_t>>{{0, 1, 2}, {1, 3, 2}};
+  auto const scalars = std::vector<double>{1.5, -2.25, 3.0, 1e-10};
+  {
+    auto writer = vtk::legacy_file_writer{"vtk_legacy_binary.vtk",
+                                          vtk::dataset_type::unstructured_grid};
+    writer.write_header();
+    writer.write_points(points);
+    writer.write_cells(cells);
+    writer.write_cell_types({vtk::cell_type::triangle, vtk::cell_type::triangle});
+    writer.write_point_data(points.size());
+    writer.write_scalars("prop", scalars);
+    writer.close();
+  }
+  auto collector = vtk_legacy_collector{};
+  auto file      = vtk::legacy_file{"vtk_legacy_binary.vtk"};
+  file.add_listener(collector);
+  file.read();
+  REQUIRE(collector.format == vtk::format::binary);
+  REQUIRE(collector.type == vtk::dataset_type::unstructured_grid);
+  REQUIRE(collector.points == points);
+  REQUIRE(collector.cells == std::vector<int>{3, 0, 1, 2, 3, 1, 3, 2});
+  REQUIRE(collector.cell_types ==
+          std::vector{vtk::cell_type::triangle, vtk::cell_type::triangle});
+  REQUIRE(collector.scalars == scalars);
+  REQUIRE(collector.scalars_data == vtk::reader_data::point_data);
+}
+//==============================================================================
+TEST_CASE("vtk_legacy_ascii", "[vtk][legacy][ascii]") {
+  // enough points to be parsed in parallel chunks
+  auto const num_points =
+      vtk::legacy_file_tokenizer::parallel_threshold / 3 + 17;
+  auto points = std::vector<std::array<double, 3>>(num_points);
+  for (std::size_t i = 0; i < num_points; ++i) {
+    points[i] = {static_cast<double>(i) * 0.5, -static_cast<double>(i),
+                 static_cast<double>(i % 7) * 1e-3};
+  }
+  {
+    auto file = std::ofstream{"vtk_legacy_ascii.vtk"};
+    file << "# vtk DataFile Version 3.0\n"
+         << "ascii test\n"
+         << "ASCII\n"
+         << "DATASET UNSTRUCTURED_GRID\n"
+         << "POINTS " << num_points << " double\n";
+    file.precision(17);
+    for (std::size_t i = 0; i < num_points; ++i) {
+      file << points[i][0] << ' ' << points[i][1] << ' ' << points[i][2]
+           << (i % 3 == 2 ? "\n" : "  ");
+    }
+    file << "\nCELLS 2 8\n3 0 1 2\n3 1 3 2\n"
+         << "CELL_TYPES 2\n5\n5\n"
+         << "CELL_DATA 2\n"
+         << "SCALARS prop double\n"
+         << "LOOKUP_TABLE default\n"
+         << "+1.5 -2e3\n";
+  }
+  for (auto const parse_in_parallel : {true, false}) {
+    auto collector = vtk_legacy_collector{};
+    auto file      = vtk::legacy_file{"vtk_legacy_ascii.vtk"};
+    file.parse_in_parallel(parse_in_parallel);
+    file.add_listener(collector);
+    file.read();
+    REQUIRE(collector.format == vtk::format::ascii);
+    REQUIRE(collector.title == "ascii test");
+    REQUIRE(collector.points == points);
+    REQUIRE(collector.cells == std::vector<int>{3, 0, 1, 2, 3, 1, 3, 2});
+    REQUIRE(collector.cell_types ==
+            std::vector{vtk::cell_type::triangle, vtk::cell_type::triangle});
+    REQUIRE(collector.scalars == std::vector{1.5, -2e3});
+    REQUIRE(collector.scalars_data == vtk::reader_data::cell_data);
+  }
+}
+//==============================================================================
+}  // namespace tatooine::test
+//==============================================================================
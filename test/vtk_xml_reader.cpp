@@ -1,8 +1,14 @@
 #include <tatooine/line.h>
+#include <tatooine/pointset.h>
 #include <tatooine/vtk/xml.h>
 
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#if TATOOINE_ZLIB_AVAILABLE
+#include <zlib.h>
+#endif
 //==============================================================================
 namespace tatooine::test {
 //==============================================================================
@@ -107,5 +113,104 @@ TEST_CASE("vtk_xml_read_structured_grid", "[vtk][xml][read]") {
   }
 }
 //==============================================================================
+TEST_CASE("vtk_xml_read_appended_data_view", "[vtk][xml][read][view]") {
+  auto l = line3{};
+  l.push_back(1, 2, 3);
+  l.push_back(4, 5, 6);
+  l.write("line_view.vtp");
+  auto        reader = vtk::xml::reader{"line_view.vtp"};
+  auto const& piece  = reader.poly_data()->pieces.front();
+  REQUIRE_FALSE(piece.points.view<float>().has_value());
+  auto const points = piece.points.view<double>();
+  REQUIRE(points.has_value());
+  REQUIRE(points->size() == 6);
+  auto const copy = piece.points.read<double>();
+  REQUIRE(std::ranges::equal(*points, copy));
+  for (std::size_t i = 0; i < copy.size(); ++i) {
+    REQUIRE((*points)[i] == copy[i]);
+  }
+  if (auto const aligned = points->aligned(); aligned.has_value()) {
+    REQUIRE(std::ranges::equal(*aligned, copy));
+  }
+}
+//==============================================================================
+#if TATOOINE_ZLIB_AVAILABLE
+TEST_CASE("vtk_xml_read_zlib_compressed", "[vtk][xml][read][zlib]") {
+  // 7 points split into blocks of 16 bytes so that the last block is partial
+  auto const num_points = std::size_t{7};
+  auto       points     = std::vector<double>(num_points * 3);
+  auto       prop       = std::vector<float>(num_points);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    points[i] = static_cast<double>(i) * 0.5;
+  }
+  for (std::size_t i = 0; i < prop.size(); ++i) {
+    prop[i] = static_cast<float>(i * i);
+  }
+  auto const block_size = std::uint64_t{16};
+  auto compress_array   = [&](auto const& data) {
+    auto const* bytes     = reinterpret_cast<Bytef const*>(data.data());
+    auto const  num_bytes = data.size() * sizeof(data.front());
+    auto const  num_blocks = (num_bytes + block_size - 1) / block_size;
+    auto header = std::vector<std::uint64_t>{num_blocks, block_size,
+                                             num_bytes % block_size};
+    auto compressed_blocks = std::string{};
+    for (std::size_t i = 0; i < num_blocks; ++i) {
+      auto const begin = i * block_size;
+      auto const size  = std::min<std::size_t>(block_size, num_bytes - begin);
+      auto       compressed_size = compressBound(size);
+      auto       block = std::string(compressed_size, ' ');
+      compress(reinterpret_cast<Bytef*>(block.data()), &compressed_size,
+               bytes + begin, size);
+      header.push_back(compressed_size);
+      compressed_blocks.append(block.data(), compressed_size);
+    }
+    return std::string(reinterpret_cast<char const*>(header.data()),
+                       header.size() * sizeof(std::uint64_t)) +
+           compressed_blocks;
+  };
+  auto const compressed_points = compress_array(points);
+  auto const compressed_prop   = compress_array(prop);
+  {
+    auto file = std::ofstream{"zlib_compressed.vtp", std::ios::binary};
+    file << "<VTKFile type=\"PolyData\" version=\"1.0\" "
+            "byte_order=\"LittleEndian\" header_type=\"UInt64\" "
+            "compressor=\"vtkZLibDataCompressor\">\n"
+            "<PolyData>\n"
+            "<Piece NumberOfPoints=\""
+         << num_points
+         << "\" NumberOfVerts=\"0\" NumberOfLines=\"0\" "
+            "NumberOfStrips=\"0\" NumberOfPolys=\"0\">\n"
+            "<Points>\n"
+            "<DataArray type=\"Float64\" NumberOfComponents=\"3\" "
+            "format=\"appended\" offset=\"0\"/>\n"
+            "</Points>\n"
+            "<PointData>\n"
+            "<DataArray type=\"Float32\" Name=\"prop\" format=\"appended\" "
+            "offset=\""
+         << compressed_points.size()
+         << "\"/>\n"
+            "</PointData>\n"
+            "</Piece>\n"
+            "</PolyData>\n"
+            "<AppendedData encoding=\"raw\">\n_"
+         << compressed_points << compressed_prop
+         << "\n</AppendedData>\n"
+            "</VTKFile>\n";
+  }
+  auto reader = vtk::xml::reader{"zlib_compressed.vtp"};
+  REQUIRE(reader.is_zlib_compressed());
+  auto const& piece = reader.poly_data()->pieces.front();
+  REQUIRE(piece.num_points == num_points);
+  REQUIRE(piece.points.is_compressed());
+  REQUIRE_FALSE(piece.points.view<double>().has_value());
+  REQUIRE(piece.points.read<double>() == points);
+  REQUIRE(piece.point_data.at("prop").read<float>() == prop);
+
+  auto const ps = pointset3{filesystem::path{"zlib_compressed.vtp"}};
+  REQUIRE(ps.vertices().size() == num_points);
+  REQUIRE(ps[pointset3::vertex_handle{6}](2) == points[20]);
+}
+#endif
+//==============================================================================
 }  // namespace tatooine::test
 //==============================================================================